@@ -0,0 +1,94 @@
+/*
+ * Cpu.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __BASE_Cpu_h__
+#define __BASE_Cpu_h__
+
+#include <utility>
+
+// ---------------------------------------------------------------------------
+// BASE_TARGET_AVX2
+//
+// Compiles a function for AVX2 where the compiler can target it, so that it
+// is only called once Cpu::has_avx2() has been checked; elsewhere, it is an
+// ordinary function.
+// ---------------------------------------------------------------------------
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BASE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define BASE_TARGET_AVX2
+#endif
+
+// ---------------------------------------------------------------------------
+// base
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class Cpu;
+
+}
+
+// ---------------------------------------------------------------------------
+// base::Cpu
+//
+// dispatch<Kernel>() calls a function object through a variant compiled for
+// AVX2 when the processor has it, and through a baseline variant otherwise.
+// The call operator of the kernel is declared always_inline, so that its body
+// and the vector helpers it uses are compiled again for each target.
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class Cpu
+{
+public: // public interface
+    static bool has_avx2();
+
+    template <typename Kernel, typename... Args>
+    static void dispatch(Args&&... args)
+    {
+        if(has_avx2()) {
+            run_avx2<Kernel>(std::forward<Args>(args)...);
+        }
+        else {
+            run_generic<Kernel>(std::forward<Args>(args)...);
+        }
+    }
+
+private: // private interface
+    template <typename Kernel, typename... Args>
+    static void run_generic(Args&&... args)
+    {
+        Kernel()(std::forward<Args>(args)...);
+    }
+
+    template <typename Kernel, typename... Args>
+    BASE_TARGET_AVX2
+    static void run_avx2(Args&&... args)
+    {
+        Kernel()(std::forward<Args>(args)...);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __BASE_Cpu_h__ */
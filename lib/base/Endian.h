@@ -0,0 +1,97 @@
+/*
+ * Endian.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __BASE_Endian_h__
+#define __BASE_Endian_h__
+
+#include <cstdint>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// base
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class LittleEndian;
+
+}
+
+// ---------------------------------------------------------------------------
+// base::LittleEndian
+//
+// Reads and writes the little-endian integers of the file formats, byte by
+// byte, so that the files are the same whatever the host. A field is read
+// from exactly as many bytes as it has.
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class LittleEndian
+{
+public: // public interface
+    static uint16_t get16(const uint8_t* data)
+    {
+        return static_cast<uint16_t>(data[0])
+             | static_cast<uint16_t>(data[1]) << 8
+             ;
+    }
+
+    static uint32_t get32(const uint8_t* data)
+    {
+        return static_cast<uint32_t>(get16(data + 0))
+             | static_cast<uint32_t>(get16(data + 2)) << 16
+             ;
+    }
+
+    static uint64_t get64(const uint8_t* data)
+    {
+        return static_cast<uint64_t>(get32(data + 0))
+             | static_cast<uint64_t>(get32(data + 4)) << 32
+             ;
+    }
+
+    static void put8(std::vector<uint8_t>& data, const uint8_t value)
+    {
+        data.push_back(value);
+    }
+
+    static void put16(std::vector<uint8_t>& data, const uint16_t value)
+    {
+        put8(data, static_cast<uint8_t>(value >> 0));
+        put8(data, static_cast<uint8_t>(value >> 8));
+    }
+
+    static void put32(std::vector<uint8_t>& data, const uint32_t value)
+    {
+        put16(data, static_cast<uint16_t>(value >>  0));
+        put16(data, static_cast<uint16_t>(value >> 16));
+    }
+
+    static void put64(std::vector<uint8_t>& data, const uint64_t value)
+    {
+        put32(data, static_cast<uint32_t>(value >>  0));
+        put32(data, static_cast<uint32_t>(value >> 32));
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __BASE_Endian_h__ */
@@ -0,0 +1,115 @@
+/*
+ * MappedFile.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include "MappedFile.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::posix
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct posix
+{
+    static void error(const std::string& what, const std::string& path)
+    {
+        throw std::runtime_error(what + ' ' + '<' + path + '>' + ':' + ' ' + ::strerror(errno));
+    }
+
+    static int open(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd == -1) {
+            error("unable to open", path);
+        }
+        return fd;
+    }
+
+    static size_t size(const int fd, const std::string& path)
+    {
+        struct stat statbuf;
+        if(::fstat(fd, &statbuf) != 0) {
+            error("unable to stat", path);
+        }
+        return statbuf.st_size;
+    }
+
+    static const uint8_t* map(const int fd, const size_t size, const std::string& path)
+    {
+        if(size == 0) {
+            return nullptr;
+        }
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED) {
+            error("unable to map", path);
+        }
+        return reinterpret_cast<const uint8_t*>(data);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// base::MappedFile
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+MappedFile::MappedFile(const std::string& path)
+    : _data(nullptr)
+    , _size(0)
+{
+    const int fd = posix::open(path);
+    try {
+        _size = posix::size(fd, path);
+        _data = posix::map(fd, _size, path);
+    }
+    catch(...) {
+        static_cast<void>(::close(fd));
+        throw;
+    }
+    static_cast<void>(::close(fd));
+}
+
+MappedFile::~MappedFile()
+{
+    if(_data != nullptr) {
+        static_cast<void>(::munmap(const_cast<uint8_t*>(_data), _size));
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,58 @@
+/*
+ * MappedFile.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __BASE_MappedFile_h__
+#define __BASE_MappedFile_h__
+
+// ---------------------------------------------------------------------------
+// base::MappedFile
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class MappedFile
+{
+public: // public interface
+    MappedFile(const std::string& path);
+
+    virtual ~MappedFile();
+
+    const uint8_t* data() const
+    {
+        return _data;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+private: // private data
+    const uint8_t* _data;
+    size_t         _size;
+
+private: // disable copy and assignment
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __BASE_MappedFile_h__ */
@@ -0,0 +1,185 @@
+/*
+ * Pacer.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <thread>
+#include <stdexcept>
+#include "Pacer.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::SteadyClock
+// ---------------------------------------------------------------------------
+
+namespace {
+
+class SteadyClock final
+    : public base::PacerClock
+{
+public: // public interface
+    SteadyClock() = default;
+
+    virtual ~SteadyClock() = default;
+
+    virtual uint64_t now() override
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(clock::now().time_since_epoch()).count();
+    }
+
+    virtual bool sleepUntil(const uint64_t time) override
+    {
+        std::this_thread::sleep_until(clock::time_point(std::chrono::microseconds(time)));
+        return true;
+    }
+
+private: // private data
+    using clock = std::chrono::steady_clock;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// base::PacerClock
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+PacerClock& PacerClock::steady()
+{
+    static SteadyClock clock;
+
+    return clock;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// base::ScaledClock
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+ScaledClock::ScaledClock(PacerClock& clock, const double factor)
+    : PacerClock()
+    , _clock(clock)
+    , _factor(factor)
+    , _origin(clock.now())
+    , _time(_origin)
+{
+    if(factor < 0.0) {
+        throw std::runtime_error("invalid clock factor");
+    }
+}
+
+ScaledClock::~ScaledClock()
+{
+}
+
+uint64_t ScaledClock::now()
+{
+    if(_factor != 0.0) {
+        const uint64_t time = _origin + static_cast<uint64_t>(static_cast<double>(_clock.now() - _origin) * _factor);
+        if(time > _time) {
+            _time = time;
+        }
+    }
+    return _time;
+}
+
+bool ScaledClock::sleepUntil(const uint64_t time)
+{
+    if(_factor == 0.0) {
+        if(time > _time) {
+            _time = time;
+        }
+        return true;
+    }
+    if(time <= _origin) {
+        return true;
+    }
+    return _clock.sleepUntil(_origin + static_cast<uint64_t>(std::ceil(static_cast<double>(time - _origin) / _factor)));
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// base::Pacer
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+Pacer::Pacer(const uint64_t step, const uint64_t frame, PacerClock& clock)
+    : _clock(clock)
+    , _step(step)
+    , _frame(frame)
+    , _backlog((step > frame ? step : frame) * MAX_BACKLOG)
+    , _deadline(clock.now())
+    , _last(_deadline)
+    , _accumulator(0)
+    , _steps(0)
+    , _frames(0)
+    , _dropped(0)
+    , _skipped(0)
+{
+    if((step == 0) || (frame == 0)) {
+        throw std::runtime_error("invalid pacer period");
+    }
+}
+
+Pacer::~Pacer()
+{
+}
+
+unsigned Pacer::wait()
+{
+    const uint64_t deadline = _deadline + _frame;
+    if(_clock.sleepUntil(deadline) == false) {
+        return 0;
+    }
+    _deadline = deadline;
+
+    const uint64_t now = _clock.now();
+    if(now > (_deadline + _frame)) {
+        /* too late, the missed frames are not caught up */
+        _deadline = now;
+    }
+    _accumulator += (now - _last);
+    _last = now;
+    if(_accumulator > _backlog) {
+        _skipped    += (_accumulator - _backlog) / _step;
+        _accumulator = _backlog;
+    }
+    const unsigned steps = (_accumulator / _step);
+    _accumulator -= (steps * _step);
+    if(steps != 0) {
+        _steps   += steps;
+        _frames  += 1;
+        _dropped += (steps - 1);
+    }
+    return steps;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
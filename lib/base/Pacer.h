@@ -0,0 +1,167 @@
+/*
+ * Pacer.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __BASE_Pacer_h__
+#define __BASE_Pacer_h__
+
+#include <chrono>
+
+// ---------------------------------------------------------------------------
+// base
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class PacerClock;
+class ScaledClock;
+class Pacer;
+
+}
+
+// ---------------------------------------------------------------------------
+// base::PacerClock
+//
+// The time base of a pacer, in microseconds. The steady clock is the default
+// one, another clock may run at a variable rate or even stop, in which case
+// sleepUntil() gives up after a while and returns false, so that the caller
+// stays responsive.
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class PacerClock
+{
+public: // public interface
+    PacerClock() = default;
+
+    virtual ~PacerClock() = default;
+
+    virtual uint64_t now() = 0;
+
+    virtual bool sleepUntil(const uint64_t time) = 0;
+
+    static PacerClock& steady();
+
+private: // disable copy and assignment
+    PacerClock(const PacerClock&) = delete;
+    PacerClock& operator=(const PacerClock&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// base::ScaledClock
+//
+// A clock running a given factor faster than another one, from the time it
+// was created. A factor of zero does not wait at all: the time jumps to the
+// deadline of every sleep, so that the frames run as fast as they can.
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class ScaledClock final
+    : public PacerClock
+{
+public: // public interface
+    ScaledClock(PacerClock& clock, const double factor);
+
+    virtual ~ScaledClock();
+
+    virtual uint64_t now() override;
+
+    virtual bool sleepUntil(const uint64_t time) override;
+
+private: // private data
+    PacerClock&    _clock;
+    const double   _factor;
+    const uint64_t _origin;
+    uint64_t       _time;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// base::Pacer
+//
+// A fixed-timestep loop with separate simulation and presentation rates.
+// wait() sleeps until the next frame and returns the number of simulation
+// steps that became due in the meantime, so that the caller runs them and
+// presents only the latest state: every step but the last of a frame is a
+// superseded frame that is dropped and counted. When the simulation cannot
+// keep up, the steps beyond MAX_BACKLOG frames are skipped instead of being
+// accumulated forever. If the clock does not reach the next frame, wait()
+// returns 0 without any step.
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class Pacer
+{
+public: // public interface
+    Pacer(const uint64_t step, const uint64_t frame, PacerClock& clock = PacerClock::steady());
+
+    virtual ~Pacer();
+
+    unsigned wait();
+
+    uint64_t steps() const
+    {
+        return _steps;
+    }
+
+    uint64_t frames() const
+    {
+        return _frames;
+    }
+
+    uint64_t dropped() const
+    {
+        return _dropped;
+    }
+
+    uint64_t skipped() const
+    {
+        return _skipped;
+    }
+
+public: // public static data
+    static constexpr uint64_t MAX_BACKLOG = 4;
+
+private: // private data
+    PacerClock&    _clock;
+    const uint64_t _step;
+    const uint64_t _frame;
+    const uint64_t _backlog;
+    uint64_t       _deadline;
+    uint64_t       _last;
+    uint64_t       _accumulator;
+    uint64_t       _steps;
+    uint64_t       _frames;
+    uint64_t       _dropped;
+    uint64_t       _skipped;
+
+private: // disable copy and assignment
+    Pacer(const Pacer&) = delete;
+    Pacer& operator=(const Pacer&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __BASE_Pacer_h__ */
@@ -0,0 +1,146 @@
+/*
+ * Random.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <mutex>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include "Random.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::rnd
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct rnd
+{
+    static uint64_t rotl(const uint64_t value, const int count)
+    {
+        return (value << count) | (value >> (64 - count));
+    }
+
+    static uint64_t splitmix64(uint64_t& state)
+    {
+        uint64_t value = (state += 0x9e3779b97f4a7c15ULL);
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    static std::mutex& mutex()
+    {
+        static std::mutex mutex;
+
+        return mutex;
+    }
+
+    static std::unique_ptr<base::Random>& master()
+    {
+        static std::unique_ptr<base::Random> master;
+
+        return master;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// base::Random
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+Random::Random(const uint64_t seed)
+    : _state()
+{
+    uint64_t state = seed;
+
+    for(auto& word : _state) {
+        word = rnd::splitmix64(state);
+    }
+}
+
+Random::~Random()
+{
+}
+
+uint64_t Random::next()
+{
+    const uint64_t result = rnd::rotl(_state[1] * 5, 7) * 9;
+    const uint64_t t      = _state[1] << 17;
+
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3]  = rnd::rotl(_state[3], 45);
+
+    return result;
+}
+
+uint64_t Random::below(const uint64_t bound)
+{
+    if(bound == 0) {
+        throw std::runtime_error("invalid random bound");
+    }
+    /* rejects the values of the last partial range, so that it is unbiased */
+    const uint64_t limit = UINT64_MAX - (UINT64_MAX % bound);
+    uint64_t       value = next();
+
+    while(value >= limit) {
+        value = next();
+    }
+    return value % bound;
+}
+
+void Random::setSeed(const uint64_t seed)
+{
+    const std::lock_guard<std::mutex> lock(rnd::mutex());
+
+    rnd::master().reset(new Random(seed));
+}
+
+uint64_t Random::seed()
+{
+    const std::lock_guard<std::mutex> lock(rnd::mutex());
+
+    if(rnd::master()) {
+        return rnd::master()->next();
+    }
+    return entropy();
+}
+
+uint64_t Random::entropy()
+{
+    std::random_device device;
+
+    return (static_cast<uint64_t>(device()) << 32) | device();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
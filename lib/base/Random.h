@@ -0,0 +1,73 @@
+/*
+ * Random.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __BASE_Random_h__
+#define __BASE_Random_h__
+
+#include <cstdint>
+
+// ---------------------------------------------------------------------------
+// base
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class Random;
+
+}
+
+// ---------------------------------------------------------------------------
+// base::Random
+//
+// A xoshiro256** generator, whose state is expanded from a 64-bit seed with
+// splitmix64, so that any seed, even zero, gives a well-mixed state.
+//
+// seed() hands out the seeds of the generators of a run. Once setSeed() has
+// been called, they are drawn from a master generator seeded with it, so that
+// the whole run is reproducible from a single number; until then, they come
+// from the entropy of the system.
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class Random
+{
+public: // public interface
+    Random(const uint64_t seed);
+
+    virtual ~Random();
+
+    uint64_t next();
+
+    uint64_t below(const uint64_t bound);
+
+    static void setSeed(const uint64_t seed);
+
+    static uint64_t seed();
+
+    static uint64_t entropy();
+
+private: // private data
+    uint64_t _state[4];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __BASE_Random_h__ */
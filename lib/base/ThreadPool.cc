@@ -0,0 +1,161 @@
+/*
+ * ThreadPool.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "ThreadPool.h"
+
+// ---------------------------------------------------------------------------
+// base::ThreadPool
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+ThreadPool::ThreadPool(const unsigned threads)
+    : _workers()
+    , _threads()
+    , _mutex()
+    , _wakeup()
+    , _done()
+    , _task(nullptr)
+    , _batch(0)
+    , _pending(0)
+    , _steals(0)
+    , _quit(false)
+{
+    const unsigned count = (threads != 0 ? threads : std::max(1U, std::thread::hardware_concurrency()));
+
+    for(unsigned id = 0; id < count; ++id) {
+        _workers.emplace_back(new Worker());
+    }
+    for(unsigned id = 1; id < count; ++id) {
+        _threads.emplace_back(&ThreadPool::main, this, id);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    /* quit */ {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _wakeup.notify_all();
+    for(auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::run(const size_t count, const Task& task)
+{
+    if(count == 0) {
+        return;
+    }
+    /* publish */ {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _task    = &task;
+        _pending = count;
+        for(size_t item = 0; item < count; ++item) {
+            Worker& worker(*_workers[item % _workers.size()]);
+            const std::lock_guard<std::mutex> guard(worker.mutex);
+            worker.queue.push_back(item);
+        }
+        ++_batch;
+    }
+    _wakeup.notify_all();
+    work(0);
+    /* wait */ {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [&]() -> bool { return _pending == 0; });
+        _task = nullptr;
+    }
+}
+
+void ThreadPool::main(const unsigned id)
+{
+    uint64_t batch = 0;
+
+    while(true) {
+        /* wait */ {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wakeup.wait(lock, [&]() -> bool { return _quit || (_batch != batch); });
+            if(_quit) {
+                break;
+            }
+            batch = _batch;
+        }
+        work(id);
+    }
+}
+
+void ThreadPool::work(const unsigned id)
+{
+    size_t item = 0;
+
+    while(pop(id, item) || steal(id, item)) {
+        (*_task)(item);
+        if(--_pending == 0) {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            _done.notify_all();
+        }
+    }
+}
+
+bool ThreadPool::pop(const unsigned id, size_t& item)
+{
+    Worker& worker(*_workers[id]);
+    const std::lock_guard<std::mutex> lock(worker.mutex);
+
+    if(worker.queue.empty()) {
+        return false;
+    }
+    item = worker.queue.back();
+    worker.queue.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(const unsigned id, size_t& item)
+{
+    const unsigned count = _workers.size();
+
+    for(unsigned offset = 1; offset < count; ++offset) {
+        Worker& victim(*_workers[(id + offset) % count]);
+        const std::lock_guard<std::mutex> lock(victim.mutex);
+        if(victim.queue.empty() == false) {
+            item = victim.queue.front();
+            victim.queue.pop_front();
+            ++_steals;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
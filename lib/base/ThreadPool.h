@@ -0,0 +1,107 @@
+/*
+ * ThreadPool.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __BASE_ThreadPool_h__
+#define __BASE_ThreadPool_h__
+
+#include <mutex>
+#include <deque>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+// ---------------------------------------------------------------------------
+// base
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class ThreadPool;
+
+}
+
+// ---------------------------------------------------------------------------
+// base::ThreadPool
+//
+// A parallel-for over a fixed set of workers. The items of a batch are dealt
+// round-robin into per-worker queues: each worker pops from the back of its
+// own queue and, once it is empty, steals from the front of the others, so
+// that uneven items are balanced without a shared queue. The calling thread
+// takes part in the batch as worker 0.
+// ---------------------------------------------------------------------------
+
+namespace base {
+
+class ThreadPool
+{
+public: // public interface
+    using Task = std::function<void(size_t)>;
+
+    ThreadPool(const unsigned threads = 0);
+
+    virtual ~ThreadPool();
+
+    void run(const size_t count, const Task& task);
+
+    unsigned threads() const
+    {
+        return _workers.size();
+    }
+
+    uint64_t steals() const
+    {
+        return _steals;
+    }
+
+private: // private interface
+    struct Worker
+    {
+        std::mutex         mutex;
+        std::deque<size_t> queue;
+    };
+
+    void main(const unsigned id);
+    void work(const unsigned id);
+    bool pop(const unsigned id, size_t& item);
+    bool steal(const unsigned id, size_t& item);
+
+private: // private data
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread>             _threads;
+    std::mutex                           _mutex;
+    std::condition_variable              _wakeup;
+    std::condition_variable              _done;
+    const Task*                          _task;
+    uint64_t                             _batch;
+    std::atomic<size_t>                  _pending;
+    std::atomic<uint64_t>                _steals;
+    bool                                 _quit;
+
+private: // disable copy and assignment
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __BASE_ThreadPool_h__ */
@@ -0,0 +1,333 @@
+/*
+ * Bitboard.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Cycle.h"
+#include "Bitboard.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::bb
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct bb
+{
+    static constexpr uint64_t COL0 = 0x0101010101010101ULL;
+    static constexpr uint64_t COL7 = 0x8080808080808080ULL;
+
+    static uint64_t rotl(const uint64_t value, const int count)
+    {
+        return (value << count) | (value >> (64 - count));
+    }
+
+    static uint64_t rotr(const uint64_t value, const int count)
+    {
+        return (value >> count) | (value << (64 - count));
+    }
+
+    /* each cell receives the state of its west neighbor */
+    static uint64_t from_west(const uint64_t board)
+    {
+        return ((board << 1) & ~COL0) | ((board >> 7) & COL0);
+    }
+
+    /* each cell receives the state of its east neighbor */
+    static uint64_t from_east(const uint64_t board)
+    {
+        return ((board >> 1) & ~COL7) | ((board << 7) & COL7);
+    }
+
+    /* each cell receives the state of its north neighbor */
+    static uint64_t from_north(const uint64_t board)
+    {
+        return rotl(board, 8);
+    }
+
+    /* each cell receives the state of its south neighbor */
+    static uint64_t from_south(const uint64_t board)
+    {
+        return rotr(board, 8);
+    }
+
+    static void half_adder(const uint64_t a, const uint64_t b, uint64_t& sum, uint64_t& carry)
+    {
+        sum   = a ^ b;
+        carry = a & b;
+    }
+
+    static void full_adder(const uint64_t a, const uint64_t b, const uint64_t c, uint64_t& sum, uint64_t& carry)
+    {
+        const uint64_t t = a ^ b;
+        sum   = t ^ c;
+        carry = (a & b) | (t & c);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// life::Bitboard
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+Bitboard::Count Bitboard::count(const uint64_t board)
+{
+    const uint64_t w = bb::from_west(board);
+    const uint64_t e = bb::from_east(board);
+
+    return sum ( bb::from_north(w), bb::from_north(board), bb::from_north(e)
+               , w, e
+               , bb::from_south(w), bb::from_south(board), bb::from_south(e) );
+}
+
+Bitboard::Count Bitboard::sum ( const uint64_t n0, const uint64_t n1, const uint64_t n2, const uint64_t n3
+                              , const uint64_t n4, const uint64_t n5, const uint64_t n6, const uint64_t n7 )
+{
+    uint64_t s0a, c0a, s0b, c0b, s0c, c0c;
+    bb::full_adder(n0, n1, n2, s0a, c0a);
+    bb::full_adder(n3, n4, n5, s0b, c0b);
+    bb::half_adder(n6, n7, s0c, c0c);
+
+    uint64_t bit0, c1;
+    bb::full_adder(s0a, s0b, s0c, bit0, c1);
+
+    uint64_t s1a, c1a, bit1, c2;
+    bb::full_adder(c0a, c0b, c0c, s1a, c1a);
+    bb::half_adder(s1a, c1, bit1, c2);
+
+    Count count;
+    count.bit0 = bit0;
+    count.bit1 = bit1;
+    count.bit2 = c1a ^ c2;
+    count.bit3 = c1a & c2;
+
+    return count;
+}
+
+uint64_t Bitboard::conway(const uint64_t board)
+{
+    const Count count(Bitboard::count(board));
+
+    /* 2 or 3 neighbors survive, exactly 3 are born */
+    return count.bit1 & ~count.bit2 & ~count.bit3 & (count.bit0 | board);
+}
+
+void Bitboard::step(const Rule& rule, const uint64_t* states, uint64_t* next)
+{
+    const Count count(Bitboard::count(rule.firing(states)));
+
+    rule.evaluate(states, count.bit0, count.bit1, count.bit2, count.bit3, next);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// life::Board
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+Board::Board(const Rule& rule)
+    : _rule(rule)
+    , _states()
+    , _dying(0)
+    , _dead(0)
+    , _ashes(0)
+{
+}
+
+void Board::clear()
+{
+    for(auto& plane : _states) {
+        plane = 0;
+    }
+    _dying = 0;
+    _dead  = 0;
+    _ashes = 0;
+}
+
+void Board::step()
+{
+    uint64_t next[Rule::MAX_PLANES] = {};
+
+    Bitboard::step(_rule, _states, next);
+    advance(next);
+}
+
+void Board::advance(const uint64_t* next)
+{
+    if(_rule.states() == 2) {
+        const uint64_t alive = _states[0];
+        const uint64_t born  = next[0] & ~alive;
+        _ashes = _dead  & ~born;
+        _dead  = _dying & ~born;
+        _dying = alive  & ~next[0];
+    }
+    for(unsigned plane = 0; plane < Rule::MAX_PLANES; ++plane) {
+        _states[plane] = (plane < _rule.planes() ? next[plane] : 0);
+    }
+}
+
+void Board::assign(const uint64_t* states)
+{
+    for(unsigned plane = 0; plane < Rule::MAX_PLANES; ++plane) {
+        _states[plane] = (plane < _rule.planes() ? states[plane] : 0);
+    }
+    _dying = 0;
+    _dead  = 0;
+    _ashes = 0;
+}
+
+void Board::set(const int row, const int col, const Cell cell)
+{
+    const uint64_t mask = Bitboard::mask(row, col);
+
+    for(auto& plane : _states) {
+        plane &= ~mask;
+    }
+    _dying &= ~mask;
+    _dead  &= ~mask;
+    _ashes &= ~mask;
+    switch(cell) {
+        case Cell::kALIVE:
+            _states[0] |= mask;
+            break;
+        case Cell::kDYING:
+            _dying |= mask;
+            break;
+        case Cell::kDEAD:
+            _dead |= mask;
+            break;
+        case Cell::kASHES:
+            _ashes |= mask;
+            break;
+        default:
+            break;
+    }
+}
+
+void Board::set(const int row, const int col, const unsigned state)
+{
+    const uint64_t mask = Bitboard::mask(row, col);
+
+    for(unsigned plane = 0; plane < Rule::MAX_PLANES; ++plane) {
+        if((plane < _rule.planes()) && (((state >> plane) & 1) != 0)) {
+            _states[plane] |= mask;
+        }
+        else {
+            _states[plane] &= ~mask;
+        }
+    }
+    _dying &= ~mask;
+    _dead  &= ~mask;
+    _ashes &= ~mask;
+}
+
+Board::Cell Board::get(const int row, const int col) const
+{
+    const uint64_t mask = Bitboard::mask(row, col);
+
+    if(_rule.states() > 2) {
+        const unsigned state = Board::state(row, col);
+        if(state == 0) {
+            return Cell::kEMPTY;
+        }
+        if(state == 1) {
+            return Cell::kALIVE;
+        }
+        if(_rule.family() == Rule::Family::kWIREWORLD) {
+            return (state == 2 ? Cell::kDYING : Cell::kDEAD);
+        }
+        /* the aging states are spread over dying, dead and ashes */
+        return static_cast<Cell>(3 - (((state - 2) * 3) / (_rule.states() - 2)));
+    }
+    if((_states[0] & mask) != 0) {
+        return Cell::kALIVE;
+    }
+    if((_dying & mask) != 0) {
+        return Cell::kDYING;
+    }
+    if((_dead & mask) != 0) {
+        return Cell::kDEAD;
+    }
+    if((_ashes & mask) != 0) {
+        return Cell::kASHES;
+    }
+    return Cell::kEMPTY;
+}
+
+uint64_t Board::hash() const
+{
+    uint64_t hash = 0;
+
+    /* the aging planes are hashed too, so that a frozen display is final */
+    for(const auto plane : _states) {
+        hash = CycleDetector::mix(hash ^ plane);
+    }
+    hash = CycleDetector::mix(hash ^ _dying);
+    hash = CycleDetector::mix(hash ^ _dead);
+    hash = CycleDetector::mix(hash ^ _ashes);
+    return hash;
+}
+
+void Board::save(uint64_t* words) const
+{
+    for(const auto plane : _states) {
+        *words++ = plane;
+    }
+    *words++ = _dying;
+    *words++ = _dead;
+    *words++ = _ashes;
+}
+
+void Board::load(const uint64_t* words)
+{
+    for(auto& plane : _states) {
+        plane = *words++;
+    }
+    _dying = *words++;
+    _dead  = *words++;
+    _ashes = *words++;
+}
+
+unsigned Board::state(const int row, const int col) const
+{
+    const uint64_t mask  = Bitboard::mask(row, col);
+    unsigned       state = 0;
+
+    for(unsigned plane = 0; plane < _rule.planes(); ++plane) {
+        if((_states[plane] & mask) != 0) {
+            state |= (1U << plane);
+        }
+    }
+    return state;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,157 @@
+/*
+ * Bitboard.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIFE_Bitboard_h__
+#define __LIFE_Bitboard_h__
+
+#include <life/Rule.h>
+
+// ---------------------------------------------------------------------------
+// life
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+struct Bitboard;
+class Board;
+
+}
+
+// ---------------------------------------------------------------------------
+// life::Bitboard
+//
+// An 8x8 torus packed in a 64-bit word, bit (row * 8 + col). The neighbor
+// planes are obtained with byte-wise rotations (columns) and whole word
+// rotations (rows), then summed with bit-sliced full adders so that the
+// counts of all 64 cells are computed at once.
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+struct Bitboard
+{
+    static constexpr int ROWS = 8;
+    static constexpr int COLS = 8;
+
+    struct Count
+    {
+        uint64_t bit0;
+        uint64_t bit1;
+        uint64_t bit2;
+        uint64_t bit3;
+
+        uint64_t equals(const unsigned count) const
+        {
+            return ((count & 1) != 0 ? bit0 : ~bit0)
+                 & ((count & 2) != 0 ? bit1 : ~bit1)
+                 & ((count & 4) != 0 ? bit2 : ~bit2)
+                 & ((count & 8) != 0 ? bit3 : ~bit3)
+                 ;
+        }
+    };
+
+    static uint64_t mask(const int row, const int col)
+    {
+        return 1ULL << (((row & (ROWS - 1)) * COLS) + (col & (COLS - 1)));
+    }
+
+    static Count count(const uint64_t board);
+
+    static Count sum ( const uint64_t n0, const uint64_t n1, const uint64_t n2, const uint64_t n3
+                     , const uint64_t n4, const uint64_t n5, const uint64_t n6, const uint64_t n7 );
+
+    static uint64_t conway(const uint64_t board);
+
+    static void step(const Rule& rule, const uint64_t* states, uint64_t* next);
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// life::Board
+//
+// The state planes of the automaton plus the aging planes of the display.
+// With a two-state rule, a cell that dies goes through the dying, dead and
+// ashes states before being empty again. With a multi-state rule, the extra
+// states of the automaton are displayed instead.
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class Board
+{
+public: // public interface
+    enum class Cell : uint8_t
+    {
+        kEMPTY = 0,
+        kASHES = 1,
+        kDEAD  = 2,
+        kDYING = 3,
+        kALIVE = 4,
+    };
+
+    Board(const Rule& rule);
+
+    void clear();
+
+    void step();
+
+    void advance(const uint64_t* next);
+
+    void assign(const uint64_t* states);
+
+    void set(const int row, const int col, const Cell cell);
+
+    void set(const int row, const int col, const unsigned state);
+
+    Cell get(const int row, const int col) const;
+
+    unsigned state(const int row, const int col) const;
+
+    uint64_t hash() const;
+
+    void save(uint64_t* words) const;
+
+    void load(const uint64_t* words);
+
+    uint64_t alive() const
+    {
+        return _rule.firing(_states);
+    }
+
+    const uint64_t* states() const
+    {
+        return _states;
+    }
+
+public: // public static data
+    static constexpr unsigned WORDS = Rule::MAX_PLANES + 3;
+
+private: // private data
+    const Rule& _rule;
+    uint64_t    _states[Rule::MAX_PLANES];
+    uint64_t    _dying;
+    uint64_t    _dead;
+    uint64_t    _ashes;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __LIFE_Bitboard_h__ */
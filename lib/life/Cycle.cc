@@ -0,0 +1,136 @@
+/*
+ * Cycle.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "Cycle.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::cd
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct cd
+{
+    /* number of buckets, a power of two with at least one way per generation */
+    static size_t buckets(const unsigned window)
+    {
+        size_t count = 1;
+        while((count * life::CycleDetector::WAYS) < (2UL * window)) {
+            count <<= 1;
+        }
+        return count;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// life::CycleDetector
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+CycleDetector::CycleDetector(const unsigned window)
+    : _window(window)
+    , _mask(cd::buckets(window) - 1)
+    , _ring()
+    , _table()
+    , _generation(0)
+{
+    if((window < 1) || (window > MAXIMUM_WINDOW)) {
+        throw std::runtime_error("invalid cycle detection window");
+    }
+    _ring.assign(_window, 0);
+    _table.assign((_mask + 1) * WAYS, 0);
+}
+
+CycleDetector::~CycleDetector()
+{
+}
+
+void CycleDetector::reset()
+{
+    std::fill(_table.begin(), _table.end(), 0);
+    _generation = 0;
+}
+
+unsigned CycleDetector::update(const uint64_t hash)
+{
+    uint64_t* bucket = &_table[(hash & _mask) * WAYS];
+    unsigned  period = 0;
+    unsigned  oldest = 0;
+
+    /* the ways store the generation plus one, zero is an empty way */
+    for(unsigned way = 0; way < WAYS; ++way) {
+        const uint64_t seen = bucket[way];
+        if((seen != 0) && ((_generation - (seen - 1)) <= _window)) {
+            if(_ring[(seen - 1) % _window] == hash) {
+                period = _generation - (seen - 1);
+                oldest = way;
+                break;
+            }
+        }
+        if(bucket[way] < bucket[oldest]) {
+            oldest = way;
+        }
+    }
+    _ring[_generation % _window] = hash;
+    bucket[oldest] = ++_generation;
+    return period;
+}
+
+uint64_t CycleDetector::mix(const uint64_t value)
+{
+    /* splitmix64 finalizer */
+    uint64_t z = value + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+CyclePolicy CycleDetector::policy(const std::string& policy)
+{
+    if(policy == "none") {
+        return CyclePolicy::kNONE;
+    }
+    if(policy == "reseed") {
+        return CyclePolicy::kRESEED;
+    }
+    if(policy == "perturb") {
+        return CyclePolicy::kPERTURB;
+    }
+    if(policy == "freeze") {
+        return CyclePolicy::kFREEZE;
+    }
+    throw std::runtime_error(std::string("invalid cycle policy") + ' ' + '<' + policy + '>');
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
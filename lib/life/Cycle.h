@@ -0,0 +1,97 @@
+/*
+ * Cycle.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIFE_Cycle_h__
+#define __LIFE_Cycle_h__
+
+// ---------------------------------------------------------------------------
+// life
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+enum class CyclePolicy : uint8_t;
+class CycleDetector;
+
+}
+
+// ---------------------------------------------------------------------------
+// life::CyclePolicy
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+enum class CyclePolicy : uint8_t
+{
+    kNONE    = 0,
+    kRESEED  = 1,
+    kPERTURB = 2,
+    kFREEZE  = 3,
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// life::CycleDetector
+//
+// Detects the period of a world from the 64-bit hashes of its generations.
+// The last `window` hashes are kept in a ring indexed by generation, and a
+// small 4-way table maps each hash to the generation it was last seen at,
+// so that a repeated state, and thus its period, is found in constant time.
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class CycleDetector
+{
+public: // public interface
+    CycleDetector(const unsigned window = DEFAULT_WINDOW);
+
+    virtual ~CycleDetector();
+
+    void reset();
+
+    unsigned update(const uint64_t hash);
+
+    unsigned window() const
+    {
+        return _window;
+    }
+
+    static uint64_t mix(const uint64_t value);
+
+    static CyclePolicy policy(const std::string& policy);
+
+public: // public static data
+    static constexpr unsigned DEFAULT_WINDOW = 64;
+    static constexpr unsigned MAXIMUM_WINDOW = 65536;
+    static constexpr unsigned WAYS           = 4;
+
+private: // private data
+    const unsigned        _window;
+    const size_t          _mask;
+    std::vector<uint64_t> _ring;
+    std::vector<uint64_t> _table;
+    uint64_t              _generation;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __LIFE_Cycle_h__ */
@@ -0,0 +1,537 @@
+/*
+ * HashLife.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "HashLife.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::hl
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct hl
+{
+    static constexpr uint32_t NIL      = 0xffffffffU;
+    static constexpr uint8_t  FREE     = 0xff;
+    static constexpr size_t   BUCKETS  = 1UL << 16;
+    static constexpr uint64_t ROW_MASK = 0xffffULL;
+
+    static uint64_t byte(const uint64_t bits, const int row)
+    {
+        return (bits >> (row * 8)) & 0xff;
+    }
+
+    /* one generation of a 16x16 square, cells outside are dead */
+    static void generation(const life::Rule& rule, uint64_t (&rows)[16])
+    {
+        uint64_t next[16];
+
+        for(int row = 0; row < 16; ++row) {
+            const uint64_t n = (row > 0  ? rows[row - 1] : 0);
+            const uint64_t c = rows[row];
+            const uint64_t s = (row < 15 ? rows[row + 1] : 0);
+            const life::Bitboard::Count count(life::Bitboard::sum ( n << 1, n, n >> 1
+                                                                  , c << 1,    c >> 1
+                                                                  , s << 1, s, s >> 1 ));
+            const uint64_t states[life::Rule::MAX_PLANES] = { c };
+            uint64_t       result[life::Rule::MAX_PLANES] = {};
+            rule.evaluate(states, count.bit0, count.bit1, count.bit2, count.bit3, result);
+            next[row] = result[0] & ROW_MASK;
+        }
+        ::memcpy(rows, next, sizeof(next));
+    }
+};
+
+constexpr uint32_t hl::NIL;
+
+}
+
+// ---------------------------------------------------------------------------
+// life::HashLife
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+HashLife::HashLife(const Rule& rule, const size_t max_nodes)
+    : _rule(rule)
+    , _nodes()
+    , _buckets()
+    , _empty()
+    , _free(hl::NIL)
+    , _root(hl::NIL)
+    , _log2(0)
+    , _live(0)
+    , _max_nodes(std::max(max_nodes, static_cast<size_t>(1024)))
+    , _generation(0)
+    , _collections(0)
+{
+    if(_rule.states() != 2) {
+        throw std::runtime_error("hashlife only supports two-state rules");
+    }
+    if(_rule.born(0)) {
+        throw std::runtime_error("hashlife does not support rules with B0");
+    }
+    clear();
+}
+
+HashLife::~HashLife()
+{
+}
+
+void HashLife::clear()
+{
+    _nodes.clear();
+    _buckets.assign(hl::BUCKETS, hl::NIL);
+    _empty.clear();
+    _free       = hl::NIL;
+    _live       = 0;
+    _generation = 0;
+    _root       = empty(MIN_ROOT_LEVEL);
+}
+
+void HashLife::set(const int64_t x, const int64_t y, const bool alive)
+{
+    auto contains = [&]() -> bool
+    {
+        const int64_t half = 1LL << (_nodes[_root].level - 1);
+        return (x >= -half) && (x < half) && (y >= -half) && (y < half);
+    };
+
+    while(contains() == false) {
+        if(_nodes[_root].level >= MAX_ROOT_LEVEL) {
+            throw std::runtime_error("hashlife coordinates out of range");
+        }
+        _root = expand(_root);
+    }
+    const uint64_t half = 1ULL << (_nodes[_root].level - 1);
+    _root = update(_root, static_cast<uint64_t>(x) + half, static_cast<uint64_t>(y) + half, alive);
+}
+
+bool HashLife::get(const int64_t x, const int64_t y) const
+{
+    const int64_t half = 1LL << (_nodes[_root].level - 1);
+
+    if((x < -half) || (x >= half) || (y < -half) || (y >= half)) {
+        return false;
+    }
+    uint64_t ox    = static_cast<uint64_t>(x + half);
+    uint64_t oy    = static_cast<uint64_t>(y + half);
+    uint32_t index = _root;
+    while(_nodes[index].level > LEAF_LEVEL) {
+        const Node&    node(_nodes[index]);
+        const uint64_t size = 1ULL << (node.level - 1);
+        const bool     east  = (ox >= size);
+        const bool     south = (oy >= size);
+        index = (south ? (east ? node.se : node.sw) : (east ? node.ne : node.nw));
+        ox -= (east  ? size : 0);
+        oy -= (south ? size : 0);
+    }
+    return (_nodes[index].bits & Bitboard::mask(oy, ox)) != 0;
+}
+
+uint64_t HashLife::viewport(const int64_t x, const int64_t y) const
+{
+    uint64_t bits = 0;
+
+    for(int row = 0; row < Bitboard::ROWS; ++row) {
+        for(int col = 0; col < Bitboard::COLS; ++col) {
+            if(get(x + col, y + row)) {
+                bits |= Bitboard::mask(row, col);
+            }
+        }
+    }
+    return bits;
+}
+
+void HashLife::step(const unsigned log2)
+{
+    if(log2 > MAXIMUM_STEP) {
+        throw std::runtime_error("hashlife step is too large");
+    }
+    if(log2 != _log2) {
+        forget();
+        _log2 = log2;
+    }
+    if(_live > _max_nodes) {
+        collect();
+    }
+    /* the pattern must fit in the central half with a margin of 2^log2 */
+    const unsigned level = ((log2 + 2) > MIN_ROOT_LEVEL ? (log2 + 2) : MIN_ROOT_LEVEL);
+    while((_nodes[_root].level < level) || (centered(_root) == false)) {
+        if(_nodes[_root].level >= MAX_ROOT_LEVEL) {
+            throw std::runtime_error("hashlife world is too large");
+        }
+        _root = expand(_root);
+    }
+    _root = expand(_root);
+    _root = successor(_root);
+    if(_nodes[_root].level < MIN_ROOT_LEVEL) {
+        _root = expand(_root);
+    }
+    _generation += (1ULL << log2);
+}
+
+uint64_t HashLife::population() const
+{
+    return _nodes[_root].population;
+}
+
+size_t HashLife::capacity(const size_t bytes)
+{
+    return bytes / sizeof(Node);
+}
+
+uint32_t HashLife::allocate()
+{
+    uint32_t index = _free;
+
+    if(index != hl::NIL) {
+        _free = _nodes[index].next;
+    }
+    else {
+        if(_nodes.size() >= hl::NIL) {
+            throw std::runtime_error("hashlife node pool is exhausted");
+        }
+        index = _nodes.size();
+        _nodes.emplace_back();
+    }
+    _nodes[index].level = hl::FREE;
+    if(++_live > _buckets.size()) {
+        rehash(_buckets.size() * 2);
+    }
+    return index;
+}
+
+uint32_t HashLife::leaf(const uint64_t bits)
+{
+    const uint64_t key    = hash(bits, LEAF_LEVEL);
+    const size_t   bucket = key & (_buckets.size() - 1);
+
+    for(uint32_t index = _buckets[bucket]; index != hl::NIL; index = _nodes[index].next) {
+        const Node& node(_nodes[index]);
+        if((node.level == LEAF_LEVEL) && (node.bits == bits)) {
+            return index;
+        }
+    }
+    const uint32_t index = allocate();
+    Node& node(_nodes[index]);
+    node.bits       = bits;
+    node.population = __builtin_popcountll(bits);
+    node.nw         = hl::NIL;
+    node.ne         = hl::NIL;
+    node.sw         = hl::NIL;
+    node.se         = hl::NIL;
+    node.result     = hl::NIL;
+    node.level      = LEAF_LEVEL;
+    node.mark       = 0;
+    node.next       = _buckets[key & (_buckets.size() - 1)];
+    _buckets[key & (_buckets.size() - 1)] = index;
+    return index;
+}
+
+uint32_t HashLife::node(const uint32_t nw, const uint32_t ne, const uint32_t sw, const uint32_t se)
+{
+    const uint64_t key    = hash(hash(nw, ne), hash(sw, se));
+    const size_t   bucket = key & (_buckets.size() - 1);
+
+    for(uint32_t index = _buckets[bucket]; index != hl::NIL; index = _nodes[index].next) {
+        const Node& node(_nodes[index]);
+        if((node.nw == nw) && (node.ne == ne) && (node.sw == sw) && (node.se == se) && (node.level != LEAF_LEVEL)) {
+            return index;
+        }
+    }
+    const uint8_t  level      = _nodes[nw].level + 1;
+    const uint64_t population = _nodes[nw].population + _nodes[ne].population
+                              + _nodes[sw].population + _nodes[se].population;
+    const uint32_t index = allocate();
+    Node& node(_nodes[index]);
+    node.bits       = 0;
+    node.population = population;
+    node.nw         = nw;
+    node.ne         = ne;
+    node.sw         = sw;
+    node.se         = se;
+    node.result     = hl::NIL;
+    node.level      = level;
+    node.mark       = 0;
+    node.next       = _buckets[key & (_buckets.size() - 1)];
+    _buckets[key & (_buckets.size() - 1)] = index;
+    return index;
+}
+
+uint32_t HashLife::empty(const unsigned level)
+{
+    while(_empty.size() <= (level - LEAF_LEVEL)) {
+        const uint32_t child = (_empty.empty() ? hl::NIL : _empty.back());
+        if(child == hl::NIL) {
+            _empty.push_back(leaf(0));
+        }
+        else {
+            _empty.push_back(node(child, child, child, child));
+        }
+    }
+    return _empty[level - LEAF_LEVEL];
+}
+
+uint32_t HashLife::expand(const uint32_t index)
+{
+    const Node     root(_nodes[index]);
+    const uint32_t e = empty(root.level - 1);
+
+    const uint32_t nw = node(e, e, e, root.nw);
+    const uint32_t ne = node(e, e, root.ne, e);
+    const uint32_t sw = node(e, root.sw, e, e);
+    const uint32_t se = node(root.se, e, e, e);
+
+    return node(nw, ne, sw, se);
+}
+
+uint32_t HashLife::center(const uint32_t index)
+{
+    const Node n(_nodes[index]);
+
+    if(n.level == (LEAF_LEVEL + 1)) {
+        return simulate(index, 0);
+    }
+    return node(_nodes[n.nw].se, _nodes[n.ne].sw, _nodes[n.sw].ne, _nodes[n.se].nw);
+}
+
+uint32_t HashLife::simulate(const uint32_t index, const unsigned generations)
+{
+    const Node n(_nodes[index]);
+    const uint64_t nw = _nodes[n.nw].bits;
+    const uint64_t ne = _nodes[n.ne].bits;
+    const uint64_t sw = _nodes[n.sw].bits;
+    const uint64_t se = _nodes[n.se].bits;
+    uint64_t rows[16];
+
+    for(int row = 0; row < 8; ++row) {
+        rows[row + 0] = hl::byte(nw, row) | (hl::byte(ne, row) << 8);
+        rows[row + 8] = hl::byte(sw, row) | (hl::byte(se, row) << 8);
+    }
+    for(unsigned count = 0; count < generations; ++count) {
+        hl::generation(_rule, rows);
+    }
+    uint64_t bits = 0;
+    for(int row = 0; row < 8; ++row) {
+        bits |= ((rows[row + 4] >> 4) & 0xff) << (row * 8);
+    }
+    return leaf(bits);
+}
+
+uint32_t HashLife::successor(const uint32_t index)
+{
+    if(_nodes[index].result != hl::NIL) {
+        return _nodes[index].result;
+    }
+    const Node     n(_nodes[index]);
+    const unsigned log2 = std::min(_log2, static_cast<unsigned>(n.level - 2));
+    uint32_t       result;
+
+    if(_nodes[index].population == 0) {
+        result = empty(n.level - 1);
+    }
+    else if(n.level == (LEAF_LEVEL + 1)) {
+        result = simulate(index, 1U << log2);
+    }
+    else {
+        const Node nw(_nodes[n.nw]);
+        const Node ne(_nodes[n.ne]);
+        const Node sw(_nodes[n.sw]);
+        const Node se(_nodes[n.se]);
+
+        /* the 9 overlapping sub-squares of half size */
+        const uint32_t n00 = n.nw;
+        const uint32_t n01 = node(nw.ne, ne.nw, nw.se, ne.sw);
+        const uint32_t n02 = n.ne;
+        const uint32_t n10 = node(nw.sw, nw.se, sw.nw, sw.ne);
+        const uint32_t n11 = node(nw.se, ne.sw, sw.ne, se.nw);
+        const uint32_t n12 = node(ne.sw, ne.se, se.nw, se.ne);
+        const uint32_t n20 = n.sw;
+        const uint32_t n21 = node(sw.ne, se.nw, sw.se, se.sw);
+        const uint32_t n22 = n.se;
+
+        /* a full step advances both halves, a partial step only the second */
+        const bool full = (log2 == static_cast<unsigned>(n.level - 2));
+        auto first = [&](const uint32_t sub) -> uint32_t
+        {
+            return (full ? successor(sub) : center(sub));
+        };
+
+        const uint32_t r00 = first(n00);
+        const uint32_t r01 = first(n01);
+        const uint32_t r02 = first(n02);
+        const uint32_t r10 = first(n10);
+        const uint32_t r11 = first(n11);
+        const uint32_t r12 = first(n12);
+        const uint32_t r20 = first(n20);
+        const uint32_t r21 = first(n21);
+        const uint32_t r22 = first(n22);
+
+        const uint32_t rnw = successor(node(r00, r01, r10, r11));
+        const uint32_t rne = successor(node(r01, r02, r11, r12));
+        const uint32_t rsw = successor(node(r10, r11, r20, r21));
+        const uint32_t rse = successor(node(r11, r12, r21, r22));
+
+        result = node(rnw, rne, rsw, rse);
+    }
+    _nodes[index].result = result;
+    return result;
+}
+
+uint32_t HashLife::update(const uint32_t index, const uint64_t x, const uint64_t y, const bool alive)
+{
+    const Node n(_nodes[index]);
+
+    if(n.level == LEAF_LEVEL) {
+        const uint64_t mask = Bitboard::mask(y, x);
+        return leaf(alive ? (n.bits | mask) : (n.bits & ~mask));
+    }
+    const uint64_t size  = 1ULL << (n.level - 1);
+    const bool     east  = (x >= size);
+    const bool     south = (y >= size);
+    const uint64_t cx    = x - (east  ? size : 0);
+    const uint64_t cy    = y - (south ? size : 0);
+
+    if(south == false) {
+        if(east == false) {
+            return node(update(n.nw, cx, cy, alive), n.ne, n.sw, n.se);
+        }
+        return node(n.nw, update(n.ne, cx, cy, alive), n.sw, n.se);
+    }
+    if(east == false) {
+        return node(n.nw, n.ne, update(n.sw, cx, cy, alive), n.se);
+    }
+    return node(n.nw, n.ne, n.sw, update(n.se, cx, cy, alive));
+}
+
+bool HashLife::centered(const uint32_t index) const
+{
+    const Node& n(_nodes[index]);
+    const Node& nw(_nodes[n.nw]);
+    const Node& ne(_nodes[n.ne]);
+    const Node& sw(_nodes[n.sw]);
+    const Node& se(_nodes[n.se]);
+
+    /* everything must be inside the central half */
+    const uint64_t inner = _nodes[nw.se].population + _nodes[ne.sw].population
+                         + _nodes[sw.ne].population + _nodes[se.nw].population;
+
+    return inner == n.population;
+}
+
+void HashLife::forget()
+{
+    for(auto& node : _nodes) {
+        node.result = hl::NIL;
+    }
+}
+
+void HashLife::collect()
+{
+    std::vector<uint32_t> stack;
+
+    auto mark = [&](const uint32_t root) -> void
+    {
+        stack.push_back(root);
+        while(stack.empty() == false) {
+            const uint32_t index = stack.back();
+            stack.pop_back();
+            Node& node(_nodes[index]);
+            if(node.mark != 0) {
+                continue;
+            }
+            node.mark = 1;
+            if(node.level != LEAF_LEVEL) {
+                stack.push_back(node.nw);
+                stack.push_back(node.ne);
+                stack.push_back(node.sw);
+                stack.push_back(node.se);
+            }
+        }
+    };
+
+    mark(_root);
+    for(auto index : _empty) {
+        mark(index);
+    }
+    std::fill(_buckets.begin(), _buckets.end(), hl::NIL);
+    _free = hl::NIL;
+    _live = 0;
+    for(uint32_t index = _nodes.size(); index-- > 0;) {
+        Node& node(_nodes[index]);
+        if(node.mark != 0) {
+            const uint64_t key = (node.level == LEAF_LEVEL ? hash(node.bits, LEAF_LEVEL) : hash(hash(node.nw, node.ne), hash(node.sw, node.se)));
+            node.mark = 0;
+            node.next = _buckets[key & (_buckets.size() - 1)];
+            _buckets[key & (_buckets.size() - 1)] = index;
+            ++_live;
+        }
+        else {
+            node.level  = hl::FREE;
+            node.result = hl::NIL;
+            node.next   = _free;
+            _free       = index;
+        }
+    }
+    for(auto& node : _nodes) {
+        if((node.result != hl::NIL) && (_nodes[node.result].level == hl::FREE)) {
+            node.result = hl::NIL;
+        }
+    }
+    ++_collections;
+}
+
+void HashLife::rehash(const size_t buckets)
+{
+    _buckets.assign(buckets, hl::NIL);
+    for(uint32_t index = 0; index < _nodes.size(); ++index) {
+        Node& node(_nodes[index]);
+        if(node.level == hl::FREE) {
+            continue;
+        }
+        const uint64_t key = (node.level == LEAF_LEVEL ? hash(node.bits, LEAF_LEVEL) : hash(hash(node.nw, node.ne), hash(node.sw, node.se)));
+        node.next = _buckets[key & (buckets - 1)];
+        _buckets[key & (buckets - 1)] = index;
+    }
+}
+
+uint64_t HashLife::hash(const uint64_t a, const uint64_t b)
+{
+    uint64_t h = (a * 0x9e3779b97f4a7c15ULL) ^ (b + 0x632be59bd9b4e019ULL + (a << 6) + (a >> 2));
+    h ^= (h >> 31);
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= (h >> 27);
+    return h;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
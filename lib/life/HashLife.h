@@ -0,0 +1,144 @@
+/*
+ * HashLife.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIFE_HashLife_h__
+#define __LIFE_HashLife_h__
+
+#include <life/Bitboard.h>
+
+// ---------------------------------------------------------------------------
+// life
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class HashLife;
+
+}
+
+// ---------------------------------------------------------------------------
+// life::HashLife
+//
+// An unbounded world stored as a quadtree of hash-consed nodes: identical
+// sub-squares share the same node, and each node memoizes its successor,
+// the center half advanced by 2^k generations. The leaves are 8x8 bitboards.
+//
+// The node pool is soft-capped: when it grows beyond the cap, the nodes not
+// reachable from the current root are reclaimed and the memoized results
+// pointing to them are dropped, before the next step is computed.
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class HashLife
+{
+public: // public interface
+    HashLife(const Rule& rule, const size_t max_nodes = DEFAULT_MAX_NODES);
+
+    virtual ~HashLife();
+
+    void clear();
+
+    void set(const int64_t x, const int64_t y, const bool alive);
+
+    bool get(const int64_t x, const int64_t y) const;
+
+    uint64_t viewport(const int64_t x, const int64_t y) const;
+
+    void step(const unsigned log2);
+
+    uint64_t population() const;
+
+    static size_t capacity(const size_t bytes);
+
+    uint64_t generation() const
+    {
+        return _generation;
+    }
+
+    size_t nodes() const
+    {
+        return _live;
+    }
+
+    uint64_t collections() const
+    {
+        return _collections;
+    }
+
+public: // public static data
+    static constexpr unsigned LEAF_LEVEL        = 3;
+    static constexpr unsigned MIN_ROOT_LEVEL    = 5;
+    static constexpr unsigned MAX_ROOT_LEVEL    = 62;
+    static constexpr unsigned MAXIMUM_STEP      = 48;
+    static constexpr size_t   DEFAULT_MAX_NODES = 1UL << 21;
+
+private: // private interface
+    struct Node
+    {
+        uint64_t bits;
+        uint64_t population;
+        uint32_t nw;
+        uint32_t ne;
+        uint32_t sw;
+        uint32_t se;
+        uint32_t result;
+        uint32_t next;
+        uint8_t  level;
+        uint8_t  mark;
+    };
+
+    uint32_t allocate();
+    uint32_t leaf(const uint64_t bits);
+    uint32_t node(const uint32_t nw, const uint32_t ne, const uint32_t sw, const uint32_t se);
+    uint32_t empty(const unsigned level);
+    uint32_t expand(const uint32_t index);
+    uint32_t center(const uint32_t index);
+    uint32_t simulate(const uint32_t index, const unsigned generations);
+    uint32_t successor(const uint32_t index);
+    uint32_t update(const uint32_t index, const uint64_t x, const uint64_t y, const bool alive);
+    bool     centered(const uint32_t index) const;
+    void     forget();
+    void     collect();
+    void     rehash(const size_t buckets);
+
+    static uint64_t hash(const uint64_t a, const uint64_t b);
+
+private: // private data
+    const Rule            _rule;
+    std::vector<Node>     _nodes;
+    std::vector<uint32_t> _buckets;
+    std::vector<uint32_t> _empty;
+    uint32_t              _free;
+    uint32_t              _root;
+    unsigned              _log2;
+    size_t                _live;
+    const size_t          _max_nodes;
+    uint64_t              _generation;
+    uint64_t              _collections;
+
+private: // disable copy and assignment
+    HashLife(const HashLife&) = delete;
+    HashLife& operator=(const HashLife&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __LIFE_HashLife_h__ */
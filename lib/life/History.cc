@@ -0,0 +1,183 @@
+/*
+ * History.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "History.h"
+
+// ---------------------------------------------------------------------------
+// life::History
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+History::History(const size_t depth)
+    : History((depth + KEYFRAME), ((depth + KEYFRAME + 2) * MAX_RECORD))
+{
+}
+
+History::History(const size_t generations, const size_t bytes)
+    : _entries(generations)
+    , _arena(bytes)
+    , _first(0)
+    , _count(0)
+    , _head(0)
+    , _previous()
+    , _keyframe(0)
+{
+    if((generations < KEYFRAME) || (bytes < (KEYFRAME * MAX_RECORD)) || (bytes > UINT32_MAX)) {
+        throw std::runtime_error("invalid history size");
+    }
+}
+
+History::~History()
+{
+}
+
+void History::clear()
+{
+    _first = 0;
+    _count = 0;
+    _head  = 0;
+}
+
+void History::record(const Board& board)
+{
+    /* the oldest keyframes make room for the largest record */
+    size_t position = ((_head + MAX_RECORD) <= _arena.size() ? _head : 0);
+    while((_count >= _entries.size()) || (fits(position, MAX_RECORD) == false)) {
+        evict();
+    }
+    if(_count == 0) {
+        position = 0;
+    }
+    const uint64_t generation = _first + _count;
+    const bool     keyframe   = (_count == 0) || ((generation - _keyframe) >= KEYFRAME);
+    uint8_t*       record     = &_arena[position];
+    size_t         length     = 1;
+    uint64_t       words[WORDS];
+
+    board.save(words);
+    record[0] = 0;
+    for(unsigned index = 0; index < WORDS; ++index) {
+        const uint64_t delta = (keyframe ? words[index] : words[index] ^ _previous[index]);
+        if(delta != 0) {
+            record[0] |= (1U << index);
+            ::memcpy(&record[length], &delta, sizeof(delta));
+            length += sizeof(delta);
+        }
+        _previous[index] = words[index];
+    }
+    Entry& entry(_entries[generation % _entries.size()]);
+    entry.offset   = position;
+    entry.length   = length;
+    entry.keyframe = keyframe;
+    if(keyframe) {
+        _keyframe = generation;
+    }
+    _head = position + length;
+    ++_count;
+}
+
+void History::restore(const uint64_t generation, Board& board) const
+{
+    uint64_t words[WORDS];
+
+    rebuild(generation, words);
+    board.load(words);
+}
+
+void History::truncate(const uint64_t generation)
+{
+    rebuild(generation, _previous);
+
+    const Entry& newest(entry(generation));
+    uint64_t     keyframe = generation;
+    while(entry(keyframe).keyframe == false) {
+        --keyframe;
+    }
+    _keyframe = keyframe;
+    _count    = (generation - _first) + 1;
+    _head     = newest.offset + newest.length;
+}
+
+bool History::fits(const size_t position, const size_t length) const
+{
+    if(_count == 0) {
+        return true;
+    }
+    const size_t tail = _entries[_first % _entries.size()].offset;
+    if(position == _head) {
+        return (tail < _head) || ((_head + length) <= tail);
+    }
+    /* the record wraps to the beginning of the arena */
+    return (tail < _head) && (length <= tail);
+}
+
+void History::evict()
+{
+    do {
+        ++_first;
+        --_count;
+    } while((_count != 0) && (entry(_first).keyframe == false));
+}
+
+void History::rebuild(const uint64_t generation, uint64_t* words) const
+{
+    uint64_t keyframe = generation;
+
+    if((_count == 0) || (generation < _first) || (generation > last())) {
+        throw std::runtime_error("generation is out of history");
+    }
+    while(entry(keyframe).keyframe == false) {
+        --keyframe;
+    }
+    for(uint64_t index = keyframe; index <= generation; ++index) {
+        decode(entry(index), words);
+    }
+}
+
+void History::decode(const Entry& entry, uint64_t* words) const
+{
+    const uint8_t* record = &_arena[entry.offset];
+    const uint8_t  mask   = *record++;
+
+    for(unsigned index = 0; index < WORDS; ++index) {
+        if(entry.keyframe) {
+            words[index] = 0;
+        }
+        if((mask & (1U << index)) != 0) {
+            uint64_t delta;
+            ::memcpy(&delta, record, sizeof(delta));
+            words[index] ^= delta;
+            record += sizeof(delta);
+        }
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,127 @@
+/*
+ * History.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIFE_History_h__
+#define __LIFE_History_h__
+
+#include <life/Bitboard.h>
+
+// ---------------------------------------------------------------------------
+// life
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class History;
+
+}
+
+// ---------------------------------------------------------------------------
+// life::History
+//
+// The last generations of a board, recorded as deltas in a fixed-size arena
+// used as a ring. Each record is a byte telling which words of the board
+// changed, followed by the XOR of these words only, and every KEYFRAME-th
+// record is taken against an empty board so that any generation is rebuilt
+// from its keyframe with a few XORs. When the arena or the index is full,
+// the oldest keyframe is evicted along with its deltas.
+//
+// Given a depth only, the index and the arena are sized for the worst case,
+// a whole keyframe evicted and records of the largest size, so that at least
+// that many generations before the last one are always kept.
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class History
+{
+public: // public interface
+    History(const size_t depth);
+
+    History(const size_t generations, const size_t bytes);
+
+    virtual ~History();
+
+    void clear();
+
+    void record(const Board& board);
+
+    void restore(const uint64_t generation, Board& board) const;
+
+    void truncate(const uint64_t generation);
+
+    uint64_t first() const
+    {
+        return _first;
+    }
+
+    uint64_t last() const
+    {
+        return _first + _count - 1;
+    }
+
+    bool empty() const
+    {
+        return _count == 0;
+    }
+
+public: // public static data
+    static constexpr unsigned WORDS            = Board::WORDS;
+    static constexpr unsigned KEYFRAME         = 32;
+    static constexpr size_t   MAX_RECORD       = 1 + (WORDS * sizeof(uint64_t));
+
+private: // private interface
+    struct Entry
+    {
+        uint32_t offset;
+        uint8_t  length;
+        bool     keyframe;
+    };
+
+    const Entry& entry(const uint64_t generation) const
+    {
+        return _entries[generation % _entries.size()];
+    }
+
+    bool fits(const size_t position, const size_t length) const;
+
+    void evict();
+
+    void rebuild(const uint64_t generation, uint64_t* words) const;
+
+    void decode(const Entry& entry, uint64_t* words) const;
+
+private: // private data
+    std::vector<Entry>   _entries;
+    std::vector<uint8_t> _arena;
+    uint64_t             _first;
+    uint64_t             _count;
+    size_t               _head;
+    uint64_t             _previous[WORDS];
+    uint64_t             _keyframe;
+
+private: // disable copy and assignment
+    History(const History&) = delete;
+    History& operator=(const History&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __LIFE_History_h__ */
@@ -0,0 +1,109 @@
+/*
+ * HistoryTest.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <stdexcept>
+#include "History.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ht
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ht
+{
+    static constexpr unsigned WORDS = life::History::WORDS;
+
+    /* records the given boards, then checks that the last depth ones are restored */
+    static bool check(const size_t depth, std::vector<std::vector<uint64_t>> boards)
+    {
+        const life::Rule rule;
+        life::History    history(depth);
+        life::Board      board(rule);
+        uint64_t         words[WORDS];
+
+        for(auto& board_words : boards) {
+            board.load(board_words.data());
+            board.save(board_words.data());
+            history.record(board);
+        }
+        if((history.last() - history.first()) < depth) {
+            std::cerr << "depth " << depth << ": only " << (history.last() - history.first()) << " generations back are kept" << std::endl;
+            return false;
+        }
+        for(size_t back = 0; back <= depth; ++back) {
+            history.restore(history.last() - back, board);
+            board.save(words);
+            if(::memcmp(words, boards[boards.size() - 1 - back].data(), sizeof(words)) != 0) {
+                std::cerr << "depth " << depth << ": generation " << back << " back is not restored" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static std::vector<std::vector<uint64_t>> boards(const size_t count, const bool dense, const uint64_t seed)
+    {
+        std::mt19937_64                    generator(seed);
+        std::vector<std::vector<uint64_t>> boards;
+
+        for(size_t index = 0; index < count; ++index) {
+            std::vector<uint64_t> words(WORDS, 0);
+            /* a dense board changes all its words, the largest record */
+            words[0] = generator();
+            if(dense) {
+                for(auto& word : words) {
+                    word = generator();
+                }
+            }
+            boards.push_back(words);
+        }
+        return boards;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// main
+// ---------------------------------------------------------------------------
+
+int main()
+{
+    bool success = true;
+
+    for(const size_t depth : { 32, 100, 1000 }) {
+        for(const bool dense : { false, true }) {
+            success &= ht::check(depth, ht::boards((depth * 5) + 7, dense, depth));
+        }
+    }
+    return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
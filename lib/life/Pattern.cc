@@ -0,0 +1,425 @@
+/*
+ * Pattern.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "Pattern.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::pt
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct pt
+{
+    static constexpr int64_t MAX_COORD = (1LL << 40);
+
+    static void invalid(const std::string& path, const char* what)
+    {
+        throw std::runtime_error(std::string(what) + ' ' + '<' + path + '>');
+    }
+
+    /* end of the current line, without the line terminator */
+    static const char* eol(const char* cursor, const char* end)
+    {
+        const void* found = ::memchr(cursor, '\n', end - cursor);
+        const char* last  = (found != nullptr ? static_cast<const char*>(found) : end);
+        if((last > cursor) && (last[-1] == '\r')) {
+            --last;
+        }
+        return last;
+    }
+
+    /* start of the next line */
+    static const char* next(const char* cursor, const char* end)
+    {
+        const void* found = ::memchr(cursor, '\n', end - cursor);
+        return (found != nullptr ? static_cast<const char*>(found) + 1 : end);
+    }
+
+    static bool starts(const char* cursor, const char* last, const char* prefix)
+    {
+        const size_t length = ::strlen(prefix);
+        return (static_cast<size_t>(last - cursor) >= length) && (::strncmp(cursor, prefix, length) == 0);
+    }
+
+    static const char* skip(const char* cursor, const char* last)
+    {
+        while((cursor < last) && ((*cursor == ' ') || (*cursor == '\t'))) {
+            ++cursor;
+        }
+        return cursor;
+    }
+
+    static bool integer(const char*& cursor, const char* last, int64_t& value)
+    {
+        bool negative = false;
+        bool digits   = false;
+        value = 0;
+        cursor = skip(cursor, last);
+        if((cursor < last) && ((*cursor == '-') || (*cursor == '+'))) {
+            negative = (*cursor++ == '-');
+        }
+        while((cursor < last) && (*cursor >= '0') && (*cursor <= '9')) {
+            value = (value * 10) + (*cursor++ - '0');
+            if(value > MAX_COORD) {
+                return false;
+            }
+            digits = true;
+        }
+        if(negative) {
+            value = -value;
+        }
+        return digits;
+    }
+
+    /* parses "x = 3, y = 3, rule = B3/S23" */
+    static bool header(const char* cursor, const char* last, life::Pattern& pattern)
+    {
+        bool has_x = false;
+        bool has_y = false;
+        while(cursor < last) {
+            cursor = skip(cursor, last);
+            const char* key = cursor;
+            while((cursor < last) && (::isalnum(*cursor) != 0)) {
+                ++cursor;
+            }
+            const std::string name(key, cursor);
+            cursor = skip(cursor, last);
+            if((cursor >= last) || (*cursor++ != '=')) {
+                return false;
+            }
+            cursor = skip(cursor, last);
+            const char* value = cursor;
+            while((cursor < last) && (*cursor != ',')) {
+                ++cursor;
+            }
+            const char* stop = cursor;
+            while((stop > value) && ((stop[-1] == ' ') || (stop[-1] == '\t'))) {
+                --stop;
+            }
+            if(name == "x") {
+                has_x = integer(value, stop, pattern.width) && (pattern.width >= 0);
+            }
+            else if(name == "y") {
+                has_y = integer(value, stop, pattern.height) && (pattern.height >= 0);
+            }
+            else if(name == "rule") {
+                /* a bounded grid suffix such as ":T100,100" is ignored */
+                const void* colon = ::memchr(value, ':', stop - value);
+                pattern.rule.assign(value, (colon != nullptr ? static_cast<const char*>(colon) : stop));
+            }
+            if(cursor < last) {
+                ++cursor;
+            }
+        }
+        return has_x && has_y;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// life::PatternFile
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+PatternFile::PatternFile(const std::string& path)
+    : _path(path)
+    , _file(path)
+    , _patterns()
+    , _index()
+{
+    index();
+}
+
+PatternFile::~PatternFile()
+{
+}
+
+const Pattern& PatternFile::find(const std::string& name) const
+{
+    const auto found = _index.find(name);
+
+    if(found == _index.end()) {
+        throw std::runtime_error(std::string("pattern not found") + ' ' + '<' + name + '>');
+    }
+    return _patterns[found->second];
+}
+
+void PatternFile::bounds(const Pattern& pattern, int64_t& x, int64_t& y, int64_t& width, int64_t& height) const
+{
+    if(pattern.format == Pattern::Format::kRLE) {
+        x      = 0;
+        y      = 0;
+        width  = pattern.width;
+        height = pattern.height;
+        return;
+    }
+    int64_t min_x = 0, max_x = -1;
+    int64_t min_y = 0, max_y = -1;
+    bool    empty = true;
+    decode(pattern, [&](const int64_t cx, const int64_t cy, const uint64_t length, const unsigned state) -> void
+    {
+        static_cast<void>(state);
+        if(empty != false) {
+            min_x = max_x = cx;
+            min_y = max_y = cy;
+            empty = false;
+        }
+        min_x = std::min(min_x, cx);
+        max_x = std::max(max_x, cx + static_cast<int64_t>(length) - 1);
+        min_y = std::min(min_y, cy);
+        max_y = std::max(max_y, cy);
+    });
+    x      = min_x;
+    y      = min_y;
+    width  = (max_x - min_x) + 1;
+    height = (max_y - min_y) + 1;
+}
+
+void PatternFile::decode(const Pattern& pattern, const Sink& sink) const
+{
+    if(pattern.format == Pattern::Format::kRLE) {
+        decodeRLE(pattern, sink);
+    }
+    else {
+        decodeLife106(pattern, sink);
+    }
+}
+
+void PatternFile::index()
+{
+    enum class State
+    {
+        kIDLE,
+        kRLE_HEADER,
+        kRLE_DATA,
+        kLIFE106,
+    };
+    const char* const data   = reinterpret_cast<const char*>(_file.data());
+    const char* const end    = data + _file.size();
+    const char*       cursor = data;
+    State             state  = State::kIDLE;
+    Pattern           pattern;
+    bool              cells  = false;
+    const char*       follow = nullptr;
+    std::string       next;
+
+    auto open = [&](const Pattern::Format format) -> void
+    {
+        pattern.format = format;
+        pattern.name.swap(next);
+        pattern.rule.clear();
+        pattern.begin  = 0;
+        pattern.end    = 0;
+        pattern.width  = 0;
+        pattern.height = 0;
+        next.clear();
+        cells  = false;
+        follow = nullptr;
+    };
+
+    auto close = [&](const char* last) -> void
+    {
+        /* the comments that follow a Life 1.06 block belong to the next pattern */
+        pattern.end = (follow != nullptr ? follow : last) - data;
+        _patterns.push_back(pattern);
+        const size_t ordinal = _patterns.size() - 1;
+        _index.emplace(std::to_string(ordinal + 1), ordinal);
+        if(pattern.name.empty() == false) {
+            _index.emplace(pattern.name, ordinal);
+        }
+        state = State::kIDLE;
+    };
+
+    auto name = [&](const char* line, const char* last, std::string& target) -> void
+    {
+        if(pt::starts(line, last, "#N")) {
+            const char* first = pt::skip(line + 2, last);
+            const char* stop  = last;
+            while((stop > first) && ((stop[-1] == ' ') || (stop[-1] == '\t'))) {
+                --stop;
+            }
+            target.assign(first, stop);
+        }
+    };
+
+    while(cursor < end) {
+        const char* line = cursor;
+        const char* last = pt::eol(line, end);
+        cursor = pt::next(line, end);
+        if(state == State::kRLE_DATA) {
+            const void* bang = ::memchr(line, '!', last - line);
+            if(bang != nullptr) {
+                close(static_cast<const char*>(bang));
+            }
+            continue;
+        }
+        if(pt::starts(line, last, "#Life 1.06")) {
+            if(state == State::kLIFE106) {
+                close(line);
+            }
+            if(state == State::kRLE_HEADER) {
+                next.swap(pattern.name);
+            }
+            open(Pattern::Format::kLIFE106);
+            pattern.begin = cursor - data;
+            state = State::kLIFE106;
+            continue;
+        }
+        if(*line == '#') {
+            if((state == State::kLIFE106) && (cells != false)) {
+                if(follow == nullptr) {
+                    follow = line;
+                }
+                name(line, last, next);
+                continue;
+            }
+            if(state == State::kIDLE) {
+                open(Pattern::Format::kRLE);
+                state = State::kRLE_HEADER;
+            }
+            name(line, last, pattern.name);
+            continue;
+        }
+        const char* first = pt::skip(line, last);
+        if((first < last) && (*first == 'x')) {
+            if(state == State::kLIFE106) {
+                close(line);
+            }
+            if(state == State::kIDLE) {
+                open(Pattern::Format::kRLE);
+            }
+            if(pt::header(first, last, pattern) == false) {
+                pt::invalid(_path, "invalid RLE header in");
+            }
+            pattern.begin = cursor - data;
+            state = State::kRLE_DATA;
+            continue;
+        }
+        if((state == State::kRLE_HEADER) && (first < last)) {
+            pt::invalid(_path, "missing RLE header in");
+        }
+        /* a cell after a comment keeps the comment within the block */
+        if((state == State::kLIFE106) && (first < last)) {
+            if((follow != nullptr) && pattern.name.empty()) {
+                pattern.name.swap(next);
+            }
+            cells  = true;
+            follow = nullptr;
+            next.clear();
+        }
+    }
+    if((state == State::kRLE_DATA) || (state == State::kLIFE106)) {
+        close(end);
+    }
+    if(_patterns.empty()) {
+        pt::invalid(_path, "no pattern found in");
+    }
+}
+
+void PatternFile::decodeRLE(const Pattern& pattern, const Sink& sink) const
+{
+    const char* cursor = reinterpret_cast<const char*>(_file.data()) + pattern.begin;
+    const char* end    = reinterpret_cast<const char*>(_file.data()) + pattern.end;
+    int64_t     x      = 0;
+    int64_t     y      = 0;
+    uint64_t    count  = 0;
+
+    while(cursor < end) {
+        const char character = *cursor++;
+        if((character >= '0') && (character <= '9')) {
+            count = (count * 10) + (character - '0');
+            if(count > static_cast<uint64_t>(pt::MAX_COORD)) {
+                pt::invalid(_path, "invalid RLE run in");
+            }
+            continue;
+        }
+        const uint64_t length = (count != 0 ? count : 1);
+        unsigned       state  = 0;
+        count = 0;
+        switch(character) {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                continue;
+            case '$':
+                x  = 0;
+                y += length;
+                continue;
+            case 'b':
+            case '.':
+                state = 0;
+                break;
+            case 'o':
+                state = 1;
+                break;
+            default:
+                if((character >= 'A') && (character <= 'X')) {
+                    state = (character - 'A') + 1;
+                    break;
+                }
+                pt::invalid(_path, "invalid RLE data in");
+                break;
+        }
+        if(state != 0) {
+            sink(x, y, length, state);
+        }
+        x += length;
+    }
+}
+
+void PatternFile::decodeLife106(const Pattern& pattern, const Sink& sink) const
+{
+    const char* cursor = reinterpret_cast<const char*>(_file.data()) + pattern.begin;
+    const char* end    = reinterpret_cast<const char*>(_file.data()) + pattern.end;
+
+    while(cursor < end) {
+        const char* line = cursor;
+        const char* last = pt::eol(line, end);
+        cursor = pt::next(line, end);
+        if((pt::skip(line, last) == last) || (*line == '#')) {
+            continue;
+        }
+        int64_t x = 0;
+        int64_t y = 0;
+        if((pt::integer(line, last, x) == false) || (pt::integer(line, last, y) == false) || (pt::skip(line, last) != last)) {
+            pt::invalid(_path, "invalid Life 1.06 cell in");
+        }
+        sink(x, y, 1, 1);
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
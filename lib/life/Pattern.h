@@ -0,0 +1,120 @@
+/*
+ * Pattern.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIFE_Pattern_h__
+#define __LIFE_Pattern_h__
+
+#include <functional>
+#include <unordered_map>
+#include <base/MappedFile.h>
+
+// ---------------------------------------------------------------------------
+// life
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+struct Pattern;
+class PatternFile;
+
+}
+
+// ---------------------------------------------------------------------------
+// life::Pattern
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+struct Pattern
+{
+    enum class Format : uint8_t
+    {
+        kRLE     = 0,
+        kLIFE106 = 1,
+    };
+
+    Format      format;
+    std::string name;   /* from the #N line, or the ordinal of the pattern */
+    std::string rule;   /* from the RLE header, may be empty               */
+    size_t      begin;  /* offset of the first cell                        */
+    size_t      end;    /* offset past the last cell                       */
+    int64_t     width;  /* from the RLE header, 0 for Life 1.06            */
+    int64_t     height; /* from the RLE header, 0 for Life 1.06            */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// life::PatternFile
+//
+// A memory-mapped collection of RLE and Life 1.06 patterns. The file is
+// scanned once to build an index of the offsets of each pattern by name and
+// ordinal, so that a pattern is found in constant time and decoded straight
+// from the mapping, one run of cells at a time, without any copy.
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class PatternFile
+{
+public: // public interface
+    using Sink = std::function<void(int64_t x, int64_t y, uint64_t length, unsigned state)>;
+
+    PatternFile(const std::string& path);
+
+    virtual ~PatternFile();
+
+    const Pattern& find(const std::string& name) const;
+
+    void bounds(const Pattern& pattern, int64_t& x, int64_t& y, int64_t& width, int64_t& height) const;
+
+    void decode(const Pattern& pattern, const Sink& sink) const;
+
+    size_t count() const
+    {
+        return _patterns.size();
+    }
+
+    const Pattern& at(const size_t index) const
+    {
+        return _patterns.at(index);
+    }
+
+private: // private interface
+    void index();
+
+    void decodeRLE(const Pattern& pattern, const Sink& sink) const;
+
+    void decodeLife106(const Pattern& pattern, const Sink& sink) const;
+
+private: // private data
+    const std::string                       _path;
+    const base::MappedFile                  _file;
+    std::vector<Pattern>                    _patterns;
+    std::unordered_map<std::string, size_t> _index;
+
+private: // disable copy and assignment
+    PatternFile(const PatternFile&) = delete;
+    PatternFile& operator=(const PatternFile&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __LIFE_Pattern_h__ */
@@ -0,0 +1,228 @@
+/*
+ * Rule.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include "Rule.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::rl
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct rl
+{
+    struct Alias
+    {
+        const char* name;
+        const char* rule;
+    };
+
+    static const char* alias(const std::string& name)
+    {
+        static const Alias aliases[] = {
+            { "life"     , "B3/S23"       },
+            { "conway"   , "B3/S23"       },
+            { "highlife" , "B36/S23"      },
+            { "seeds"    , "B2/S"         },
+            { "daynight" , "B3678/S34678" },
+            { "maze"     , "B3/S12345"    },
+            { "brain"    , "B2/S/C3"      },
+            { "starwars" , "B2/S345/C4"   },
+        };
+        for(auto& alias : aliases) {
+            if(name == alias.name) {
+                return alias.rule;
+            }
+        }
+        return name.c_str();
+    }
+
+    static std::string lower(const std::string& rule)
+    {
+        std::string string(rule);
+        for(auto& character : string) {
+            character = ::tolower(character);
+        }
+        return string;
+    }
+
+    static void invalid(const std::string& rule)
+    {
+        throw std::runtime_error(std::string("invalid rule") + ' ' + '<' + rule + '>');
+    }
+
+    /* parses a list of neighbor counts, e.g. "236" */
+    static unsigned counts(const std::string& rule, const char*& string)
+    {
+        unsigned mask = 0;
+        while((*string >= '0') && (*string <= '8')) {
+            mask |= (1U << (*string++ - '0'));
+        }
+        if((*string != '\0') && (*string != '/')) {
+            invalid(rule);
+        }
+        return mask;
+    }
+
+    /* parses the number of states of a Generations rule */
+    static unsigned states(const std::string& rule, const char* string)
+    {
+        char* endptr = nullptr;
+        const unsigned long states = ::strtoul(string, &endptr, 10);
+        if((endptr == string) || (*endptr != '\0') || (states < 2) || (states > life::Rule::MAX_STATES)) {
+            invalid(rule);
+        }
+        return states;
+    }
+
+    /* parses a prefixed section, e.g. "B36" or "S23" */
+    static unsigned section(const std::string& rule, const char*& string, const char prefix)
+    {
+        if(::toupper(*string) != prefix) {
+            invalid(rule);
+        }
+        const unsigned mask = counts(rule, ++string);
+        if(*string == '/') {
+            ++string;
+        }
+        return mask;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// life::Rule
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+Rule::Rule()
+    : Rule("life")
+{
+}
+
+Rule::Rule(const std::string& rule)
+    : _name(rule)
+    , _family(Family::kLIFE)
+    , _states(2)
+    , _planes(1)
+    , _born(0)
+    , _survive(0)
+    , _conway(false)
+    , _used(0)
+    , _transitions(0)
+    , _table()
+    , _transition()
+{
+    const std::string lower(rl::lower(rule));
+
+    if(lower == "wireworld") {
+        _family = Family::kWIREWORLD;
+        _states = 4;
+    }
+    else {
+        const char* string = rl::alias(lower);
+        if((::isdigit(*string) != 0) || (*string == '/')) {
+            /* S/B notation, e.g. "23/3" or "345/2/4" */
+            _survive = rl::counts(rule, string);
+            if(*string++ != '/') {
+                rl::invalid(rule);
+            }
+            _born = rl::counts(rule, string);
+            if(*string == '/') {
+                _states = rl::states(rule, ++string);
+            }
+        }
+        else {
+            _born    = rl::section(rule, string, 'B');
+            _survive = rl::section(rule, string, 'S');
+            if(*string != '\0') {
+                if(::toupper(*string) != 'C') {
+                    rl::invalid(rule);
+                }
+                _states = rl::states(rule, ++string);
+            }
+        }
+        if(_states > 2) {
+            _family = Family::kGENERATIONS;
+        }
+    }
+    while((1U << _planes) < _states) {
+        ++_planes;
+    }
+    _conway = (_family == Family::kLIFE) && (_born == (1U << 3)) && (_survive == ((1U << 2) | (1U << 3)));
+    compile();
+}
+
+void Rule::compile()
+{
+    for(unsigned count = 0; count < COUNTS; ++count) {
+        const unsigned mask = (1U << count);
+        switch(_family) {
+            case Family::kLIFE:
+            case Family::kGENERATIONS:
+                _table[0][count] = ((_born & mask) != 0 ? 1 : 0);
+                _table[1][count] = ((_survive & mask) != 0 ? 1 : (_states > 2 ? 2 : 0));
+                for(unsigned state = 2; state < _states; ++state) {
+                    _table[state][count] = ((state + 1) < _states ? state + 1 : 0);
+                }
+                break;
+            case Family::kWIREWORLD:
+                _table[0][count] = 0;
+                _table[1][count] = 2;
+                _table[2][count] = 3;
+                _table[3][count] = ((count == 1) || (count == 2) ? 1 : 3);
+                break;
+        }
+    }
+    /* one transition per (from, to) pair, the empty state needs none */
+    for(unsigned from = 0; from < _states; ++from) {
+        for(unsigned to = 1; to < _states; ++to) {
+            unsigned counts = 0;
+            for(unsigned count = 0; count < COUNTS; ++count) {
+                if(_table[from][count] == to) {
+                    counts |= (1U << count);
+                }
+            }
+            if(counts != 0) {
+                Transition& transition(_transition[_transitions++]);
+                transition.from   = from;
+                transition.to     = to;
+                transition.counts = counts;
+                if(counts != ALL_COUNTS) {
+                    _used |= counts;
+                }
+            }
+        }
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
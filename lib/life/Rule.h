@@ -0,0 +1,184 @@
+/*
+ * Rule.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIFE_Rule_h__
+#define __LIFE_Rule_h__
+
+// ---------------------------------------------------------------------------
+// life
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class Rule;
+
+}
+
+// ---------------------------------------------------------------------------
+// life::Rule
+//
+// A totalistic cellular automaton compiled from a rule string into a table
+// of next states indexed by (state, neighbor count), where only the cells in
+// state 1 are counted as neighbors. The states of a cell are stored in bit
+// planes, so that the table is also compiled into a list of transitions that
+// evaluate a whole word of cells with bitwise operations.
+//
+//   B3/S23      Life-like: born with 3 neighbors, survive with 2 or 3
+//   23/3        the same in S/B notation
+//   B2/S/C3     Generations: C states, the dying cells age until empty
+//   wireworld   empty, electron head, electron tail and conductor
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class Rule
+{
+public: // public interface
+    enum class Family : uint8_t
+    {
+        kLIFE        = 0,
+        kGENERATIONS = 1,
+        kWIREWORLD   = 2,
+    };
+
+    Rule();
+
+    Rule(const std::string& rule);
+
+    uint8_t next(const unsigned state, const unsigned count) const
+    {
+        return _table[state][count];
+    }
+
+    Family family() const
+    {
+        return _family;
+    }
+
+    unsigned states() const
+    {
+        return _states;
+    }
+
+    unsigned planes() const
+    {
+        return _planes;
+    }
+
+    bool born(const unsigned count) const
+    {
+        return _table[0][count] == 1;
+    }
+
+    bool conway() const
+    {
+        return _conway;
+    }
+
+    const std::string& name() const
+    {
+        return _name;
+    }
+
+    template <typename T>
+    inline __attribute__((always_inline)) T firing(const T* states) const
+    {
+        T cells = states[0];
+
+        for(unsigned plane = 1; plane < _planes; ++plane) {
+            cells &= ~states[plane];
+        }
+        return cells;
+    }
+
+    template <typename T>
+    inline __attribute__((always_inline)) void evaluate(const T* states, const T& bit0, const T& bit1, const T& bit2, const T& bit3, T* result) const
+    {
+        if(_conway) {
+            /* 2 or 3 neighbors survive, exactly 3 are born */
+            result[0] = bit1 & ~bit2 & ~bit3 & (bit0 | states[0]);
+            return;
+        }
+        const T lo[4] = { ~bit0 & ~bit1, bit0 & ~bit1, ~bit0 & bit1, bit0 & bit1 };
+        const T hi[4] = { ~bit2 & ~bit3, bit2 & ~bit3, ~bit2 & bit3, bit2 & bit3 };
+        T       equals[COUNTS];
+
+        for(unsigned count = 0; count < COUNTS; ++count) {
+            if((_used & (1U << count)) != 0) {
+                equals[count] = lo[count & 3] & hi[count >> 2];
+            }
+        }
+        for(unsigned plane = 0; plane < _planes; ++plane) {
+            result[plane] = T();
+        }
+        for(unsigned index = 0; index < _transitions; ++index) {
+            const Transition& transition(_transition[index]);
+            T cells = ((transition.from & 1) != 0 ? states[0] : ~states[0]);
+            for(unsigned plane = 1; plane < _planes; ++plane) {
+                cells &= ((transition.from >> plane) & 1) != 0 ? states[plane] : ~states[plane];
+            }
+            if(transition.counts != ALL_COUNTS) {
+                T match = equals[__builtin_ctz(transition.counts)];
+                for(unsigned counts = transition.counts & (transition.counts - 1); counts != 0; counts &= (counts - 1)) {
+                    match |= equals[__builtin_ctz(counts)];
+                }
+                cells &= match;
+            }
+            for(unsigned plane = 0; plane < _planes; ++plane) {
+                if(((transition.to >> plane) & 1) != 0) {
+                    result[plane] |= cells;
+                }
+            }
+        }
+    }
+
+public: // public static data
+    static constexpr unsigned COUNTS     = 9;
+    static constexpr unsigned ALL_COUNTS = (1U << COUNTS) - 1;
+    static constexpr unsigned MAX_STATES = 16;
+    static constexpr unsigned MAX_PLANES = 4;
+
+private: // private interface
+    struct Transition
+    {
+        uint8_t  from;
+        uint8_t  to;
+        uint16_t counts;
+    };
+
+    void compile();
+
+private: // private data
+    std::string _name;
+    Family      _family;
+    unsigned    _states;
+    unsigned    _planes;
+    unsigned    _born;
+    unsigned    _survive;
+    bool        _conway;
+    unsigned    _used;
+    unsigned    _transitions;
+    uint8_t     _table[MAX_STATES][COUNTS];
+    Transition  _transition[MAX_STATES * MAX_STATES];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __LIFE_Rule_h__ */
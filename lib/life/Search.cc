@@ -0,0 +1,311 @@
+/*
+ * Search.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <base/Cpu.h>
+#include "Cycle.h"
+#include "Search.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ss
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ss
+{
+    typedef uint64_t vec4 __attribute__((vector_size(32)));
+
+    static constexpr uint64_t COL0      = 0x0101010101010101ULL;
+    static constexpr uint64_t COL7      = 0x8080808080808080ULL;
+    static constexpr unsigned KEY_SHIFT = 48;
+    static constexpr uint64_t KEY_INDEX = (1ULL << KEY_SHIFT) - 1;
+
+    struct Lanes
+    {
+        uint64_t seed[life::SoupSearch::LANES];
+        uint32_t lifespan[life::SoupSearch::LANES];
+        uint32_t period[life::SoupSearch::LANES];
+        uint32_t population[life::SoupSearch::LANES];
+    };
+
+    template <typename T>
+    static inline __attribute__((always_inline)) void full_adder(const T& a, const T& b, const T& c, T& sum, T& carry)
+    {
+        const T t = a ^ b;
+        sum   = t ^ c;
+        carry = (a & b) | (t & c);
+    }
+
+    /* one generation of independent 8x8 tori, see life::Bitboard */
+    template <typename T>
+    static inline __attribute__((always_inline)) void step(const life::Rule& rule, const T& board, T& result)
+    {
+        const T w  = ((board << 1) & ~COL0) | ((board >> 7) & COL0);
+        const T e  = ((board >> 1) & ~COL7) | ((board << 7) & COL7);
+        const T n0 = (w << 8) | (w >> 56), n1 = (board << 8) | (board >> 56), n2 = (e << 8) | (e >> 56);
+        const T s0 = (w >> 8) | (w << 56), s1 = (board >> 8) | (board << 56), s2 = (e >> 8) | (e << 56);
+
+        T s0a, c0a, s0b, c0b, bit0, c1, s1a, c1a;
+        full_adder<T>(n0, n1, n2, s0a, c0a);
+        full_adder<T>(w, e, s0, s0b, c0b);
+        const T s0c = s1 ^ s2;
+        const T c0c = s1 & s2;
+        full_adder<T>(s0a, s0b, s0c, bit0, c1);
+        full_adder<T>(c0a, c0b, c0c, s1a, c1a);
+        const T bit1 = s1a ^ c1;
+        const T c2   = s1a & c1;
+        const T bit2 = c1a ^ c2;
+        const T bit3 = c1a & c2;
+
+        const T states[life::Rule::MAX_PLANES] = { board };
+        T       next[life::Rule::MAX_PLANES];
+        rule.evaluate(states, bit0, bit1, bit2, bit3, next);
+        result = next[0];
+    }
+
+    /* the kernel of base::Cpu::dispatch() */
+    struct Evaluate
+    {
+        inline __attribute__((always_inline)) void operator()(const life::Rule& rule, Lanes& lanes) const
+        {
+            constexpr unsigned LANES = life::SoupSearch::LANES;
+            constexpr uint32_t LIMIT = life::SoupSearch::MAX_GENERATIONS;
+            vec4     initial;
+            uint32_t power[LANES];
+            uint32_t lambda[LANES];
+            unsigned pending = LANES;
+
+            for(unsigned lane = 0; lane < LANES; ++lane) {
+                initial[lane]          = life::CycleDetector::mix(lanes.seed[lane]);
+                power[lane]            = 1;
+                lambda[lane]           = 0;
+                lanes.lifespan[lane]   = LIMIT;
+                lanes.period[lane]     = 0;
+                lanes.population[lane] = 0;
+            }
+            /* Brent: the period of each lane */
+            vec4 tortoise = initial;
+            vec4 hare;
+            step<vec4>(rule, initial, hare);
+            for(uint32_t generation = 1; (pending != 0) && (generation < LIMIT); ++generation) {
+                for(unsigned lane = 0; lane < LANES; ++lane) {
+                    if(lanes.period[lane] != 0) {
+                        continue;
+                    }
+                    ++lambda[lane];
+                    if(tortoise[lane] == hare[lane]) {
+                        lanes.period[lane] = lambda[lane];
+                        --pending;
+                    }
+                    else if(power[lane] == lambda[lane]) {
+                        tortoise[lane] = hare[lane];
+                        power[lane]  <<= 1;
+                        lambda[lane]   = 0;
+                    }
+                }
+                step<vec4>(rule, hare, hare);
+            }
+            /* the lifespan: a copy one period ahead catches up with the first */
+            uint32_t longest = 0;
+            for(unsigned lane = 0; lane < LANES; ++lane) {
+                longest = std::max(longest, lanes.period[lane]);
+            }
+            vec4 ahead = initial;
+            for(uint32_t generation = 0; generation < longest; ++generation) {
+                vec4 next;
+                step<vec4>(rule, ahead, next);
+                for(unsigned lane = 0; lane < LANES; ++lane) {
+                    if(generation < lanes.period[lane]) {
+                        ahead[lane] = next[lane];
+                    }
+                }
+            }
+            vec4 behind = initial;
+            pending  = 0;
+            for(unsigned lane = 0; lane < LANES; ++lane) {
+                if(lanes.period[lane] != 0) {
+                    ++pending;
+                }
+            }
+            for(uint32_t generation = 0; (pending != 0) && (generation < LIMIT); ++generation) {
+                for(unsigned lane = 0; lane < LANES; ++lane) {
+                    if((lanes.period[lane] != 0) && (lanes.lifespan[lane] == LIMIT) && (behind[lane] == ahead[lane])) {
+                        lanes.lifespan[lane]   = generation;
+                        lanes.population[lane] = __builtin_popcountll(behind[lane]);
+                        --pending;
+                    }
+                }
+                step<vec4>(rule, behind, behind);
+                step<vec4>(rule, ahead, ahead);
+            }
+        }
+    };
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// life::SoupSearch
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+SoupSearch::SoupSearch(const Rule& rule, base::ThreadPool& pool, const uint64_t base, const unsigned top)
+    : _rule(rule)
+    , _pool(pool)
+    , _base(base)
+    , _top(top)
+    , _leaders(new std::atomic<uint64_t>[top])
+    , _evaluated(0)
+{
+    if(_rule.states() != 2) {
+        throw std::runtime_error("soup search only supports two-state rules");
+    }
+    if((top < 1) || (top > MAX_TOP)) {
+        throw std::runtime_error("invalid leaderboard size");
+    }
+    for(unsigned index = 0; index < _top; ++index) {
+        _leaders[index].store(0, std::memory_order_relaxed);
+    }
+}
+
+SoupSearch::~SoupSearch()
+{
+}
+
+void SoupSearch::run(const uint64_t soups)
+{
+    const uint64_t first   = _evaluated;
+    const uint64_t batches = (soups + BATCH - 1) / BATCH;
+
+    _pool.run(batches, [&](const size_t index) -> void
+    {
+        const uint64_t offset = index * BATCH;
+        batch((first + offset), std::min<uint64_t>(BATCH, (soups - offset)));
+    });
+    _evaluated += soups;
+}
+
+std::vector<Soup> SoupSearch::leaders() const
+{
+    std::vector<uint64_t> keys;
+    std::vector<Soup>     soups;
+
+    for(unsigned index = 0; index < _top; ++index) {
+        const uint64_t key = _leaders[index].load(std::memory_order_acquire);
+        if(key != 0) {
+            keys.push_back(key);
+        }
+    }
+    std::sort(keys.begin(), keys.end(), [](const uint64_t lhs, const uint64_t rhs) -> bool
+    {
+        return lhs > rhs;
+    });
+    for(const auto key : keys) {
+        soups.push_back(evaluate(_base + (key & ss::KEY_INDEX)));
+    }
+    return soups;
+}
+
+Soup SoupSearch::evaluate(const uint64_t seed) const
+{
+    ss::Lanes lanes;
+
+    for(unsigned lane = 0; lane < LANES; ++lane) {
+        lanes.seed[lane] = seed;
+    }
+    base::Cpu::dispatch<ss::Evaluate>(_rule, lanes);
+
+    Soup soup;
+    soup.seed       = seed;
+    soup.lifespan   = lanes.lifespan[0];
+    soup.period     = lanes.period[0];
+    soup.population = lanes.population[0];
+    return soup;
+}
+
+uint64_t SoupSearch::board(const uint64_t seed)
+{
+    return CycleDetector::mix(seed);
+}
+
+void SoupSearch::batch(const uint64_t first, const uint64_t count)
+{
+    const uint64_t last = first + count;
+    ss::Lanes lanes;
+    uint64_t  floor = _leaders[0].load(std::memory_order_relaxed);
+
+    for(unsigned index = 1; index < _top; ++index) {
+        floor = std::min(floor, _leaders[index].load(std::memory_order_relaxed));
+    }
+    for(uint64_t index = first; index < last; index += LANES) {
+        for(unsigned lane = 0; lane < LANES; ++lane) {
+            lanes.seed[lane] = _base + index + lane;
+        }
+        base::Cpu::dispatch<ss::Evaluate>(_rule, lanes);
+        /* the lanes past the last soup and those still unresolved at the limit are left out */
+        for(unsigned lane = 0; (lane < LANES) && ((index + lane) < last); ++lane) {
+            if(lanes.period[lane] == 0) {
+                continue;
+            }
+            const uint64_t key = (static_cast<uint64_t>(lanes.lifespan[lane]) << ss::KEY_SHIFT) | ((index + lane) & ss::KEY_INDEX);
+            if(key > floor) {
+                submit(key);
+            }
+        }
+    }
+}
+
+void SoupSearch::submit(const uint64_t key)
+{
+    /* the slots only grow, so the minimum found by a scan stays the minimum until replaced */
+    for(;;) {
+        unsigned minimum = 0;
+        uint64_t value   = _leaders[0].load(std::memory_order_acquire);
+        for(unsigned index = 1; index < _top; ++index) {
+            const uint64_t other = _leaders[index].load(std::memory_order_acquire);
+            if(other < value) {
+                minimum = index;
+                value   = other;
+            }
+        }
+        if(key <= value) {
+            return;
+        }
+        if(_leaders[minimum].compare_exchange_weak(value, key, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
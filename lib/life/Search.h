@@ -0,0 +1,115 @@
+/*
+ * Search.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIFE_Search_h__
+#define __LIFE_Search_h__
+
+#include <base/ThreadPool.h>
+#include <life/Bitboard.h>
+
+// ---------------------------------------------------------------------------
+// life
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+struct Soup;
+class SoupSearch;
+
+}
+
+// ---------------------------------------------------------------------------
+// life::Soup
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+struct Soup
+{
+    uint64_t seed;       /* the initial board is CycleDetector::mix(seed) */
+    uint32_t lifespan;   /* generations before the soup becomes periodic  */
+    uint32_t period;     /* period of the final state, 0 if not reached   */
+    uint32_t population; /* population of the final state                 */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// life::SoupSearch
+//
+// Evaluates random 8x8 torus soups on all the workers of a thread pool. The
+// soups are simulated in batches of independent bitboards, one per lane of
+// a 256-bit vector: the period of each lane is found with Brent's algorithm,
+// then its lifespan by running two copies one period apart. The longest-
+// lived soups are kept in a lock-free leaderboard of packed 64-bit keys
+// (lifespan, soup index) where a key replaces the minimum with a CAS. A soup
+// whose period is not reached within MAX_GENERATIONS is unresolved and never
+// enters the leaderboard.
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class SoupSearch
+{
+public: // public interface
+    SoupSearch(const Rule& rule, base::ThreadPool& pool, const uint64_t base, const unsigned top);
+
+    virtual ~SoupSearch();
+
+    void run(const uint64_t soups);
+
+    std::vector<Soup> leaders() const;
+
+    uint64_t evaluated() const
+    {
+        return _evaluated;
+    }
+
+    Soup evaluate(const uint64_t seed) const;
+
+    static uint64_t board(const uint64_t seed);
+
+public: // public static data
+    static constexpr unsigned LANES           = 4;
+    static constexpr unsigned BATCH           = 1024;
+    static constexpr unsigned MAX_TOP         = 64;
+    static constexpr uint32_t MAX_GENERATIONS = 65535;
+
+private: // private interface
+    void batch(const uint64_t first, const uint64_t count);
+
+    void submit(const uint64_t key);
+
+private: // private data
+    const Rule                               _rule;
+    base::ThreadPool&                        _pool;
+    const uint64_t                           _base;
+    const unsigned                           _top;
+    std::unique_ptr<std::atomic<uint64_t>[]> _leaders;
+    uint64_t                                 _evaluated;
+
+private: // disable copy and assignment
+    SoupSearch(const SoupSearch&) = delete;
+    SoupSearch& operator=(const SoupSearch&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __LIFE_Search_h__ */
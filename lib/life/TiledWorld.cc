@@ -0,0 +1,407 @@
+/*
+ * TiledWorld.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <base/Cpu.h>
+#include "Cycle.h"
+#include "TiledWorld.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::tw
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct tw
+{
+    typedef uint64_t vec4 __attribute__((vector_size(32)));
+
+    static constexpr uint32_t PAD_ROWS  = life::TiledWorld::TILE_ROWS  + 2;
+    static constexpr uint32_t PAD_WORDS = life::TiledWorld::TILE_WORDS + 2;
+    static constexpr uint32_t PAD_SIZE  = PAD_ROWS * PAD_WORDS;
+
+    template <typename T>
+    static inline __attribute__((always_inline)) void load(T& value, const uint64_t* data)
+    {
+        ::memcpy(&value, data, sizeof(T));
+    }
+
+    template <typename T>
+    static inline __attribute__((always_inline)) void store(uint64_t* data, const T& value)
+    {
+        ::memcpy(data, &value, sizeof(T));
+    }
+
+    template <typename T>
+    static inline __attribute__((always_inline)) void full_adder(const T& a, const T& b, const T& c, T& sum, T& carry)
+    {
+        const T t = a ^ b;
+        sum   = t ^ c;
+        carry = (a & b) | (t & c);
+    }
+
+    /*
+     * computes sizeof(T) / 8 words of the next generation, the pointers are
+     * on the current word of the firing cells of the rows above, at and below
+     * the output row, and on the current word of the first state plane.
+     */
+    template <unsigned PLANES, typename T>
+    static inline __attribute__((always_inline)) void kernel(const life::Rule& rule, const uint64_t* n, const uint64_t* c, const uint64_t* s, const uint64_t* states, uint64_t* out, const size_t stride)
+    {
+        T nm, nw, ne, cm, cw, ce, sm, sw, se;
+        load<T>(nm, n); load<T>(nw, n - 1); load<T>(ne, n + 1);
+        load<T>(cm, c); load<T>(cw, c - 1); load<T>(ce, c + 1);
+        load<T>(sm, s); load<T>(sw, s - 1); load<T>(se, s + 1);
+
+        /* bit i is the column i of the word, the west neighbor is bit i - 1 */
+        const T n0 = (nm << 1) | (nw >> 63), n1 = nm, n2 = (nm >> 1) | (ne << 63);
+        const T c0 = (cm << 1) | (cw >> 63),          c2 = (cm >> 1) | (ce << 63);
+        const T s0 = (sm << 1) | (sw >> 63), s1 = sm, s2 = (sm >> 1) | (se << 63);
+
+        T s0a, c0a, s0b, c0b, bit0, c1, s1a, c1a;
+        full_adder<T>(n0, n1, n2, s0a, c0a);
+        full_adder<T>(c0, c2, s0, s0b, c0b);
+        const T s0c = s1 ^ s2;
+        const T c0c = s1 & s2;
+        full_adder<T>(s0a, s0b, s0c, bit0, c1);
+        full_adder<T>(c0a, c0b, c0c, s1a, c1a);
+        const T bit1 = s1a ^ c1;
+        const T c2x  = s1a & c1;
+        const T bit2 = c1a ^ c2x;
+        const T bit3 = c1a & c2x;
+
+        T cells[life::Rule::MAX_PLANES];
+        T next[life::Rule::MAX_PLANES];
+        for(unsigned plane = 0; plane < PLANES; ++plane) {
+            load<T>(cells[plane], states + plane * PAD_SIZE);
+        }
+        rule.evaluate(cells, bit0, bit1, bit2, bit3, next);
+        for(unsigned plane = 0; plane < PLANES; ++plane) {
+            store<T>(out + plane * stride, next[plane]);
+        }
+    }
+
+    template <unsigned PLANES>
+    static inline __attribute__((always_inline)) void run(const life::Rule& rule, const uint64_t* fire, const uint64_t* pad, uint64_t* out, const uint32_t rows, const uint32_t words, const uint32_t width, const size_t stride)
+    {
+        for(uint32_t row = 0; row < rows; ++row) {
+            const uint64_t* n = fire + (row + 0) * PAD_WORDS + 1;
+            const uint64_t* c = fire + (row + 1) * PAD_WORDS + 1;
+            const uint64_t* s = fire + (row + 2) * PAD_WORDS + 1;
+            const uint64_t* p = pad  + (row + 1) * PAD_WORDS + 1;
+            uint64_t*       o = out  + row * width;
+            uint32_t word = 0;
+            for(; (word + 4) <= words; word += 4) {
+                kernel<PLANES, vec4>(rule, n + word, c + word, s + word, p + word, o + word, stride);
+            }
+            for(; word < words; ++word) {
+                kernel<PLANES, uint64_t>(rule, n + word, c + word, s + word, p + word, o + word, stride);
+            }
+        }
+    }
+
+    /* the kernel of base::Cpu::dispatch() */
+    struct Generation
+    {
+        inline __attribute__((always_inline)) void operator()(const life::Rule& rule, const uint64_t* fire, const uint64_t* pad, uint64_t* out, const uint32_t rows, const uint32_t words, const uint32_t width, const size_t stride) const
+        {
+            switch(rule.planes()) {
+                case 1:
+                    run<1>(rule, fire, pad, out, rows, words, width, stride);
+                    break;
+                case 2:
+                    run<2>(rule, fire, pad, out, rows, words, width, stride);
+                    break;
+                case 3:
+                    run<3>(rule, fire, pad, out, rows, words, width, stride);
+                    break;
+                default:
+                    run<4>(rule, fire, pad, out, rows, words, width, stride);
+                    break;
+            }
+        }
+    };
+
+    static uint32_t wrap(const int64_t value, const uint32_t size)
+    {
+        const int64_t modulo = value % static_cast<int64_t>(size);
+        return static_cast<uint32_t>(modulo < 0 ? modulo + size : modulo);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// life::TiledWorld
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+TiledWorld::TiledWorld(const Rule& rule, const uint32_t width, const uint32_t height, base::ThreadPool& pool)
+    : _rule(rule)
+    , _pool(pool)
+    , _width(width)
+    , _height(height)
+    , _words(width / WORD_BITS)
+    , _plane(static_cast<size_t>(_words) * height)
+    , _tileCols((_words + TILE_WORDS - 1) / TILE_WORDS)
+    , _tileRows((height + TILE_ROWS - 1) / TILE_ROWS)
+    , _curr()
+    , _next()
+    , _generation(0)
+{
+    if((width < MIN_WIDTH) || (width > MAX_WIDTH) || ((width % WORD_BITS) != 0)) {
+        throw std::runtime_error("invalid world width");
+    }
+    if((height < MIN_HEIGHT) || (height > MAX_HEIGHT)) {
+        throw std::runtime_error("invalid world height");
+    }
+    _curr.assign(_plane * _rule.planes(), 0);
+    _next.assign(_plane * _rule.planes(), 0);
+}
+
+TiledWorld::~TiledWorld()
+{
+}
+
+void TiledWorld::clear()
+{
+    std::fill(_curr.begin(), _curr.end(), 0);
+    _generation = 0;
+}
+
+void TiledWorld::randomize(const uint64_t seed)
+{
+    std::mt19937_64 generator(seed);
+
+    /* random cells in state 0 or 1 */
+    std::fill(_curr.begin(), _curr.end(), 0);
+    for(size_t index = 0; index < _plane; ++index) {
+        _curr[index] = generator();
+    }
+    _generation = 0;
+}
+
+void TiledWorld::set(const int64_t x, const int64_t y, const unsigned state)
+{
+    const uint32_t col    = tw::wrap(x, _width);
+    const uint32_t row    = tw::wrap(y, _height);
+    const size_t   offset = static_cast<size_t>(row) * _words + (col / WORD_BITS);
+    const uint64_t mask   = 1ULL << (col % WORD_BITS);
+
+    for(unsigned plane = 0; plane < _rule.planes(); ++plane) {
+        uint64_t& word = _curr[plane * _plane + offset];
+        word = (((state >> plane) & 1) != 0 ? (word | mask) : (word & ~mask));
+    }
+}
+
+unsigned TiledWorld::get(const int64_t x, const int64_t y) const
+{
+    const uint32_t col    = tw::wrap(x, _width);
+    const uint32_t row    = tw::wrap(y, _height);
+    const size_t   offset = static_cast<size_t>(row) * _words + (col / WORD_BITS);
+    unsigned       state  = 0;
+
+    for(unsigned plane = 0; plane < _rule.planes(); ++plane) {
+        state |= ((_curr[plane * _plane + offset] >> (col % WORD_BITS)) & 1) << plane;
+    }
+    return state;
+}
+
+void TiledWorld::step(const uint64_t generations)
+{
+    const size_t  tiles = static_cast<size_t>(_tileRows) * _tileCols;
+    const base::ThreadPool::Task task([&](const size_t tile) -> void { compute(tile); });
+
+    for(uint64_t count = 0; count < generations; ++count) {
+        _pool.run(tiles, task);
+        _curr.swap(_next);
+        ++_generation;
+    }
+}
+
+void TiledWorld::viewport(const int64_t x, const int64_t y, uint64_t* states) const
+{
+    for(unsigned plane = 0; plane < _rule.planes(); ++plane) {
+        states[plane] = 0;
+    }
+    for(int row = 0; row < Bitboard::ROWS; ++row) {
+        for(int col = 0; col < Bitboard::COLS; ++col) {
+            const unsigned state = get(x + col, y + row);
+            for(unsigned plane = 0; plane < _rule.planes(); ++plane) {
+                if(((state >> plane) & 1) != 0) {
+                    states[plane] |= Bitboard::mask(row, col);
+                }
+            }
+        }
+    }
+}
+
+void TiledWorld::downsample(uint64_t* states) const
+{
+    uint64_t counts[Bitboard::ROWS][Bitboard::COLS] = {};
+
+    for(uint32_t row = 0; row < _height; ++row) {
+        const size_t   offset = static_cast<size_t>(row) * _words;
+        const uint32_t prow   = (static_cast<uint64_t>(row) * Bitboard::ROWS) / _height;
+        for(uint32_t word = 0; word < _words; ++word) {
+            const uint32_t pcol = (static_cast<uint64_t>(word) * Bitboard::COLS) / _words;
+            counts[prow][pcol] += __builtin_popcountll(firing(offset + word));
+        }
+    }
+    /* a pad is in state 1 when the density of its block is above 1/32 */
+    const uint64_t area = (static_cast<uint64_t>(_width) * _height) / (Bitboard::ROWS * Bitboard::COLS);
+    for(unsigned plane = 0; plane < _rule.planes(); ++plane) {
+        states[plane] = 0;
+    }
+    for(int row = 0; row < Bitboard::ROWS; ++row) {
+        for(int col = 0; col < Bitboard::COLS; ++col) {
+            if((counts[row][col] * 32) > area) {
+                states[0] |= Bitboard::mask(row, col);
+            }
+        }
+    }
+}
+
+uint64_t TiledWorld::population() const
+{
+    uint64_t count = 0;
+
+    for(size_t offset = 0; offset < _plane; ++offset) {
+        count += __builtin_popcountll(firing(offset));
+    }
+    return count;
+}
+
+uint64_t TiledWorld::hash() const
+{
+    std::vector<uint64_t> hashes(_tileRows, 0);
+
+    /* each band of tile rows is hashed by a worker, then the bands are mixed */
+    _pool.run(_tileRows, [&](const size_t band) -> void
+    {
+        const size_t first = static_cast<size_t>(band) * TILE_ROWS * _words;
+        const size_t last  = std::min(first + (static_cast<size_t>(TILE_ROWS) * _words), _plane);
+        uint64_t     hash  = band;
+        for(unsigned plane = 0; plane < _rule.planes(); ++plane) {
+            const uint64_t* data = &_curr[plane * _plane];
+            for(size_t offset = first; offset < last; ++offset) {
+                hash = CycleDetector::mix(hash ^ data[offset]);
+            }
+        }
+        hashes[band] = hash;
+    });
+    uint64_t hash = 0;
+    for(const auto band : hashes) {
+        hash = CycleDetector::mix(hash ^ band);
+    }
+    return hash;
+}
+
+void TiledWorld::parse(const std::string& size, uint32_t& width, uint32_t& height)
+{
+    const char* string = size.c_str();
+    char*       endptr = nullptr;
+
+    const unsigned long w = ::strtoul(string, &endptr, 10);
+    if((endptr == string) || (*endptr != 'x')) {
+        throw std::runtime_error(std::string("invalid world size") + ' ' + '<' + size + '>');
+    }
+    string = endptr + 1;
+    const unsigned long h = ::strtoul(string, &endptr, 10);
+    if((endptr == string) || (*endptr != '\0')) {
+        throw std::runtime_error(std::string("invalid world size") + ' ' + '<' + size + '>');
+    }
+    if((w < MIN_WIDTH) || (w > MAX_WIDTH) || ((w % WORD_BITS) != 0) || (h < MIN_HEIGHT) || (h > MAX_HEIGHT)) {
+        char error[256];
+        const int rc = ::snprintf(error, sizeof(error), "invalid world size <%s>: width must be a multiple of %u in [%u, %u], height in [%u, %u]", size.c_str(), WORD_BITS, MIN_WIDTH, MAX_WIDTH, MIN_HEIGHT, MAX_HEIGHT);
+        if((rc < 0) || (rc == sizeof(error))) {
+            throw std::runtime_error("invalid world size");
+        }
+        throw std::runtime_error(error);
+    }
+    width  = w;
+    height = h;
+}
+
+uint64_t TiledWorld::firing(const size_t offset) const
+{
+    uint64_t states[Rule::MAX_PLANES] = {};
+
+    for(unsigned plane = 0; plane < _rule.planes(); ++plane) {
+        states[plane] = _curr[plane * _plane + offset];
+    }
+    return _rule.firing(states);
+}
+
+void TiledWorld::compute(const size_t tile)
+{
+    const uint32_t row0  = (tile / _tileCols) * TILE_ROWS;
+    const uint32_t word0 = (tile % _tileCols) * TILE_WORDS;
+    const uint32_t rows  = ((_height - row0)  < TILE_ROWS  ? (_height - row0)  : TILE_ROWS);
+    const uint32_t words = ((_words  - word0) < TILE_WORDS ? (_words  - word0) : TILE_WORDS);
+    const uint32_t west  = tw::wrap(static_cast<int64_t>(word0) - 1, _words);
+    const uint32_t east  = tw::wrap(static_cast<int64_t>(word0) + words, _words);
+    uint64_t       pad[Rule::MAX_PLANES * tw::PAD_SIZE];
+    uint64_t       fire[tw::PAD_SIZE];
+
+    /* gather the tile and its halo, wrapped around the torus */
+    for(unsigned plane = 0; plane < _rule.planes(); ++plane) {
+        for(uint32_t prow = 0; prow < (rows + 2); ++prow) {
+            const uint32_t  row = tw::wrap(static_cast<int64_t>(row0) + prow - 1, _height);
+            const uint64_t* src = &_curr[plane * _plane + static_cast<size_t>(row) * _words];
+            uint64_t*       dst = &pad[plane * tw::PAD_SIZE + prow * tw::PAD_WORDS];
+            dst[0] = src[west];
+            ::memcpy(dst + 1, src + word0, words * sizeof(uint64_t));
+            dst[words + 1] = src[east];
+        }
+    }
+    /* the cells counted as neighbors, the state plane of a two-state rule */
+    const uint64_t* firing = pad;
+    if(_rule.planes() > 1) {
+        for(uint32_t prow = 0; prow < (rows + 2); ++prow) {
+            for(uint32_t pword = 0; pword < (words + 2); ++pword) {
+                const size_t index = prow * tw::PAD_WORDS + pword;
+                uint64_t     states[Rule::MAX_PLANES] = {};
+                for(unsigned plane = 0; plane < _rule.planes(); ++plane) {
+                    states[plane] = pad[plane * tw::PAD_SIZE + index];
+                }
+                fire[index] = _rule.firing(states);
+            }
+        }
+        firing = fire;
+    }
+    uint64_t* out = &_next[static_cast<size_t>(row0) * _words + word0];
+    base::Cpu::dispatch<tw::Generation>(_rule, firing, pad, out, rows, words, _words, _plane);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
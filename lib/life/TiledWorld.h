@@ -0,0 +1,128 @@
+/*
+ * TiledWorld.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIFE_TiledWorld_h__
+#define __LIFE_TiledWorld_h__
+
+#include <base/ThreadPool.h>
+#include <life/Bitboard.h>
+
+// ---------------------------------------------------------------------------
+// life
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class TiledWorld;
+
+}
+
+// ---------------------------------------------------------------------------
+// life::TiledWorld
+//
+// A large finite torus, one bit per cell and per state plane of the rule,
+// 64 cells per word along a row.
+// Each generation is split into tiles of TILE_ROWS x TILE_WORDS words that
+// fit in the L1 cache. A tile first gathers its halo (the surrounding rows
+// and words, wrapped around the torus) into a padded local buffer, then runs
+// the bit-sliced kernel on 256-bit vectors (AVX2 when the CPU supports it).
+// The tiles of a generation are spread over a work-stealing thread pool.
+// ---------------------------------------------------------------------------
+
+namespace life {
+
+class TiledWorld
+{
+public: // public interface
+    TiledWorld(const Rule& rule, const uint32_t width, const uint32_t height, base::ThreadPool& pool);
+
+    virtual ~TiledWorld();
+
+    void clear();
+
+    void randomize(const uint64_t seed);
+
+    void set(const int64_t x, const int64_t y, const unsigned state);
+
+    unsigned get(const int64_t x, const int64_t y) const;
+
+    void step(const uint64_t generations);
+
+    void viewport(const int64_t x, const int64_t y, uint64_t* states) const;
+
+    void downsample(uint64_t* states) const;
+
+    uint64_t population() const;
+
+    uint64_t hash() const;
+
+    uint32_t width() const
+    {
+        return _width;
+    }
+
+    uint32_t height() const
+    {
+        return _height;
+    }
+
+    uint64_t generation() const
+    {
+        return _generation;
+    }
+
+    static void parse(const std::string& size, uint32_t& width, uint32_t& height);
+
+public: // public static data
+    static constexpr uint32_t WORD_BITS  = 64;
+    static constexpr uint32_t TILE_ROWS  = 64;
+    static constexpr uint32_t TILE_WORDS = 8;
+    static constexpr uint32_t MIN_WIDTH  = 64;
+    static constexpr uint32_t MIN_HEIGHT = 8;
+    static constexpr uint32_t MAX_WIDTH  = 65536;
+    static constexpr uint32_t MAX_HEIGHT = 65536;
+    static constexpr uint32_t MAX_STEP   = 16;
+
+private: // private interface
+    uint64_t firing(const size_t offset) const;
+
+    void compute(const size_t tile);
+
+private: // private data
+    const Rule            _rule;
+    base::ThreadPool&     _pool;
+    const uint32_t        _width;
+    const uint32_t        _height;
+    const uint32_t        _words;
+    const size_t          _plane;
+    const uint32_t        _tileCols;
+    const uint32_t        _tileRows;
+    std::vector<uint64_t> _curr;
+    std::vector<uint64_t> _next;
+    uint64_t              _generation;
+
+private: // disable copy and assignment
+    TiledWorld(const TiledWorld&) = delete;
+    TiledWorld& operator=(const TiledWorld&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __LIFE_TiledWorld_h__ */
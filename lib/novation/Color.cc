@@ -0,0 +1,59 @@
+/*
+ * Color.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include "Color.h"
+
+// ---------------------------------------------------------------------------
+// novation::Colors
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+constexpr Color Colors::BLACK;
+constexpr Color Colors::RED;
+constexpr Color Colors::GREEN;
+constexpr Color Colors::AMBER;
+constexpr Color Colors::YELLOW;
+constexpr Color Colors::ORANGE;
+constexpr Color Colors::DARK_RED;
+constexpr Color Colors::DARK_GREEN;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::MiniEncoding
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+static_assert(Palettes<MiniEncoding>::TABLE(Color(0x00, 0x00)) == 0x00, "unexpected black encoding");
+static_assert(Palettes<MiniEncoding>::TABLE(Color(0xff, 0x00)) == 0x03, "unexpected red encoding");
+static_assert(Palettes<MiniEncoding>::TABLE(Color(0x00, 0xff)) == 0x30, "unexpected green encoding");
+static_assert(Palettes<MiniEncoding>::TABLE(Color(0xff, 0xff), true, false) == 0x37, "unexpected copy flag");
+static_assert(Palettes<MiniEncoding>::TABLE(Color(0xff, 0xff), false, true) == 0x3b, "unexpected clear flag");
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,308 @@
+/*
+ * Color.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Color_h__
+#define __NOVATION_Color_h__
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Color;
+struct Colors;
+struct MiniEncoding;
+template <typename Encoding> class ColorTable;
+template <typename Encoding, size_t N> class Palette;
+template <typename Encoding, size_t N> class Gradient;
+template <typename Encoding> struct Palettes;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Color
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Color
+{
+    constexpr Color()
+        : red(0)
+        , green(0)
+    {
+    }
+
+    constexpr Color(const uint8_t r, const uint8_t g)
+        : red(r)
+        , green(g)
+    {
+    }
+
+    constexpr Color mix(const Color& other, const unsigned weight) const
+    {
+        return Color ( static_cast<uint8_t>((red   * (255 - weight) + other.red   * weight) / 255)
+                     , static_cast<uint8_t>((green * (255 - weight) + other.green * weight) / 255) );
+    }
+
+    constexpr bool operator==(const Color& other) const
+    {
+        return (red == other.red) && (green == other.green);
+    }
+
+    constexpr bool operator!=(const Color& other) const
+    {
+        return (red != other.red) || (green != other.green);
+    }
+
+    uint8_t red;
+    uint8_t green;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Colors
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Colors
+{
+    static constexpr Color BLACK      = Color(0x00, 0x00);
+    static constexpr Color RED        = Color(0xff, 0x00);
+    static constexpr Color GREEN      = Color(0x00, 0xff);
+    static constexpr Color AMBER      = Color(0xff, 0xff);
+    static constexpr Color YELLOW     = Color(0xaa, 0xff);
+    static constexpr Color ORANGE     = Color(0xff, 0x55);
+    static constexpr Color DARK_RED   = Color(0x55, 0x00);
+    static constexpr Color DARK_GREEN = Color(0x00, 0x55);
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::MiniEncoding
+//
+// Launchpad Mini / Launchpad S velocity byte: 2 bits per channel, plus the
+// copy and clear flags used with double buffering.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct MiniEncoding
+{
+    static constexpr unsigned LEVELS = 4;
+
+    static constexpr unsigned level(const uint8_t value)
+    {
+        return value >> 6;
+    }
+
+    static constexpr uint8_t encode(const unsigned red, const unsigned green, const bool copy, const bool clear)
+    {
+        return static_cast<uint8_t>(false) << 7 /* must be unset                             */
+             | static_cast<uint8_t>(false) << 6 /* must be unset                             */
+             | (green & 0x03)              << 4 /* green brightness                          */
+             | static_cast<uint8_t>(clear) << 3 /* clear the other buffer's copy of this led */
+             | static_cast<uint8_t>(copy)  << 2 /* write this led data to both buffers       */
+             | (red & 0x03)                << 0 /* red brightness                            */
+             ;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ColorTable
+//
+// Every velocity byte of a device, indexed by red level, green level and
+// flags, so that encoding a color is two shifts and a single table load.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+template <typename Encoding>
+class ColorTable
+{
+public: // public interface
+    constexpr ColorTable()
+        : _bytes()
+    {
+        for(unsigned index = 0; index < SIZE; ++index) {
+            const unsigned red   = (index / 1)                % LEVELS;
+            const unsigned green = (index / LEVELS)           % LEVELS;
+            const unsigned flags = (index / (LEVELS * LEVELS));
+            _bytes[index] = Encoding::encode(red, green, (flags & 1) != 0, (flags & 2) != 0);
+        }
+    }
+
+    constexpr uint8_t operator()(const Color& color, const bool copy = false, const bool clear = false) const
+    {
+        return _bytes[ (static_cast<unsigned>(copy)  * 1 + static_cast<unsigned>(clear) * 2) * LEVELS * LEVELS
+                     + Encoding::level(color.green) * LEVELS
+                     + Encoding::level(color.red) ];
+    }
+
+public: // public static data
+    static constexpr unsigned LEVELS = Encoding::LEVELS;
+    static constexpr unsigned SIZE   = LEVELS * LEVELS * 4;
+
+private: // private data
+    uint8_t _bytes[SIZE];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Palette
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+template <typename Encoding, size_t N>
+class Palette
+{
+public: // public interface
+    constexpr Palette(const Color (&colors)[N])
+        : _colors()
+        , _bytes()
+    {
+        for(size_t index = 0; index < N; ++index) {
+            set(index, colors[index]);
+        }
+    }
+
+    constexpr uint8_t operator[](const size_t index) const
+    {
+        return _bytes[index];
+    }
+
+    constexpr const Color& color(const size_t index) const
+    {
+        return _colors[index];
+    }
+
+    constexpr size_t size() const
+    {
+        return N;
+    }
+
+protected: // protected interface
+    constexpr Palette()
+        : _colors()
+        , _bytes()
+    {
+    }
+
+    constexpr void set(const size_t index, const Color& color)
+    {
+        _colors[index] = color;
+        _bytes[index]  = ColorTable<Encoding>()(color);
+    }
+
+private: // private data
+    Color   _colors[N];
+    uint8_t _bytes[N];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Gradient
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+template <typename Encoding, size_t N>
+class Gradient
+    : public Palette<Encoding, N>
+{
+public: // public interface
+    constexpr Gradient(const Color& from, const Color& to)
+        : Palette<Encoding, N>()
+    {
+        for(size_t index = 0; index < N; ++index) {
+            this->set(index, from.mix(to, (N > 1 ? (index * 255) / (N - 1) : 0)));
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Palettes
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+template <typename Encoding>
+struct Palettes
+{
+    static constexpr ColorTable<Encoding> TABLE = ColorTable<Encoding>();
+
+    static constexpr Palette<Encoding, 6> MATRIX = Palette<Encoding, 6>({
+        Colors::BLACK,
+        Color(0x00, 0x55),
+        Color(0x00, 0xaa),
+        Colors::GREEN,
+        Colors::AMBER,
+        Colors::RED,
+    });
+
+    static constexpr Palette<Encoding, 5> LIFE = Palette<Encoding, 5>({
+        Colors::BLACK,
+        Color(0x40, 0x00),
+        Colors::RED,
+        Colors::AMBER,
+        Colors::GREEN,
+    });
+
+    static constexpr Gradient<Encoding, 4> RED_RAMP   = Gradient<Encoding, 4>(Colors::BLACK, Colors::RED);
+    static constexpr Gradient<Encoding, 4> GREEN_RAMP = Gradient<Encoding, 4>(Colors::BLACK, Colors::GREEN);
+    static constexpr Gradient<Encoding, 4> AMBER_RAMP = Gradient<Encoding, 4>(Colors::BLACK, Colors::AMBER);
+    static constexpr Gradient<Encoding, 4> FIRE       = Gradient<Encoding, 4>(Colors::RED, Colors::AMBER);
+};
+
+template <typename Encoding>
+constexpr ColorTable<Encoding> Palettes<Encoding>::TABLE;
+
+template <typename Encoding>
+constexpr Palette<Encoding, 6> Palettes<Encoding>::MATRIX;
+
+template <typename Encoding>
+constexpr Palette<Encoding, 5> Palettes<Encoding>::LIFE;
+
+template <typename Encoding>
+constexpr Gradient<Encoding, 4> Palettes<Encoding>::RED_RAMP;
+
+template <typename Encoding>
+constexpr Gradient<Encoding, 4> Palettes<Encoding>::GREEN_RAMP;
+
+template <typename Encoding>
+constexpr Gradient<Encoding, 4> Palettes<Encoding>::AMBER_RAMP;
+
+template <typename Encoding>
+constexpr Gradient<Encoding, 4> Palettes<Encoding>::FIRE;
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Color_h__ */
@@ -0,0 +1,244 @@
+/*
+ * Frame.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include "Frame.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::lp
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct lp
+{
+    static constexpr uint8_t BUFFER0  = 0;
+    static constexpr uint8_t BUFFER1  = 1;
+    static constexpr bool    NO_FLASH = false;
+    static constexpr bool    DO_COPY  = true;
+    static constexpr bool    NO_COPY  = false;
+
+    /* an echo is posted as a flagged color, zero meaning none */
+    static constexpr uint16_t ECHO = 0x100;
+
+    static uint64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Frame
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+void Frame::fill(const uint8_t color)
+{
+    ::memset(data, color, sizeof(data));
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Renderer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+Renderer::Renderer(Launchpad& launchpad)
+    : LaunchpadDecorator(launchpad)
+{
+}
+
+Renderer::~Renderer()
+{
+}
+
+void Renderer::render(const Frame& frame)
+{
+    _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER1, lp::NO_FLASH, lp::NO_COPY);
+    for(uint8_t row = 0; row < Frame::ROWS; ++row) {
+        for(uint8_t col = 0; col < Frame::COLS; ++col) {
+            _launchpad.setPad(row, col, frame.data[row][col]);
+        }
+    }
+    _launchpad.setBuffer(lp::BUFFER1, lp::BUFFER0, lp::NO_FLASH, lp::DO_COPY);
+    _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER0, lp::NO_FLASH, lp::NO_COPY);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::EchoRenderer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+EchoRenderer::EchoRenderer(Launchpad& launchpad)
+    : Renderer(launchpad)
+    , _mutex()
+    , _immediate(true)
+    , _measured(false)
+    , _rendering(false)
+    , _pending(0)
+    , _colors()
+    , _presses()
+    , _echoed()
+    , _held()
+    , _echoes(0)
+    , _latency()
+{
+    for(unsigned pad = 0; pad < PADS; ++pad) {
+        _colors[pad].store(0);
+        _presses[pad].store(0);
+    }
+}
+
+EchoRenderer::~EchoRenderer()
+{
+}
+
+void EchoRenderer::render(const Frame& frame)
+{
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        const uint64_t                    start = (_measured && (_immediate == false) ? lp::now() : 0);
+
+        _rendering = true;
+        _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER1, lp::NO_FLASH, lp::NO_COPY);
+        for(unsigned pad = 0; pad < PADS; ++pad) {
+            if(_pending.load() != 0) {
+                flush(pad);
+            }
+            const uint8_t row = pad / Frame::COLS;
+            const uint8_t col = pad % Frame::COLS;
+            _launchpad.setPad(row, col, (_held[pad] != 0 ? _echoed[pad] : frame.data[row][col]));
+            if(start != 0) {
+                record(pad, lp::now(), start);
+            }
+        }
+        _launchpad.setBuffer(lp::BUFFER1, lp::BUFFER0, lp::NO_FLASH, lp::DO_COPY);
+        _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER0, lp::NO_FLASH, lp::NO_COPY);
+        _rendering = false;
+        for(unsigned pad = 0; pad < PADS; ++pad) {
+            if(_held[pad] != 0) {
+                --_held[pad];
+            }
+        }
+    }
+    /* an echo posted while the last pads were sent was left to us */
+    drain();
+}
+
+void EchoRenderer::echo(const uint8_t row, const uint8_t col, const uint8_t color)
+{
+    if((row >= Frame::ROWS) || (col >= Frame::COLS)) {
+        return;
+    }
+    const unsigned pad = (row * Frame::COLS) + col;
+    if(_measured) {
+        uint64_t none = 0;
+        static_cast<void>(_presses[pad].compare_exchange_strong(none, lp::now()));
+    }
+    if(_immediate) {
+        _colors[pad].store(lp::ECHO | color);
+        _pending.fetch_add(1);
+        drain();
+    }
+}
+
+void EchoRenderer::setMeasured(const bool measured)
+{
+    if(measured && !_latency) {
+        _latency.reset(new JitterMeter(LATENCY_BUCKETS));
+    }
+    _measured = measured;
+}
+
+void EchoRenderer::drain()
+{
+    while(_pending.load() != 0) {
+        std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+        if(lock.owns_lock() == false) {
+            /* a frame is being sent, it will flush the echo between two pads */
+            return;
+        }
+        flush(PADS);
+    }
+}
+
+void EchoRenderer::flush(const unsigned position)
+{
+    static_cast<void>(_pending.exchange(0));
+    for(unsigned pad = 0; pad < PADS; ++pad) {
+        const uint16_t posted = _colors[pad].exchange(0);
+        if(posted == 0) {
+            continue;
+        }
+        const uint8_t row   = pad / Frame::COLS;
+        const uint8_t col   = pad % Frame::COLS;
+        const uint8_t color = static_cast<uint8_t>(posted & 0xff);
+        if(_rendering) {
+            /* the visible buffer first, then the back buffer if the pad was already sent */
+            _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER0, lp::NO_FLASH, lp::NO_COPY);
+            _launchpad.setPad(row, col, color);
+            _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER1, lp::NO_FLASH, lp::NO_COPY);
+            if(pad < position) {
+                _launchpad.setPad(row, col, color);
+            }
+        }
+        else {
+            _launchpad.setPad(row, col, color);
+        }
+        if(_measured) {
+            record(pad, lp::now(), UINT64_MAX);
+        }
+        /* the current frame, if any, and the next one may predate the press */
+        _echoed[pad] = color;
+        _held[pad]   = (_rendering ? 2 : 1);
+        ++_echoes;
+    }
+}
+
+void EchoRenderer::record(const unsigned pad, const uint64_t time, const uint64_t limit)
+{
+    uint64_t press = _presses[pad].load();
+
+    if((press != 0) && (press <= limit) && _presses[pad].compare_exchange_strong(press, 0)) {
+        _latency->record(time > press ? time - press : 0);
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
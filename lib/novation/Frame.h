@@ -0,0 +1,172 @@
+/*
+ * Frame.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Frame_h__
+#define __NOVATION_Frame_h__
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <novation/Launchpad.h>
+#include <novation/Jitter.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Frame;
+class Renderer;
+class EchoRenderer;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Frame
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Frame
+{
+    static constexpr uint8_t ROWS = 8;
+    static constexpr uint8_t COLS = 8;
+
+    void fill(const uint8_t color);
+
+    uint8_t& get(const uint8_t row, const uint8_t col)
+    {
+        return data[row % ROWS][col % COLS];
+    }
+
+    const uint8_t& get(const uint8_t row, const uint8_t col) const
+    {
+        return data[row % ROWS][col % COLS];
+    }
+
+    uint8_t data[ROWS][COLS];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Renderer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class Renderer
+    : public LaunchpadDecorator
+{
+public: // public interface
+    Renderer(Launchpad& launchpad);
+
+    virtual ~Renderer();
+
+    virtual void render(const Frame& frame);
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::EchoRenderer
+//
+// A renderer giving an immediate feedback to the pads pressed: the input
+// thread calls echo(), which lights the pad at once, without waiting for the
+// next frame, while the model catches up on its next tick. Every message to
+// the device goes through one mutex. When a frame is being sent, the input
+// thread only posts the echo and the frame sends it between two pads, both
+// to the visible and to the back buffer. An echoed pad keeps its color until
+// a frame computed after the press has been sent.
+//
+// The latency from the press to the message lighting the pad can be measured.
+// Without the immediate echo, a press is measured when the first frame begun
+// after it sends the pad. The histogram is only allocated once measured.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class EchoRenderer final
+    : public Renderer
+{
+public: // public interface
+    EchoRenderer(Launchpad& launchpad);
+
+    virtual ~EchoRenderer();
+
+    virtual void render(const Frame& frame) override;
+
+    void echo(const uint8_t row, const uint8_t col, const uint8_t color);
+
+    void setImmediate(const bool immediate)
+    {
+        _immediate = immediate;
+    }
+
+    void setMeasured(const bool measured);
+
+    bool measured() const
+    {
+        return _measured;
+    }
+
+    uint64_t echoes() const
+    {
+        return _echoes;
+    }
+
+    const JitterMeter& latency() const
+    {
+        return *_latency;
+    }
+
+public: // public static data
+    static constexpr unsigned PADS            = Frame::ROWS * Frame::COLS;
+    static constexpr unsigned LATENCY_BUCKETS = 500000;
+
+private: // private interface
+    void drain();
+
+    void flush(const unsigned position);
+
+    void record(const unsigned pad, const uint64_t time, const uint64_t limit);
+
+private: // private data
+    std::mutex                   _mutex;
+    bool                         _immediate;
+    bool                         _measured;
+    bool                         _rendering;
+    std::atomic<unsigned>        _pending;
+    std::atomic<uint16_t>        _colors[PADS];
+    std::atomic<uint64_t>        _presses[PADS];
+    uint8_t                      _echoed[PADS];
+    uint8_t                      _held[PADS];
+    uint64_t                     _echoes;
+    std::unique_ptr<JitterMeter> _latency;
+
+private: // disable copy and assignment
+    EchoRenderer(const EchoRenderer&) = delete;
+    EchoRenderer& operator=(const EchoRenderer&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Frame_h__ */
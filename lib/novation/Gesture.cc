@@ -0,0 +1,357 @@
+/*
+ * Gesture.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "Gesture.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::gr
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct gr
+{
+    using clock = std::chrono::steady_clock;
+
+    static constexpr unsigned COLS = novation::Frame::COLS;
+
+    static unsigned count(const uint64_t pads)
+    {
+        return __builtin_popcountll(pads);
+    }
+
+    static unsigned first(const uint64_t pads)
+    {
+        return __builtin_ctzll(pads);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::GestureListener
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+void GestureListener::onGesture(const Gesture& gesture)
+{
+    static_cast<void>(gesture);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::GestureRecognizer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+GestureRecognizer::GestureRecognizer(GestureListener& listener, const GestureTiming& timing)
+    : _listener(listener)
+    , _timing(timing)
+    , _pads()
+    , _deadlines()
+    , _down(0)
+    , _consumed(0)
+    , _chord(0)
+    , _chordStart(0)
+    , _chordDeadline(NEVER)
+    , _swipe(0)
+    , _swipeFirst(0)
+    , _swipeLast(0)
+    , _swipeLength(0)
+    , _swipeDx(0)
+    , _swipeDy(0)
+    , _swipeStart(0)
+    , _swipeDeadline(NEVER)
+{
+}
+
+GestureRecognizer::~GestureRecognizer()
+{
+}
+
+void GestureRecognizer::input(const uint8_t row, const uint8_t col, const uint8_t velocity, const uint64_t time)
+{
+    if((row >= Frame::ROWS) || (col >= Frame::COLS)) {
+        return;
+    }
+    /* the deadlines reached by the event are handled first, in case the update is late */
+    expire(time);
+    if(velocity != 0) {
+        press(((row * gr::COLS) + col), time);
+    }
+    else {
+        release(((row * gr::COLS) + col), time);
+    }
+}
+
+void GestureRecognizer::update(const uint64_t time)
+{
+    expire(time);
+}
+
+uint64_t GestureRecognizer::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(gr::clock::now().time_since_epoch()).count();
+}
+
+void GestureRecognizer::press(const unsigned pad, const uint64_t time)
+{
+    Pad& state(_pads[pad]);
+
+    switch(state.state) {
+        case PadState::kDOWN:
+            return;
+        case PadState::kBOUNCING:
+            /* the release was a bounce, the press goes on with the deadline queued on the first press */
+            state.state    = PadState::kDOWN;
+            state.deadline = ((state.held || (_timing.hold == 0)) ? NEVER : state.pressed + _timing.hold);
+            if(state.deadline <= time) {
+                timeout(pad, time);
+            }
+            return;
+        case PadState::kTAPPED:
+            if((_consumed & bit(pad)) == 0) {
+                emit(GestureType::kDOUBLE_TAP, pad, bit(pad), state.pressed, time);
+                /* the second press gives nothing else */
+                state.state    = PadState::kDOWN;
+                state.held     = false;
+                state.pressed  = time;
+                state.deadline = NEVER;
+                _down         |= bit(pad);
+                _consumed     |= bit(pad);
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    state.state    = PadState::kDOWN;
+    state.held     = false;
+    state.pressed  = time;
+    state.deadline = NEVER;
+    _down         |= bit(pad);
+    _consumed     &= ~bit(pad);
+    if(_timing.hold != 0) {
+        schedule(kHOLD_TIMER, pad, time + _timing.hold);
+    }
+    if(_timing.chord != 0) {
+        if(_chord == 0) {
+            _chordStart    = time;
+            _chordDeadline = time + _timing.chord;
+        }
+        _chord |= bit(pad);
+    }
+    if(_timing.swipe != 0) {
+        extend(pad, time);
+    }
+}
+
+void GestureRecognizer::release(const unsigned pad, const uint64_t time)
+{
+    Pad& state(_pads[pad]);
+
+    if(state.state != PadState::kDOWN) {
+        return;
+    }
+    state.released = time;
+    if(_timing.debounce != 0) {
+        state.state = PadState::kBOUNCING;
+        schedule(kDEBOUNCE_TIMER, pad, time + _timing.debounce);
+    }
+    else {
+        settle(pad, time);
+    }
+}
+
+void GestureRecognizer::settle(const unsigned pad, const uint64_t time)
+{
+    Pad& state(_pads[pad]);
+
+    _down &= ~bit(pad);
+    if((state.held == false) && ((_consumed & bit(pad)) == 0) && (_timing.tap != 0) && ((state.released - state.pressed) <= _timing.tap)) {
+        if(_timing.doubleTap != 0) {
+            state.state = PadState::kTAPPED;
+            schedule(kDOUBLE_TAP_TIMER, pad, state.released + _timing.doubleTap);
+            return;
+        }
+        emit(GestureType::kTAP, pad, bit(pad), state.pressed, time);
+    }
+    state.state    = PadState::kIDLE;
+    state.deadline = NEVER;
+    _consumed     &= ~bit(pad);
+}
+
+void GestureRecognizer::schedule(const Timer timer, const unsigned pad, const uint64_t deadline)
+{
+    Deadlines& queue(_deadlines[timer]);
+
+    /* only reachable with thousands of events per window, the oldest one is then handled early */
+    if(queue.count == DEADLINES) {
+        const Deadline oldest(queue.entries[queue.head]);
+        queue.head = (queue.head + 1) % DEADLINES;
+        --queue.count;
+        if(_pads[oldest.pad].deadline == oldest.time) {
+            timeout(oldest.pad, oldest.time);
+        }
+    }
+    _pads[pad].deadline = deadline;
+    queue.entries[(queue.head + queue.count) % DEADLINES] = Deadline { pad, deadline };
+    ++queue.count;
+}
+
+void GestureRecognizer::expire(const uint64_t time)
+{
+    if(_swipeDeadline <= time) {
+        finish(time);
+    }
+    if(_chordDeadline <= time) {
+        close(time);
+    }
+    /* each queue is sorted, a deadline that was replaced since is skipped */
+    for(auto& queue : _deadlines) {
+        while((queue.count != 0) && (queue.entries[queue.head].time <= time)) {
+            const Deadline due(queue.entries[queue.head]);
+            queue.head = (queue.head + 1) % DEADLINES;
+            --queue.count;
+            if(_pads[due.pad].deadline == due.time) {
+                timeout(due.pad, time);
+            }
+        }
+    }
+}
+
+void GestureRecognizer::timeout(const unsigned pad, const uint64_t time)
+{
+    Pad& state(_pads[pad]);
+
+    if((state.state != PadState::kBOUNCING) && ((_swipe & bit(pad)) != 0) && (_swipeLength >= 2)) {
+        /* a tap or a hold may still be part of a swipe, which is decided first */
+        schedule(kSWIPE_TIMER, pad, _swipeDeadline);
+        return;
+    }
+    state.deadline = NEVER;
+    switch(state.state) {
+        case PadState::kDOWN:
+            if((_consumed & bit(pad)) == 0) {
+                emit(GestureType::kHOLD, pad, bit(pad), state.pressed, time);
+                state.held = true;
+            }
+            break;
+        case PadState::kBOUNCING:
+            settle(pad, time);
+            break;
+        case PadState::kTAPPED:
+            if((_consumed & bit(pad)) == 0) {
+                emit(GestureType::kTAP, pad, bit(pad), state.pressed, time);
+            }
+            state.state = PadState::kIDLE;
+            _consumed  &= ~bit(pad);
+            break;
+        default:
+            break;
+    }
+}
+
+void GestureRecognizer::extend(const unsigned pad, const uint64_t time)
+{
+    if(_swipeLength != 0) {
+        const int  dx       = static_cast<int>(pad % gr::COLS) - static_cast<int>(_swipeLast % gr::COLS);
+        const int  dy       = static_cast<int>(pad / gr::COLS) - static_cast<int>(_swipeLast / gr::COLS);
+        const bool adjacent = (dx >= -1) && (dx <= 1) && (dy >= -1) && (dy <= 1) && ((_swipe & bit(pad)) == 0);
+        const bool straight = (_swipeLength == 1) || ((dx == _swipeDx) && (dy == _swipeDy));
+        if(adjacent && straight) {
+            _swipe        |= bit(pad);
+            _swipeLast     = pad;
+            _swipeDx       = dx;
+            _swipeDy       = dy;
+            _swipeDeadline = time + _timing.swipe;
+            ++_swipeLength;
+            return;
+        }
+        finish(time);
+    }
+    _swipe         = bit(pad);
+    _swipeFirst    = pad;
+    _swipeLast     = pad;
+    _swipeLength   = 1;
+    _swipeDx       = 0;
+    _swipeDy       = 0;
+    _swipeStart    = time;
+    _swipeDeadline = time + _timing.swipe;
+}
+
+void GestureRecognizer::finish(const uint64_t time)
+{
+    if(_swipeLength >= _timing.length) {
+        emit(GestureType::kSWIPE, _swipeFirst, _swipe, _swipeStart, time);
+        _consumed |= _swipe;
+    }
+    _swipe         = 0;
+    _swipeLength   = 0;
+    _swipeDeadline = NEVER;
+}
+
+void GestureRecognizer::close(const uint64_t time)
+{
+    /* pads pressed in a row may still become a swipe, which is decided first */
+    if(((_chord & ~_swipe) == 0) && (_swipeLength >= 2)) {
+        _chordDeadline = _swipeDeadline;
+        return;
+    }
+    const uint64_t members = (_chord & _down & ~_consumed);
+    if(gr::count(members) >= 2) {
+        emit(GestureType::kCHORD, gr::first(members), members, _chordStart, time);
+        _consumed |= members;
+    }
+    _chord         = 0;
+    _chordDeadline = NEVER;
+}
+
+void GestureRecognizer::emit(const GestureType type, const unsigned pad, const uint64_t pads, const uint64_t start, const uint64_t time)
+{
+    Gesture gesture;
+    gesture.type     = type;
+    gesture.row      = pad / gr::COLS;
+    gesture.col      = pad % gr::COLS;
+    gesture.dx       = (type == GestureType::kSWIPE ? _swipeDx : 0);
+    gesture.dy       = (type == GestureType::kSWIPE ? _swipeDy : 0);
+    gesture.length   = gr::count(pads);
+    gesture.pads     = pads;
+    gesture.time     = start;
+    gesture.detected = time;
+    _listener.onGesture(gesture);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
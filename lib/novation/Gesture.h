@@ -0,0 +1,261 @@
+/*
+ * Gesture.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Gesture_h__
+#define __NOVATION_Gesture_h__
+
+#include <novation/Frame.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+enum class GestureType : uint8_t;
+struct Gesture;
+struct GestureTiming;
+class GestureListener;
+class GestureRecognizer;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::GestureType
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+enum class GestureType : uint8_t
+{
+    kTAP        = 0,
+    kDOUBLE_TAP = 1,
+    kHOLD       = 2,
+    kCHORD      = 3,
+    kSWIPE      = 4,
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Gesture
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Gesture
+{
+    GestureType type;     /* kind of gesture                                  */
+    uint8_t     row;      /* pad of a tap or a hold, first pad of a swipe     */
+    uint8_t     col;      /* pad of a tap or a hold, first pad of a swipe     */
+    int8_t      dx;       /* direction of a swipe, in columns                 */
+    int8_t      dy;       /* direction of a swipe, in rows                    */
+    uint8_t     length;   /* number of pads of a swipe or a chord             */
+    uint64_t    pads;     /* pads of a chord or a swipe, one bit per pad      */
+    uint64_t    time;     /* first press of the gesture, in microseconds      */
+    uint64_t    detected; /* time of the recognition, in microseconds         */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::GestureTiming
+//
+// The timing windows of the recognizer, in microseconds. A window set to 0
+// disables the matching gesture, except for the debounce.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct GestureTiming
+{
+    uint64_t debounce  = 10000;  /* a release shorter than this is a bounce   */
+    uint64_t tap       = 250000; /* longest press of a tap                    */
+    uint64_t doubleTap = 250000; /* longest wait for the second tap           */
+    uint64_t hold      = 500000; /* shortest press of a hold                  */
+    uint64_t chord     = 50000;  /* longest spread of the presses of a chord  */
+    uint64_t swipe     = 150000; /* longest wait between two pads of a swipe  */
+    unsigned length    = 3;      /* fewest pads of a swipe                    */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::GestureListener
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class GestureListener
+{
+public: // public interface
+    virtual void onGesture(const Gesture& gesture);
+
+protected: // protected interface
+    GestureListener() = default;
+
+    virtual ~GestureListener() = default;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::GestureRecognizer
+//
+// Turns the timestamped presses and releases of the grid into gestures with
+// a few state machines: one per pad for taps, double taps and holds, one for
+// the chord being formed and one for the swipe in progress, masks of 64 bits
+// standing for sets of pads.
+//
+// The gestures that depend on the absence of an event, such as a hold or a
+// single tap, are recognized when a deadline is reached by an event or by
+// update(). The deadlines of a pad are queued by timing window: since the
+// events come in order, each queue is sorted by construction and only its
+// head is ever compared, so that an event or an update is processed in
+// amortized constant time, a deadline being queued and dequeued once.
+//
+// The detection latency is bounded by the windows and by the period of the
+// updates: a double tap is recognized on the second press, a hold after the
+// hold window, a tap one debounce and one double tap window after the
+// release, a chord one chord window after its first press (or when the swipe
+// its pads may start is over) and a swipe one swipe window after its last
+// pad. A release followed by a press of the same pad within the debounce
+// window is ignored as a bounce.
+//
+// The pads of a chord or a swipe give no tap nor hold: the taps and holds
+// of the pads of a swipe in progress wait for the end of the swipe. The
+// recognizer is not thread-safe: it is meant to be fed and updated by the
+// frame thread. The listener is called from input() or update() and must
+// not feed it back.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class GestureRecognizer
+{
+public: // public interface
+    GestureRecognizer(GestureListener& listener, const GestureTiming& timing = GestureTiming());
+
+    virtual ~GestureRecognizer();
+
+    void input(const uint8_t row, const uint8_t col, const uint8_t velocity, const uint64_t time);
+
+    void update(const uint64_t time);
+
+    static uint64_t now();
+
+public: // public static data
+    static constexpr unsigned PADS      = Frame::ROWS * Frame::COLS;
+    static constexpr unsigned DEADLINES = 256;
+
+private: // private interface
+    enum class PadState : uint8_t
+    {
+        kIDLE     = 0,
+        kDOWN     = 1,
+        kBOUNCING = 2,
+        kTAPPED   = 3,
+    };
+
+    struct Pad
+    {
+        PadState state    = PadState::kIDLE;
+        bool     held     = false;
+        uint64_t pressed  = 0;
+        uint64_t released = 0;
+        uint64_t deadline = NEVER;
+    };
+
+    enum Timer : unsigned
+    {
+        kHOLD_TIMER       = 0,
+        kDEBOUNCE_TIMER   = 1,
+        kDOUBLE_TAP_TIMER = 2,
+        kSWIPE_TIMER      = 3,
+        kTIMERS           = 4,
+    };
+
+    struct Deadline
+    {
+        unsigned pad  = 0;
+        uint64_t time = 0;
+    };
+
+    struct Deadlines
+    {
+        Deadline entries[DEADLINES];
+        unsigned head  = 0;
+        unsigned count = 0;
+    };
+
+    static constexpr uint64_t NEVER = UINT64_MAX;
+
+    static uint64_t bit(const unsigned pad)
+    {
+        return 1ULL << pad;
+    }
+
+    void press(const unsigned pad, const uint64_t time);
+
+    void release(const unsigned pad, const uint64_t time);
+
+    void settle(const unsigned pad, const uint64_t time);
+
+    void schedule(const Timer timer, const unsigned pad, const uint64_t deadline);
+
+    void expire(const uint64_t time);
+
+    void timeout(const unsigned pad, const uint64_t time);
+
+    void extend(const unsigned pad, const uint64_t time);
+
+    void finish(const uint64_t time);
+
+    void close(const uint64_t time);
+
+    void emit(const GestureType type, const unsigned pad, const uint64_t pads, const uint64_t start, const uint64_t time);
+
+private: // private data
+    GestureListener&        _listener;
+    const GestureTiming     _timing;
+    Pad                     _pads[PADS];
+    Deadlines               _deadlines[kTIMERS];
+    uint64_t                _down;
+    uint64_t                _consumed;
+    uint64_t                _chord;
+    uint64_t                _chordStart;
+    uint64_t                _chordDeadline;
+    uint64_t                _swipe;
+    unsigned                _swipeFirst;
+    unsigned                _swipeLast;
+    unsigned                _swipeLength;
+    int                     _swipeDx;
+    int                     _swipeDy;
+    uint64_t                _swipeStart;
+    uint64_t                _swipeDeadline;
+
+private: // disable copy and assignment
+    GestureRecognizer(const GestureRecognizer&) = delete;
+    GestureRecognizer& operator=(const GestureRecognizer&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Gesture_h__ */
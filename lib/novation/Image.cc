@@ -0,0 +1,471 @@
+/*
+ * Image.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <base/MappedFile.h>
+#include "Image.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::img
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct img
+{
+    static constexpr int STEP = 255 / (novation::ImageQuantizer::LEVELS - 1);
+
+    static void invalid(const std::string& path, const std::string& reason)
+    {
+        throw std::runtime_error(std::string("invalid image") + ' ' + '<' + path + '>' + ':' + ' ' + reason);
+    }
+
+    static int clamp(const int value)
+    {
+        return (value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+
+    static int luma(const int red, const int green, const int blue)
+    {
+        return (77 * red + 150 * green + 29 * blue) >> 8;
+    }
+
+    static uint16_t get16be(const uint8_t* data)
+    {
+        return static_cast<uint16_t>(data[0]) << 8
+             | static_cast<uint16_t>(data[1])
+             ;
+    }
+
+    static uint32_t get32be(const uint8_t* data)
+    {
+        return static_cast<uint32_t>(get16be(data + 0)) << 16
+             | static_cast<uint32_t>(get16be(data + 2))
+             ;
+    }
+
+    static void resize(const std::string& path, novation::Image& image, const uint32_t width, const uint32_t height)
+    {
+        if((width == 0) || (width > novation::Image::MAX_WIDTH) || (height == 0) || (height > novation::Image::MAX_HEIGHT)) {
+            invalid(path, "unsupported dimensions");
+        }
+        image.width  = width;
+        image.height = height;
+        image.pixels.resize(static_cast<size_t>(width) * height * novation::Image::CHANNELS);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::netpbm
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct netpbm
+{
+    static bool is(const uint8_t* data, const size_t size)
+    {
+        return (size >= 2) && (data[0] == 'P') && ((data[1] == '5') || (data[1] == '6'));
+    }
+
+    static uint32_t token(const std::string& path, const uint8_t*& data, const uint8_t* end)
+    {
+        while(data < end) {
+            if(*data == '#') {
+                while((data < end) && (*data != '\n')) {
+                    ++data;
+                }
+            }
+            else if(::isspace(*data)) {
+                ++data;
+            }
+            else {
+                break;
+            }
+        }
+        uint32_t value  = 0;
+        int      digits = 0;
+        while((data < end) && (*data >= '0') && (*data <= '9') && (digits < 9)) {
+            value = (value * 10) + (*data++ - '0');
+            ++digits;
+        }
+        if((digits == 0) || (data >= end) || (::isspace(*data) == 0)) {
+            img::invalid(path, "bad header");
+        }
+        return value;
+    }
+
+    static void decode(const std::string& path, const uint8_t* data, const size_t size, novation::Image& image)
+    {
+        const uint8_t* end      = data + size;
+        const uint32_t channels = (data[1] == '6' ? 3 : 1);
+        const uint8_t* cursor   = data + 2;
+        const uint32_t width    = token(path, cursor, end);
+        const uint32_t height   = token(path, cursor, end);
+        const uint32_t maxval   = token(path, cursor, end);
+        const uint32_t bytes    = (maxval > 255 ? 2 : 1);
+
+        if((maxval == 0) || (maxval > 65535)) {
+            img::invalid(path, "bad maximum value");
+        }
+        img::resize(path, image, width, height);
+        ++cursor;
+
+        const size_t samples = static_cast<size_t>(width) * height * channels;
+        if(static_cast<size_t>(end - cursor) < (samples * bytes)) {
+            img::invalid(path, "truncated pixels");
+        }
+        uint8_t* pixels = image.pixels.data();
+        for(size_t index = 0; index < (static_cast<size_t>(width) * height); ++index) {
+            uint8_t rgb[3];
+            for(uint32_t channel = 0; channel < channels; ++channel) {
+                const uint32_t sample = (bytes == 2 ? img::get16be(cursor) : *cursor);
+                rgb[channel] = static_cast<uint8_t>((std::min(sample, maxval) * 255 + (maxval / 2)) / maxval);
+                cursor += bytes;
+            }
+            *pixels++ = rgb[0];
+            *pixels++ = rgb[channels == 3 ? 1 : 0];
+            *pixels++ = rgb[channels == 3 ? 2 : 0];
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::farbfeld
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct farbfeld
+{
+    static constexpr size_t HEADER_SIZE = 16;
+
+    static bool is(const uint8_t* data, const size_t size)
+    {
+        return (size >= HEADER_SIZE) && (::memcmp(data, "farbfeld", 8) == 0);
+    }
+
+    static void decode(const std::string& path, const uint8_t* data, const size_t size, novation::Image& image)
+    {
+        const uint32_t width  = img::get32be(data +  8);
+        const uint32_t height = img::get32be(data + 12);
+
+        img::resize(path, image, width, height);
+
+        const size_t   count  = static_cast<size_t>(width) * height;
+        const uint8_t* cursor = data + HEADER_SIZE;
+        if((size - HEADER_SIZE) < (count * 8)) {
+            img::invalid(path, "truncated pixels");
+        }
+        uint8_t* pixels = image.pixels.data();
+        for(size_t index = 0; index < count; ++index) {
+            const uint32_t alpha = img::get16be(cursor + 6);
+            for(int channel = 0; channel < 3; ++channel) {
+                const uint32_t sample = img::get16be(cursor + channel * 2);
+                *pixels++ = static_cast<uint8_t>(((static_cast<uint64_t>(sample) * alpha) / 65535) >> 8);
+            }
+            cursor += 8;
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ImageDecoder
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+void ImageDecoder::decode(const std::string& path, Image& image)
+{
+    const base::MappedFile file(path);
+    const uint8_t*         data = file.data();
+    const size_t           size = file.size();
+
+    if(netpbm::is(data, size)) {
+        netpbm::decode(path, data, size, image);
+    }
+    else if(farbfeld::is(data, size)) {
+        farbfeld::decode(path, data, size, image);
+    }
+    else {
+        img::invalid(path, "unsupported format (PPM, PGM or farbfeld expected)");
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ImageScaler
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+void ImageScaler::scale(const Image& source, Image& target, const uint32_t width, const uint32_t height)
+{
+    constexpr uint32_t channels = Image::CHANNELS;
+    const uint32_t     stride   = source.width * channels;
+
+    auto lower = [](const uint32_t index, const uint32_t source, const uint32_t target) -> uint32_t
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(index) * source) / target);
+    };
+
+    auto upper = [&](const uint32_t index, const uint32_t source, const uint32_t target) -> uint32_t
+    {
+        return std::max(lower(index + 1, source, target), lower(index, source, target) + 1);
+    };
+
+    target.width  = width;
+    target.height = height;
+    target.pixels.resize(static_cast<size_t>(width) * height * channels);
+
+    std::vector<uint32_t> sums(stride);
+    uint8_t*              output = target.pixels.data();
+    for(uint32_t row = 0; row < height; ++row) {
+        const uint32_t y0 = lower(row, source.height, height);
+        const uint32_t y1 = upper(row, source.height, height);
+        /* sum the band of source rows, the loop is straight and vectorizable */ {
+            uint32_t* acc = sums.data();
+            std::fill(sums.begin(), sums.end(), 0);
+            for(uint32_t y = y0; y < y1; ++y) {
+                const uint8_t* src = &source.pixels[static_cast<size_t>(y) * stride];
+                for(uint32_t x = 0; x < stride; ++x) {
+                    acc[x] += src[x];
+                }
+            }
+        }
+        /* average each box of the band */ {
+            for(uint32_t col = 0; col < width; ++col) {
+                const uint32_t x0    = lower(col, source.width, width);
+                const uint32_t x1    = upper(col, source.width, width);
+                const uint32_t count = (y1 - y0) * (x1 - x0);
+                uint32_t       rgb[channels] = { 0, 0, 0 };
+                for(uint32_t x = x0; x < x1; ++x) {
+                    rgb[0] += sums[x * channels + 0];
+                    rgb[1] += sums[x * channels + 1];
+                    rgb[2] += sums[x * channels + 2];
+                }
+                *output++ = static_cast<uint8_t>((rgb[0] + count / 2) / count);
+                *output++ = static_cast<uint8_t>((rgb[1] + count / 2) / count);
+                *output++ = static_cast<uint8_t>((rgb[2] + count / 2) / count);
+            }
+        }
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ImageQuantizer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+ImageQuantizer::ImageQuantizer(Launchpad& launchpad)
+    : _colors()
+    , _lut()
+{
+    constexpr int bits = LUT_BITS;
+    constexpr int half = 1 << (8 - bits - 1);
+
+    for(int index = 0; index < COLORS; ++index) {
+        _colors[index] = launchpad.makeColor((index / LEVELS) * img::STEP, (index % LEVELS) * img::STEP);
+    }
+    for(int cell = 0; cell < LUT_SIZE; ++cell) {
+        const int red   = (((cell >> (2 * bits)) & ((1 << bits) - 1)) << (8 - bits)) + half;
+        const int green = (((cell >> (1 * bits)) & ((1 << bits) - 1)) << (8 - bits)) + half;
+        const int blue  = (((cell >> (0 * bits)) & ((1 << bits) - 1)) << (8 - bits)) + half;
+        const int luma  = img::luma(red, green, blue);
+        int       best  = 0;
+        int       dmin  = INT32_MAX;
+        for(int index = 0; index < COLORS; ++index) {
+            const int r = (index / LEVELS) * img::STEP;
+            const int g = (index % LEVELS) * img::STEP;
+            const int dr = red - r;
+            const int dg = green - g;
+            const int dy = luma - img::luma(r, g, 0);
+            const int dist = 2 * dr * dr + 2 * dg * dg + dy * dy;
+            if(dist < dmin) {
+                dmin = dist;
+                best = index;
+            }
+        }
+        _lut[cell] = best;
+    }
+}
+
+ImageQuantizer::~ImageQuantizer()
+{
+}
+
+uint8_t ImageQuantizer::lookup(const int red, const int green, const int blue) const
+{
+    constexpr int bits  = LUT_BITS;
+    constexpr int shift = 8 - bits;
+
+    return _lut[((red >> shift) << (2 * bits)) | ((green >> shift) << bits) | (blue >> shift)];
+}
+
+void ImageQuantizer::quantize(const Image& image, const Dither dither, uint8_t* colors) const
+{
+    static const int bayer[4][4] = {
+        {  0,  8,  2, 10 },
+        { 12,  4, 14,  6 },
+        {  3, 11,  1,  9 },
+        { 15,  7, 13,  5 },
+    };
+    const uint32_t width  = image.width;
+    const uint32_t height = image.height;
+    const uint8_t* pixels = image.pixels.data();
+
+    auto quantize_none = [&]() -> void
+    {
+        for(uint32_t index = 0; index < (width * height); ++index) {
+            const uint8_t* rgb = &pixels[index * Image::CHANNELS];
+            *colors++ = _colors[lookup(rgb[0], rgb[1], rgb[2])];
+        }
+    };
+
+    auto quantize_ordered = [&]() -> void
+    {
+        for(uint32_t y = 0; y < height; ++y) {
+            for(uint32_t x = 0; x < width; ++x) {
+                const uint8_t* rgb   = &pixels[(y * width + x) * Image::CHANNELS];
+                const int      bias  = ((2 * bayer[y & 3][x & 3] + 1) * img::STEP) / 32 - (img::STEP / 2);
+                const int      red   = img::clamp(rgb[0] + bias);
+                const int      green = img::clamp(rgb[1] + bias);
+                *colors++ = _colors[lookup(red, green, rgb[2])];
+            }
+        }
+    };
+
+    auto quantize_floyd_steinberg = [&]() -> void
+    {
+        std::vector<int> errors(4 * (width + 2), 0);
+        int* curr_r = &errors[0 * (width + 2) + 1];
+        int* curr_g = &errors[1 * (width + 2) + 1];
+        int* next_r = &errors[2 * (width + 2) + 1];
+        int* next_g = &errors[3 * (width + 2) + 1];
+        for(uint32_t y = 0; y < height; ++y) {
+            for(int x = 0; x < static_cast<int>(width); ++x) {
+                const uint8_t* rgb   = &pixels[(y * width + x) * Image::CHANNELS];
+                const int      red   = img::clamp(rgb[0] + curr_r[x] / 16);
+                const int      green = img::clamp(rgb[1] + curr_g[x] / 16);
+                const uint8_t  index = lookup(red, green, rgb[2]);
+                const int      er    = red   - (index / LEVELS) * img::STEP;
+                const int      eg    = green - (index % LEVELS) * img::STEP;
+                curr_r[x + 1] += er * 7; next_r[x - 1] += er * 3; next_r[x] += er * 5; next_r[x + 1] += er * 1;
+                curr_g[x + 1] += eg * 7; next_g[x - 1] += eg * 3; next_g[x] += eg * 5; next_g[x + 1] += eg * 1;
+                *colors++ = _colors[index];
+            }
+            std::swap(curr_r, next_r);
+            std::swap(curr_g, next_g);
+            std::fill(next_r - 1, next_r + width + 1, 0);
+            std::fill(next_g - 1, next_g + width + 1, 0);
+        }
+    };
+
+    switch(dither) {
+        case Dither::kNONE:
+            quantize_none();
+            break;
+        case Dither::kORDERED:
+            quantize_ordered();
+            break;
+        case Dither::kFLOYD_STEINBERG:
+            quantize_floyd_steinberg();
+            break;
+        default:
+            break;
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ImageLoader
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+ImageLoader::ImageLoader(const ImageQuantizer& quantizer, const Dither dither)
+    : _quantizer(quantizer)
+    , _dither(dither)
+    , _future()
+{
+}
+
+ImageLoader::~ImageLoader()
+{
+    if(_future.valid()) {
+        _future.wait();
+    }
+}
+
+void ImageLoader::prefetch(const std::string& path)
+{
+    if(_future.valid()) {
+        _future.wait();
+    }
+    _future = std::async(std::launch::async, &ImageLoader::load, std::cref(_quantizer), _dither, path);
+}
+
+void ImageLoader::fetch(Frame& frame)
+{
+    if(_future.valid() == false) {
+        throw std::runtime_error("no image has been prefetched");
+    }
+    frame = _future.get();
+}
+
+Frame ImageLoader::load(const ImageQuantizer& quantizer, const Dither dither, const std::string& path)
+{
+    Image source;
+    Image target;
+    Frame frame;
+
+    ImageDecoder::decode(path, source);
+    ImageScaler::scale(source, target, Frame::COLS, Frame::ROWS);
+    quantizer.quantize(target, dither, &frame.data[0][0]);
+
+    return frame;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,163 @@
+/*
+ * Image.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Image_h__
+#define __NOVATION_Image_h__
+
+#include <future>
+#include <novation/Frame.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Image;
+struct ImageDecoder;
+struct ImageScaler;
+class ImageQuantizer;
+class ImageLoader;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Dither
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+enum class Dither : uint8_t
+{
+    kNONE            = 0,
+    kORDERED         = 1,
+    kFLOYD_STEINBERG = 2,
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Image
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Image
+{
+    static constexpr uint32_t CHANNELS   = 3;
+    static constexpr uint32_t MAX_WIDTH  = 16384;
+    static constexpr uint32_t MAX_HEIGHT = 16384;
+
+    uint32_t             width;
+    uint32_t             height;
+    std::vector<uint8_t> pixels; /* packed RGB, 8 bits per channel */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ImageDecoder
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct ImageDecoder
+{
+    static void decode(const std::string& path, Image& image);
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ImageScaler
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct ImageScaler
+{
+    static void scale(const Image& source, Image& target, const uint32_t width, const uint32_t height);
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ImageQuantizer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class ImageQuantizer
+{
+public: // public interface
+    ImageQuantizer(Launchpad& launchpad);
+
+    virtual ~ImageQuantizer();
+
+    void quantize(const Image& image, const Dither dither, uint8_t* colors) const;
+
+public: // public static data
+    static constexpr int LEVELS   = 4;
+    static constexpr int COLORS   = LEVELS * LEVELS;
+    static constexpr int LUT_BITS = 5;
+    static constexpr int LUT_SIZE = 1 << (3 * LUT_BITS);
+
+private: // private interface
+    uint8_t lookup(const int red, const int green, const int blue) const;
+
+private: // private data
+    uint8_t _colors[COLORS];
+    uint8_t _lut[LUT_SIZE];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ImageLoader
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class ImageLoader
+{
+public: // public interface
+    ImageLoader(const ImageQuantizer& quantizer, const Dither dither);
+
+    virtual ~ImageLoader();
+
+    void prefetch(const std::string& path);
+
+    void fetch(Frame& frame);
+
+    static Frame load(const ImageQuantizer& quantizer, const Dither dither, const std::string& path);
+
+private: // private data
+    const ImageQuantizer& _quantizer;
+    const Dither          _dither;
+    std::future<Frame>    _future;
+
+private: // disable copy and assignment
+    ImageLoader(const ImageLoader&) = delete;
+    ImageLoader& operator=(const ImageLoader&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Image_h__ */
@@ -0,0 +1,191 @@
+/*
+ * Input.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "Input.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::iq
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct iq
+{
+    static constexpr size_t MAXIMUM_CAPACITY = 65536;
+
+    static size_t mask(const size_t capacity)
+    {
+        size_t size = 2;
+        if((capacity == 0) || (capacity > MAXIMUM_CAPACITY)) {
+            throw std::runtime_error("invalid input queue capacity");
+        }
+        while(size < capacity) {
+            size <<= 1;
+        }
+        return size - 1;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::InputQueue
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+InputQueue::InputQueue(const size_t capacity)
+    : _mask(iq::mask(capacity))
+    , _slots(new Slot[_mask + 1])
+    , _head(0)
+    , _tail(0)
+    , _pushed(0)
+    , _overflows(0)
+    , _coalesced(0)
+    , _first()
+    , _last()
+{
+    for(size_t index = 0; index <= _mask; ++index) {
+        _slots[index].sequence.store(index, std::memory_order_relaxed);
+    }
+    for(unsigned index = 0; index < (2 * KEYS); ++index) {
+        _first[index] = NONE;
+        _last[index]  = NONE;
+    }
+}
+
+InputQueue::~InputQueue()
+{
+}
+
+bool InputQueue::push(const InputEvent& event)
+{
+    size_t position = _head.load(std::memory_order_relaxed);
+    Slot*  slot     = nullptr;
+
+    for(;;) {
+        slot = &_slots[position & _mask];
+        const size_t   sequence   = slot->sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if(difference == 0) {
+            if(_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if(difference < 0) {
+            /* the consumer has not freed the slot yet, the queue is full */
+            _overflows.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else {
+            position = _head.load(std::memory_order_relaxed);
+        }
+    }
+    slot->event = event;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    _pushed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool InputQueue::pop(InputEvent& event)
+{
+    Slot& slot(_slots[_tail & _mask]);
+
+    if(slot.sequence.load(std::memory_order_acquire) != (_tail + 1)) {
+        return false;
+    }
+    event = slot.event;
+    slot.sequence.store(_tail + _mask + 1, std::memory_order_release);
+    ++_tail;
+    return true;
+}
+
+void InputQueue::drain(std::vector<InputEvent>& events, const bool coalesce)
+{
+    InputEvent event;
+
+    /* at most one queue of events, so that a flood never starves a frame */
+    events.clear();
+    while((events.size() <= _mask) && pop(event)) {
+        events.push_back(event);
+    }
+    if(coalesce == false) {
+        return;
+    }
+    const uint32_t count = events.size();
+    for(uint32_t position = 0; position < count; ++position) {
+        const unsigned key = index(events[position]);
+        if(key != NONE) {
+            if((events[position].velocity != 0) && (_first[key] == NONE)) {
+                _first[key] = position;
+            }
+            _last[key] = position;
+        }
+    }
+    uint32_t kept = 0;
+    for(uint32_t position = 0; position < count; ++position) {
+        const unsigned key = index(events[position]);
+        if((key == NONE) || (position == (events[position].velocity != 0 ? _first[key] : _last[key]))) {
+            events[kept++] = events[position];
+        }
+    }
+    _coalesced += (count - kept);
+    events.resize(kept);
+    /* every key seen keeps at least one event, which is enough to reset it */
+    for(auto& kept_event : events) {
+        const unsigned key = index(kept_event);
+        if(key != NONE) {
+            _first[key] = NONE;
+            _last[key]  = NONE;
+        }
+    }
+}
+
+uint64_t InputQueue::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+unsigned InputQueue::index(const InputEvent& event)
+{
+    switch(event.type) {
+        case InputType::kGRID_KEY:
+            return (event.key % KEYS);
+        case InputType::kLIVE_KEY:
+            return KEYS + (event.key % KEYS);
+        default:
+            break;
+    }
+    return NONE;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
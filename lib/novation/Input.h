@@ -0,0 +1,162 @@
+/*
+ * Input.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Input_h__
+#define __NOVATION_Input_h__
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <novation/Gesture.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+enum class InputType : uint8_t;
+struct InputEvent;
+class InputQueue;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::InputType
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+enum class InputType : uint8_t
+{
+    kNONE     = 0,
+    kGRID_KEY = 1,
+    kLIVE_KEY = 2,
+    kGESTURE  = 3,
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::InputEvent
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct InputEvent
+{
+    InputType type;     /* kind of event                                      */
+    uint8_t   key;      /* key of a grid or live key                          */
+    uint8_t   velocity; /* velocity of a grid or live key, 0 when released    */
+    uint64_t  time;     /* reception time, in microseconds                    */
+    Gesture   gesture;  /* gesture recognized, for a gesture event            */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::InputQueue
+//
+// A bounded queue of input events with many producers, the MIDI input and
+// timer threads, and a single consumer, the command thread, which drains it
+// at a fixed point of each frame so that the model is only ever touched by
+// one thread. Each slot carries a sequence number telling whether it is free
+// or filled: a producer claims a slot with a compare-and-swap on the write
+// position and publishes it by bumping its sequence, the consumer reads the
+// slots in order without any atomic read-modify-write. Nobody ever waits:
+// when the queue is full, the event is dropped and counted.
+//
+// With coalescing, a drain delivers at most the first press and the last
+// release of each key, in their original order, so that a burst of events
+// on a key costs one or two updates while the final state and the presses
+// are kept.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class InputQueue
+{
+public: // public interface
+    InputQueue(const size_t capacity = DEFAULT_CAPACITY);
+
+    virtual ~InputQueue();
+
+    bool push(const InputEvent& event);
+
+    bool pop(InputEvent& event);
+
+    void drain(std::vector<InputEvent>& events, const bool coalesce);
+
+    size_t capacity() const
+    {
+        return _mask + 1;
+    }
+
+    uint64_t pushed() const
+    {
+        return _pushed.load();
+    }
+
+    uint64_t overflows() const
+    {
+        return _overflows.load();
+    }
+
+    uint64_t coalesced() const
+    {
+        return _coalesced;
+    }
+
+    static uint64_t now();
+
+public: // public static data
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+private: // private interface
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        InputEvent          event;
+    };
+
+    static constexpr unsigned KEYS = 128;
+    static constexpr unsigned NONE = UINT32_MAX;
+
+    static unsigned index(const InputEvent& event);
+
+private: // private data
+    const size_t            _mask;
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<size_t>     _head;
+    size_t                  _tail;
+    std::atomic<uint64_t>   _pushed;
+    std::atomic<uint64_t>   _overflows;
+    uint64_t                _coalesced;
+    uint32_t                _first[2 * KEYS];
+    uint32_t                _last[2 * KEYS];
+
+private: // disable copy and assignment
+    InputQueue(const InputQueue&) = delete;
+    InputQueue& operator=(const InputQueue&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Input_h__ */
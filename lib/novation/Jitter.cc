@@ -0,0 +1,78 @@
+/*
+ * Jitter.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "Jitter.h"
+
+// ---------------------------------------------------------------------------
+// novation::JitterMeter
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+JitterMeter::JitterMeter(const unsigned buckets)
+    : _buckets(buckets < 2 ? 2 : buckets)
+    , _histogram(_buckets)
+    , _count(0)
+    , _total(0)
+    , _maximum(0)
+{
+}
+
+JitterMeter::~JitterMeter()
+{
+}
+
+void JitterMeter::record(const uint64_t lateness)
+{
+    _histogram[lateness < _buckets ? lateness : _buckets - 1] += 1;
+    _count   += 1;
+    _total   += lateness;
+    _maximum  = (lateness > _maximum ? lateness : _maximum);
+}
+
+uint64_t JitterMeter::percentile(const unsigned percent) const
+{
+    const uint64_t rank = ((_count * percent) + 99) / 100;
+    uint64_t       seen = 0;
+
+    if(_count == 0) {
+        return 0;
+    }
+    for(unsigned bucket = 0; bucket < _buckets; ++bucket) {
+        seen += _histogram[bucket];
+        if((seen >= rank) && (seen != 0)) {
+            return (bucket < (_buckets - 1) ? bucket : _maximum);
+        }
+    }
+    return _maximum;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
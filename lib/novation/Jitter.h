@@ -0,0 +1,86 @@
+/*
+ * Jitter.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Jitter_h__
+#define __NOVATION_Jitter_h__
+
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class JitterMeter;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::JitterMeter
+//
+// Collects the lateness of events against their deadlines into a histogram
+// of microseconds, so that recording is O(1) and allocation-free, and gives
+// the average, the maximum and any percentile afterwards. The last bucket
+// collects everything beyond the range, whose percentiles are the maximum.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class JitterMeter
+{
+public: // public interface
+    JitterMeter(const unsigned buckets = DEFAULT_BUCKETS);
+
+    virtual ~JitterMeter();
+
+    void record(const uint64_t lateness);
+
+    uint64_t percentile(const unsigned percent) const;
+
+    uint64_t count() const
+    {
+        return _count;
+    }
+
+    uint64_t average() const
+    {
+        return (_count != 0 ? _total / _count : 0);
+    }
+
+    uint64_t maximum() const
+    {
+        return _maximum;
+    }
+
+public: // public static data
+    static constexpr unsigned DEFAULT_BUCKETS = 10000;
+
+private: // private data
+    const unsigned        _buckets;
+    std::vector<uint32_t> _histogram;
+    uint64_t              _count;
+    uint64_t              _total;
+    uint64_t              _maximum;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Jitter_h__ */
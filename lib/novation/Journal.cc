@@ -0,0 +1,337 @@
+/*
+ * Journal.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <base/Endian.h>
+#include "Journal.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::le
+// ---------------------------------------------------------------------------
+
+namespace {
+
+using le = base::LittleEndian;
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::jr
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct jr
+{
+    static uint64_t zigzag(const int64_t value)
+    {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    static int64_t unzigzag(const uint64_t value)
+    {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    static void invalid(const std::string& reason)
+    {
+        throw std::runtime_error(std::string("invalid journal file") + ':' + ' ' + reason);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::JournalReader
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+JournalReader::JournalReader(const std::string& path)
+    : _file(path)
+    , _cursor(_file.data())
+    , _end(_file.data() + _file.size())
+    , _seed(0)
+    , _time(InputQueue::now())
+    , _steps(0)
+    , _remaining(0)
+    , _frames(0)
+    , _events(0)
+{
+    if(_file.size() < Journal::HEADER_SIZE) {
+        jr::invalid("truncated header");
+    }
+    if(le::get32(_cursor + 0) != Journal::MAGIC) {
+        jr::invalid("bad magic");
+    }
+    if(le::get16(_cursor + 4) != Journal::FORMAT_VERSION) {
+        jr::invalid("unsupported version");
+    }
+    _seed    = le::get64(_cursor + 8);
+    _cursor += Journal::HEADER_SIZE;
+}
+
+JournalReader::~JournalReader()
+{
+}
+
+bool JournalReader::frame(unsigned& steps)
+{
+    if(_remaining == 0) {
+        /* the events of the previous frame are skipped if they were not read */
+        InputEvent skipped;
+        while(event(skipped)) {
+            continue;
+        }
+        if(_cursor >= _end) {
+            return false;
+        }
+        if(byte() != Journal::TAG_FRAME) {
+            jr::invalid("bad frame record");
+        }
+        _steps     = static_cast<unsigned>(varint());
+        _remaining = varint();
+        if(_remaining == 0) {
+            jr::invalid("bad frame record");
+        }
+    }
+    --_remaining;
+    ++_frames;
+    steps = _steps;
+    return true;
+}
+
+bool JournalReader::event(InputEvent& event)
+{
+    if((_remaining != 0) || (_cursor >= _end) || (*_cursor == Journal::TAG_FRAME)) {
+        return false;
+    }
+    const uint8_t tag = byte();
+
+    event = InputEvent();
+    _time = static_cast<uint64_t>(static_cast<int64_t>(_time) + signedVarint());
+    event.time = _time;
+    switch(tag) {
+        case Journal::TAG_GRID_KEY:
+        case Journal::TAG_LIVE_KEY:
+            event.type     = (tag == Journal::TAG_GRID_KEY ? InputType::kGRID_KEY : InputType::kLIVE_KEY);
+            event.key      = byte();
+            event.velocity = byte();
+            break;
+        case Journal::TAG_GESTURE:
+            event.type             = InputType::kGESTURE;
+            event.gesture.type     = static_cast<GestureType>(byte());
+            event.gesture.row      = byte();
+            event.gesture.col      = byte();
+            event.gesture.dx       = static_cast<int8_t>(byte());
+            event.gesture.dy       = static_cast<int8_t>(byte());
+            event.gesture.length   = byte();
+            event.gesture.pads     = varint();
+            event.gesture.time     = static_cast<uint64_t>(static_cast<int64_t>(_time) + signedVarint());
+            event.gesture.detected = static_cast<uint64_t>(static_cast<int64_t>(_time) + signedVarint());
+            break;
+        default:
+            jr::invalid("bad event record");
+            break;
+    }
+    ++_events;
+    return true;
+}
+
+uint8_t JournalReader::byte()
+{
+    if(_cursor >= _end) {
+        jr::invalid("truncated record");
+    }
+    return *_cursor++;
+}
+
+uint64_t JournalReader::varint()
+{
+    uint64_t value = 0;
+
+    for(unsigned shift = 0; shift < 64; shift += 7) {
+        const uint8_t data = byte();
+        value |= static_cast<uint64_t>(data & 0x7f) << shift;
+        if((data & 0x80) == 0) {
+            return value;
+        }
+    }
+    jr::invalid("bad varint");
+    return 0;
+}
+
+int64_t JournalReader::signedVarint()
+{
+    return jr::unzigzag(varint());
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::JournalWriter
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+JournalWriter::JournalWriter(const std::string& path, const uint64_t seed)
+    : _path(path)
+    , _seed(seed)
+    , _file(::fopen(path.c_str(), "wb"))
+    , _failed(false)
+    , _buffer()
+    , _time(InputQueue::now())
+    , _steps(0)
+    , _count(0)
+    , _frames(0)
+    , _events(0)
+{
+    if(_file == nullptr) {
+        throw std::runtime_error(std::string("unable to create") + ' ' + '<' + path + '>');
+    }
+    _buffer.reserve(Journal::BUFFER_SIZE * 2);
+    le::put32(_buffer, Journal::MAGIC);
+    le::put16(_buffer, Journal::FORMAT_VERSION);
+    le::put16(_buffer, 0);
+    le::put64(_buffer, seed);
+}
+
+JournalWriter::~JournalWriter()
+{
+    if(_file != nullptr) {
+        commit();
+        flush();
+        static_cast<void>(::fclose(_file));
+    }
+}
+
+void JournalWriter::frame(const unsigned steps)
+{
+    if((_count != 0) && (steps == _steps)) {
+        ++_count;
+    }
+    else {
+        commit();
+        _steps = steps;
+        _count = 1;
+    }
+    ++_frames;
+}
+
+void JournalWriter::event(const InputEvent& event)
+{
+    const int64_t time = static_cast<int64_t>(event.time);
+
+    commit();
+    switch(event.type) {
+        case InputType::kGRID_KEY:
+        case InputType::kLIVE_KEY:
+            byte(event.type == InputType::kGRID_KEY ? Journal::TAG_GRID_KEY : Journal::TAG_LIVE_KEY);
+            signedVarint(time - static_cast<int64_t>(_time));
+            byte(event.key);
+            byte(event.velocity);
+            break;
+        case InputType::kGESTURE:
+            byte(Journal::TAG_GESTURE);
+            signedVarint(time - static_cast<int64_t>(_time));
+            byte(static_cast<uint8_t>(event.gesture.type));
+            byte(event.gesture.row);
+            byte(event.gesture.col);
+            byte(static_cast<uint8_t>(event.gesture.dx));
+            byte(static_cast<uint8_t>(event.gesture.dy));
+            byte(event.gesture.length);
+            varint(event.gesture.pads);
+            signedVarint(static_cast<int64_t>(event.gesture.time) - time);
+            signedVarint(static_cast<int64_t>(event.gesture.detected) - time);
+            break;
+        default:
+            return;
+    }
+    _time = event.time;
+    ++_events;
+    if(_buffer.size() >= Journal::BUFFER_SIZE) {
+        flush();
+    }
+}
+
+void JournalWriter::close()
+{
+    if(_file != nullptr) {
+        commit();
+        flush();
+        _failed |= (::fclose(_file) != 0);
+        _file = nullptr;
+    }
+    if(_failed) {
+        throw std::runtime_error(std::string("unable to write") + ' ' + '<' + _path + '>');
+    }
+}
+
+void JournalWriter::byte(const uint8_t value)
+{
+    _buffer.push_back(value);
+}
+
+void JournalWriter::varint(uint64_t value)
+{
+    while(value >= 0x80) {
+        byte(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    byte(static_cast<uint8_t>(value));
+}
+
+void JournalWriter::signedVarint(const int64_t value)
+{
+    varint(jr::zigzag(value));
+}
+
+void JournalWriter::commit()
+{
+    if(_count != 0) {
+        byte(Journal::TAG_FRAME);
+        varint(_steps);
+        varint(_count);
+        _count = 0;
+        if(_buffer.size() >= Journal::BUFFER_SIZE) {
+            flush();
+        }
+    }
+}
+
+void JournalWriter::flush()
+{
+    if(_buffer.empty() == false) {
+        _failed |= (::fwrite(_buffer.data(), 1, _buffer.size(), _file) != _buffer.size());
+        _buffer.clear();
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,206 @@
+/*
+ * Journal.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Journal_h__
+#define __NOVATION_Journal_h__
+
+#include <cstdio>
+#include <base/MappedFile.h>
+#include <novation/Input.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Journal;
+class JournalReader;
+class JournalWriter;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Journal
+//
+// A journal is the input of a run, frame by frame, so that the run can be
+// replayed exactly. All integers are little-endian, varints are unsigned
+// LEB128 and signed values are zigzag-encoded.
+//
+//   header   16 bytes  magic "LPJR", version, reserved, u64 random seed
+//   frame    tag 0     varint steps, varint count of identical frames
+//   key      tag 1, 2  grid or live key: signed varint time delta, key,
+//                      velocity
+//   gesture  tag 3     signed varint time delta, type, row, col, dx, dy,
+//                      length, varint pads, signed varint start and
+//                      detection times relative to the event
+//
+// The events recorded after a run of frames were drained at the last one.
+// The times are relative to the previous event, the first one to the start
+// of the recording.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Journal
+{
+    static constexpr uint32_t MAGIC          = 0x524a504c; /* "LPJR" */
+    static constexpr uint16_t FORMAT_VERSION = 1;
+    static constexpr size_t   HEADER_SIZE    = 16;
+    static constexpr uint8_t  TAG_FRAME      = 0;
+    static constexpr uint8_t  TAG_GRID_KEY   = 1;
+    static constexpr uint8_t  TAG_LIVE_KEY   = 2;
+    static constexpr uint8_t  TAG_GESTURE    = 3;
+    static constexpr size_t   BUFFER_SIZE    = 4096;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::JournalReader
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class JournalReader
+{
+public: // public interface
+    JournalReader(const std::string& path);
+
+    virtual ~JournalReader();
+
+    bool frame(unsigned& steps);
+
+    bool event(InputEvent& event);
+
+    bool done() const
+    {
+        return (_remaining == 0) && (_cursor >= _end);
+    }
+
+    uint64_t seed() const
+    {
+        return _seed;
+    }
+
+    uint64_t frames() const
+    {
+        return _frames;
+    }
+
+    uint64_t events() const
+    {
+        return _events;
+    }
+
+private: // private interface
+    uint8_t byte();
+
+    uint64_t varint();
+
+    int64_t signedVarint();
+
+private: // private data
+    const base::MappedFile _file;
+    const uint8_t*         _cursor;
+    const uint8_t*         _end;
+    uint64_t               _seed;
+    uint64_t               _time;
+    unsigned               _steps;
+    uint64_t               _remaining;
+    uint64_t               _frames;
+    uint64_t               _events;
+
+private: // disable copy and assignment
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::JournalWriter
+//
+// The records are buffered and written by blocks, close() writes the rest
+// and reports any error. Identical frames without any event in between are
+// merged into a single record.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class JournalWriter
+{
+public: // public interface
+    JournalWriter(const std::string& path, const uint64_t seed);
+
+    virtual ~JournalWriter();
+
+    void frame(const unsigned steps);
+
+    void event(const InputEvent& event);
+
+    void close();
+
+    uint64_t seed() const
+    {
+        return _seed;
+    }
+
+    uint64_t frames() const
+    {
+        return _frames;
+    }
+
+    uint64_t events() const
+    {
+        return _events;
+    }
+
+private: // private interface
+    void byte(const uint8_t value);
+
+    void varint(uint64_t value);
+
+    void signedVarint(const int64_t value);
+
+    void commit();
+
+    void flush();
+
+private: // private data
+    const std::string    _path;
+    const uint64_t       _seed;
+    FILE*                _file;
+    bool                 _failed;
+    std::vector<uint8_t> _buffer;
+    uint64_t             _time;
+    unsigned             _steps;
+    uint64_t             _count;
+    uint64_t             _frames;
+    uint64_t             _events;
+
+private: // disable copy and assignment
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Journal_h__ */
@@ -57,24 +57,6 @@ struct lp
         return rc;
     }
 
-    static uint8_t color_byte(uint8_t r, uint8_t g, bool copy, bool clear)
-    {
-        const uint8_t flags = static_cast<uint8_t>(false) << 7 /* must be unset                             */
-                            | static_cast<uint8_t>(false) << 6 /* must be unset                             */
-                            | static_cast<uint8_t>(false) << 5 /* green brightness (most significant bit)   */
-                            | static_cast<uint8_t>(false) << 4 /* green brightness (least significant bit)  */
-                            | static_cast<uint8_t>(clear) << 3 /* clear the other buffer’s copy of this led */
-                            | static_cast<uint8_t>(copy)  << 2 /* write this led data to both buffers       */
-                            | static_cast<uint8_t>(false) << 1 /* red brightness (most significant bit)     */
-                            | static_cast<uint8_t>(false) << 0 /* red brightness (least significant bit)    */
-                            ;
-        const uint8_t color = flags
-                            | (((g >> 6) & 0x03) << 4)
-                            | (((r >> 6) & 0x03) << 0)
-                            ;
-        return color;
-    }
-
     static void errorCallback(RtMidiError::Type type, const std::string& message, void* userData)
     {
         novation::LaunchpadListener* listener(reinterpret_cast<novation::LaunchpadListener*>(userData));
@@ -199,6 +181,24 @@ void Launchpad::setPad(uint8_t row, uint8_t col, uint8_t color)
     Midi::send(*(_midi.out), channel, note, velocity);
 }
 
+void Launchpad::setPads(const uint8_t* colors, uint8_t count)
+{
+    constexpr uint8_t channel = Midi::CHANNEL_03_NOTE_ON;
+
+    /*
+     * rapid update: two leds per message, starting from the top-left pad of
+     * the grid, then the scene and the top buttons. The cursor is rewound by
+     * selecting the layout again, so each call starts at the first pad.
+     */
+    setGridLayout();
+    for(uint8_t index = 0; (index + 1) < count; index += 2) {
+        Midi::send(*(_midi.out), channel, colors[index + 0], colors[index + 1]);
+    }
+    if((count % 2) != 0) {
+        Midi::send(*(_midi.out), channel, colors[count - 1], colors[count - 1]);
+    }
+}
+
 void Launchpad::clearPad(uint8_t pad)
 {
     constexpr uint8_t channel  = Midi::CHANNEL_01_NOTE_OFF;
@@ -219,7 +219,7 @@ void Launchpad::clearPad(uint8_t row, uint8_t col)
 
 uint8_t Launchpad::makeColor(uint8_t red, uint8_t green, bool copy, bool clear)
 {
-    return lp::color_byte(red, green, copy, clear);
+    return Palettes<MiniEncoding>::TABLE(Color(red, green), copy, clear);
 }
 
 int Launchpad::enumerateInputs(std::vector<std::string>& inputs)
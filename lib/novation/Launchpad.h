@@ -18,6 +18,7 @@
 #define __NOVATION_Launchpad_h__
 
 #include <novation/Midi.h>
+#include <novation/Color.h>
 
 // ---------------------------------------------------------------------------
 // novation
@@ -66,6 +67,8 @@ public: // public interface
 
     virtual void setPad(uint8_t row, uint8_t col, uint8_t color);
 
+    virtual void setPads(const uint8_t* colors, uint8_t count);
+
     virtual void clearPad(uint8_t pad);
 
     virtual void clearPad(uint8_t row, uint8_t col);
@@ -78,6 +81,11 @@ public: // public interface
 
     virtual void setListener(LaunchpadListener* listener);
 
+    const std::string& name() const
+    {
+        return _name;
+    }
+
 public: // public static data
     static const uint8_t ROWS = 8;
     static const uint8_t COLS = 8;
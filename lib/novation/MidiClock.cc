@@ -0,0 +1,227 @@
+/*
+ * MidiClock.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "MidiClock.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::mc
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct mc
+{
+    using clock = std::chrono::steady_clock;
+
+    static constexpr double TICK = static_cast<double>(novation::MidiClock::BEAT) / novation::MidiClock::PPQN;
+
+    /* a slept wait gives up after a while, so that a stopped clock never blocks */
+    static constexpr int64_t SLICE = 100000;
+
+    static uint64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(clock::now().time_since_epoch()).count();
+    }
+
+    static double period(const double tempo)
+    {
+        return 60000000.0 / (novation::MidiClock::PPQN * tempo);
+    }
+
+    static void callback(double deltatime, std::vector<unsigned char>* message, void* userData)
+    {
+        static_cast<void>(deltatime);
+        novation::MidiClock* clock(reinterpret_cast<novation::MidiClock*>(userData));
+        if((clock != nullptr) && (message->size() == 1)) {
+            clock->receive(message->at(0), now());
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::MidiClock
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+MidiClock::MidiClock(const std::string& name, const std::string& port)
+    : _input(new RtMidiIn(RtMidi::UNSPECIFIED, name))
+    , _mutex()
+    , _condition()
+    , _status()
+    , _samples(0)
+    , _phase(0.0)
+    , _base(0.0)
+    , _counted(0)
+    , _last(0)
+{
+    _status.period = mc::TICK;
+    _status.tempo  = 60000000.0 / (PPQN * _status.period);
+    if(port.empty() == false) {
+        if(Midi::open(*_input, port, name + ' ' + "clock input") == false) {
+            throw std::runtime_error("*** unable to open MIDI clock input ***");
+        }
+        _input->ignoreTypes(true, false, true);
+        _input->setCallback(&mc::callback, this);
+    }
+}
+
+MidiClock::~MidiClock()
+{
+    if(_input->isPortOpen()) {
+        _input->cancelCallback();
+    }
+    static_cast<void>(Midi::close(*_input));
+}
+
+uint64_t MidiClock::now()
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    const uint64_t                    time = static_cast<uint64_t>(locate(static_cast<double>(mc::now())));
+
+    if(time > _last) {
+        _last = time;
+    }
+    return _last;
+}
+
+bool MidiClock::sleepUntil(const uint64_t time)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    const uint64_t               limit = mc::now() + mc::SLICE;
+
+    for(;;) {
+        const uint64_t wall = mc::now();
+        if(locate(static_cast<double>(wall)) >= static_cast<double>(time)) {
+            return true;
+        }
+        if(wall >= limit) {
+            return false;
+        }
+        /* until the predicted tick if it is the next one, else until a tick arrives */
+        uint64_t wake = limit;
+        if(_status.running && (_counted != 0)) {
+            const double ticks = ((time - _base) / mc::TICK) - static_cast<double>(_counted - 1);
+            if(ticks <= 1.0) {
+                const double at = std::ceil(_phase + (ticks * _status.period));
+                wake = (at < static_cast<double>(limit) ? static_cast<uint64_t>(at) : limit);
+            }
+        }
+        _condition.wait_until(lock, mc::clock::time_point(std::chrono::microseconds(wake)));
+    }
+}
+
+void MidiClock::receive(const uint8_t status, const uint64_t time)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    const double                      wall = static_cast<double>(time);
+
+    switch(status) {
+        case TIMING_CLOCK:
+            ++_status.ticks;
+            if(_samples == 0) {
+                _phase = wall;
+                ++_samples;
+            }
+            else if(_samples == 1) {
+                /* the first period is measured, then filtered */
+                const double period = wall - _phase;
+                if((period >= mc::period(MAXIMUM_TEMPO)) && (period <= mc::period(MINIMUM_TEMPO))) {
+                    _status.period = period;
+                    ++_samples;
+                }
+                _phase = wall;
+            }
+            else {
+                const double predicted = _phase + _status.period;
+                const double error     = wall - predicted;
+                const double magnitude = std::fabs(error);
+                if(magnitude > (_status.period * 0.5)) {
+                    /* lost ticks or a sudden change of tempo, measure again */
+                    _phase   = wall;
+                    _samples = 1;
+                    ++_status.resyncs;
+                }
+                else {
+                    _phase          = predicted + (ALPHA * error);
+                    _status.period += (BETA * error);
+                    _status.period  = std::fmax(mc::period(MAXIMUM_TEMPO), std::fmin(mc::period(MINIMUM_TEMPO), _status.period));
+                    _status.error   = error;
+                    _status.jitter += (magnitude - _status.jitter) / 32.0;
+                    _status.maximum = std::fmax(_status.maximum, magnitude);
+                    _status.drift  += (ALPHA * error);
+                }
+            }
+            _status.tempo = 60000000.0 / (PPQN * _status.period);
+            if(_status.running) {
+                ++_counted;
+            }
+            break;
+        case START:
+        case CONTINUE:
+            /* the musical time never goes back, a start resumes it as well */
+            _base           = locate(wall);
+            _counted        = 0;
+            _status.running = true;
+            break;
+        case STOP:
+            _base           = locate(wall);
+            _counted        = 0;
+            _status.running = false;
+            break;
+        default:
+            return;
+    }
+    _condition.notify_all();
+}
+
+MidiClockStatus MidiClock::status()
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+
+    return _status;
+}
+
+double MidiClock::locate(const double wall) const
+{
+    if(_status.running && (_counted != 0)) {
+        const double elapsed = (wall - _phase) / _status.period;
+        const double clamped = (elapsed < 0.0 ? 0.0 : (elapsed > 1.0 ? 1.0 : elapsed));
+        return _base + ((static_cast<double>(_counted - 1) + clamped) * mc::TICK);
+    }
+    return _base;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
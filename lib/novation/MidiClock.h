@@ -0,0 +1,127 @@
+/*
+ * MidiClock.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_MidiClock_h__
+#define __NOVATION_MidiClock_h__
+
+#include <mutex>
+#include <condition_variable>
+#include <base/Pacer.h>
+#include <novation/Midi.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct MidiClockStatus;
+class MidiClock;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::MidiClockStatus
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct MidiClockStatus
+{
+    bool     running; /* between a start or continue and a stop           */
+    uint64_t ticks;   /* clock messages received                          */
+    uint64_t resyncs; /* ticks too far from the prediction to be filtered */
+    double   tempo;   /* estimated tempo, in beats per minute             */
+    double   period;  /* estimated tick period, in microseconds           */
+    double   error;   /* phase error of the last tick, in microseconds    */
+    double   jitter;  /* recent average absolute phase error, in us       */
+    double   maximum; /* maximum absolute phase error, in microseconds    */
+    double   drift;   /* sum of the phase corrections, in microseconds    */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::MidiClock
+//
+// A pacer clock following the MIDI clock (24 ticks per quarter note) of an
+// input port. The time is musical: a beat always lasts BEAT microseconds,
+// that is 120 BPM, whatever the actual tempo, and the time stands still
+// while the clock is stopped.
+//
+// The ticks are filtered by a second-order phase-locked loop: each tick is
+// compared to the predicted one, and the error corrects both the phase and
+// the period, so that the jitter of the input is smoothed while the tempo is
+// still followed. Between two ticks, the time is interpolated with the period
+// and never runs more than one tick ahead of the input.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class MidiClock final
+    : public base::PacerClock
+{
+public: // public interface
+    MidiClock(const std::string& name, const std::string& port);
+
+    virtual ~MidiClock();
+
+    virtual uint64_t now() override;
+
+    virtual bool sleepUntil(const uint64_t time) override;
+
+    void receive(const uint8_t status, const uint64_t time);
+
+    MidiClockStatus status();
+
+public: // public static data
+    static constexpr uint64_t BEAT          = 500000;
+    static constexpr unsigned PPQN          = 24;
+    static constexpr double   ALPHA         = 0.125;
+    static constexpr double   BETA          = (ALPHA * ALPHA) / (2.0 - ALPHA);
+    static constexpr double   MINIMUM_TEMPO = 20.0;
+    static constexpr double   MAXIMUM_TEMPO = 300.0;
+    static constexpr uint8_t  TIMING_CLOCK  = 0xf8;
+    static constexpr uint8_t  START         = 0xfa;
+    static constexpr uint8_t  CONTINUE      = 0xfb;
+    static constexpr uint8_t  STOP          = 0xfc;
+
+private: // private interface
+    double locate(const double wall) const;
+
+private: // private data
+    MidiInUniquePtr         _input;
+    std::mutex              _mutex;
+    std::condition_variable _condition;
+    MidiClockStatus         _status;
+    unsigned                _samples;
+    double                  _phase;
+    double                  _base;
+    uint64_t                _counted;
+    uint64_t                _last;
+
+private: // disable copy and assignment
+    MidiClock(const MidiClock&) = delete;
+    MidiClock& operator=(const MidiClock&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_MidiClock_h__ */
@@ -0,0 +1,274 @@
+/*
+ * Monitor.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "Midi.h"
+#include "Monitor.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::mn
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct mn
+{
+    static constexpr uint8_t TOP_FIRST = 0x68;
+    static constexpr uint8_t TOP_LAST  = 0x6f;
+    static constexpr uint8_t SCENE_COL = 8;
+    static constexpr size_t  SHOWN     = 8;
+    static constexpr size_t  LINE      = 160;
+
+    static size_t mask(const size_t capacity)
+    {
+        size_t size = 1;
+        while(size < capacity) {
+            size <<= 1;
+        }
+        return size - 1;
+    }
+
+    static void put(std::vector<char>& buffer, const uint64_t value, const unsigned size)
+    {
+        for(unsigned index = 0; index < size; ++index) {
+            buffer.push_back(static_cast<char>(value >> (index * 8)));
+        }
+    }
+
+    static const char* state(const uint8_t velocity)
+    {
+        return (velocity != 0 ? "pressed" : "released");
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::MonitorQueue
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+MonitorQueue::MonitorQueue(const size_t capacity)
+    : _mask(mn::mask(capacity))
+    , _events(new MonitorEvent[_mask + 1])
+    , _head(0)
+    , _tail(0)
+    , _overflows(0)
+{
+}
+
+MonitorQueue::~MonitorQueue()
+{
+}
+
+bool MonitorQueue::push(const uint8_t* data, const size_t size, const uint64_t time)
+{
+    const size_t head = _head.load(std::memory_order_relaxed);
+
+    if((head - _tail.load(std::memory_order_acquire)) > _mask) {
+        _overflows.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    MonitorEvent& event(_events[head & _mask]);
+    const size_t  count = (size < sizeof(event.data) ? size : sizeof(event.data));
+    event.time = time;
+    event.size = static_cast<uint16_t>(size < UINT16_MAX ? size : UINT16_MAX);
+    ::memcpy(event.data, data, count);
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool MonitorQueue::pop(MonitorEvent& event)
+{
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+
+    if(tail == _head.load(std::memory_order_acquire)) {
+        return false;
+    }
+    event = _events[tail & _mask];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::MonitorWriter
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+MonitorWriter::MonitorWriter ( std::ostream&  stream
+                             , const bool     binary
+                             , const uint64_t interval
+                             , const size_t   capacity )
+    : _stream(stream)
+    , _binary(binary)
+    , _interval(interval)
+    , _capacity(capacity)
+    , _buffer()
+    , _origin(0)
+    , _previous(0)
+    , _written(0)
+    , _events(0)
+    , _bytes(0)
+    , _flushes(0)
+{
+    _buffer.reserve(_capacity + mn::LINE);
+    if(_binary) {
+        mn::put(_buffer, MAGIC, 4);
+        mn::put(_buffer, FORMAT_VERSION, 2);
+        mn::put(_buffer, 0, 2);
+    }
+}
+
+MonitorWriter::~MonitorWriter()
+{
+    flush();
+}
+
+void MonitorWriter::write(const MonitorEvent& event)
+{
+    if(_events++ == 0) {
+        _origin   = event.time;
+        _previous = event.time;
+    }
+    if(_binary) {
+        binary(event);
+    }
+    else {
+        text(event);
+    }
+    _previous = event.time;
+    if(_buffer.size() >= _capacity) {
+        flush();
+    }
+}
+
+bool MonitorWriter::flush(const uint64_t now)
+{
+    if(_buffer.empty() || ((now - _written) < _interval)) {
+        return false;
+    }
+    flush();
+    _written = now;
+    return true;
+}
+
+void MonitorWriter::flush()
+{
+    if(_buffer.empty() == false) {
+        _stream.write(_buffer.data(), _buffer.size());
+        _stream.flush();
+        _bytes += _buffer.size();
+        _buffer.clear();
+        ++_flushes;
+    }
+}
+
+const char* MonitorWriter::decode(const uint8_t* data, const size_t size, char* buffer, const size_t length)
+{
+    int rc = 0;
+
+    if(size == 0) {
+        buffer[0] = '\0';
+        return buffer;
+    }
+    const uint8_t status = data[0];
+    if((size == 3) && ((status == Midi::CHANNEL_01_NOTE_ON) || (status == Midi::CHANNEL_01_NOTE_OFF))) {
+        const uint8_t row      = (data[1] >> 4);
+        const uint8_t col      = (data[1] & 0x0f);
+        const uint8_t velocity = (status == Midi::CHANNEL_01_NOTE_OFF ? 0 : data[2]);
+        if(col < mn::SCENE_COL) {
+            rc = ::snprintf(buffer, length, "pad %u,%u %s", row, col, mn::state(velocity));
+        }
+        else if(col == mn::SCENE_COL) {
+            rc = ::snprintf(buffer, length, "scene %c %s", static_cast<char>('A' + row), mn::state(velocity));
+        }
+        else {
+            rc = ::snprintf(buffer, length, "note %u %s", data[1], mn::state(velocity));
+        }
+    }
+    else if((size == 3) && (status == Midi::CHANNEL_01_CONTROL_CHANGE)) {
+        if((data[1] >= mn::TOP_FIRST) && (data[1] <= mn::TOP_LAST)) {
+            rc = ::snprintf(buffer, length, "top %u %s", (data[1] - mn::TOP_FIRST) + 1, mn::state(data[2]));
+        }
+        else {
+            rc = ::snprintf(buffer, length, "controller %u value %u", data[1], data[2]);
+        }
+    }
+    else if(status == 0xf0) {
+        rc = ::snprintf(buffer, length, "sysex %u bytes", static_cast<unsigned>(size));
+    }
+    else {
+        rc = ::snprintf(buffer, length, "status 0x%02x", status);
+    }
+    if((rc < 0) || (rc >= static_cast<int>(length))) {
+        throw std::runtime_error("snprintf() has failed");
+    }
+    return buffer;
+}
+
+void MonitorWriter::text(const MonitorEvent& event)
+{
+    const size_t   stored  = (event.size < sizeof(event.data) ? event.size : sizeof(event.data));
+    const size_t   shown   = (stored < mn::SHOWN ? stored : mn::SHOWN);
+    const uint64_t time    = event.time - _origin;
+    const uint64_t delta   = (event.time > _previous ? event.time - _previous : 0);
+    char           bytes[(mn::SHOWN * 3) + 4];
+    char           decoded[64];
+    char           line[mn::LINE];
+    int            length  = 0;
+
+    for(size_t index = 0; index < shown; ++index) {
+        static_cast<void>(::snprintf(&bytes[index * 3], 4, "%02x ", event.data[index]));
+    }
+    ::strcpy(&bytes[shown * 3], (event.size > shown ? "..." : ""));
+    length = ::snprintf(line, sizeof(line), "%6llu.%06llu +%llu.%06llu  %-27s %s\n"
+                       , static_cast<unsigned long long>(time / 1000000), static_cast<unsigned long long>(time % 1000000)
+                       , static_cast<unsigned long long>(delta / 1000000), static_cast<unsigned long long>(delta % 1000000)
+                       , bytes, decode(event.data, event.size, decoded, sizeof(decoded)));
+    if((length < 0) || (length >= static_cast<int>(sizeof(line)))) {
+        throw std::runtime_error("snprintf() has failed");
+    }
+    _buffer.insert(_buffer.end(), line, line + length);
+}
+
+void MonitorWriter::binary(const MonitorEvent& event)
+{
+    const size_t stored = (event.size < sizeof(event.data) ? event.size : sizeof(event.data));
+
+    mn::put(_buffer, event.time - _origin, 8);
+    mn::put(_buffer, stored, 2);
+    _buffer.insert(_buffer.end(), event.data, event.data + stored);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
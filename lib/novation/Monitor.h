@@ -0,0 +1,190 @@
+/*
+ * Monitor.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Monitor_h__
+#define __NOVATION_Monitor_h__
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <ostream>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct MonitorEvent;
+class MonitorQueue;
+class MonitorWriter;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::MonitorEvent
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct MonitorEvent
+{
+    uint64_t time;     /* reception time, in microseconds                    */
+    uint16_t size;     /* size of the message, which may exceed the data     */
+    uint8_t  data[14]; /* first bytes of the message                         */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::MonitorQueue
+//
+// A bounded single-producer single-consumer queue of raw MIDI messages,
+// between the MIDI input thread and the thread printing them. Each side owns
+// its position and only reads the other one, so that a push is a copy and a
+// release store: the input thread never waits nor allocates. When the queue
+// is full, the message is dropped and counted.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class MonitorQueue
+{
+public: // public interface
+    MonitorQueue(const size_t capacity = DEFAULT_CAPACITY);
+
+    virtual ~MonitorQueue();
+
+    bool push(const uint8_t* data, const size_t size, const uint64_t time);
+
+    bool pop(MonitorEvent& event);
+
+    size_t capacity() const
+    {
+        return _mask + 1;
+    }
+
+    uint64_t overflows() const
+    {
+        return _overflows.load();
+    }
+
+public: // public static data
+    static constexpr size_t DEFAULT_CAPACITY = 65536;
+
+private: // private data
+    const size_t                    _mask;
+    std::unique_ptr<MonitorEvent[]> _events;
+    std::atomic<size_t>             _head;
+    std::atomic<size_t>             _tail;
+    std::atomic<uint64_t>           _overflows;
+
+private: // disable copy and assignment
+    MonitorQueue(const MonitorQueue&) = delete;
+    MonitorQueue& operator=(const MonitorQueue&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::MonitorWriter
+//
+// Prints the messages into a buffer, which is written to the stream in one
+// go when it is full or when flush() finds it older than the interval, so
+// that a burst costs a few writes instead of one per line.
+//
+// A text line gives the time since the first message and the delta to the
+// previous one, in seconds, the bytes in hexadecimal and the decoded event
+// of the Launchpad: a pad with its row and column, a scene button A to H on
+// the right, or a top button 1 to 8.
+//
+// The binary output is little-endian: a header of 8 bytes, magic "LPMN",
+// version and reserved, then per message a u64 time in microseconds since
+// the first message, a u16 count and the bytes, the first 14 at most.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class MonitorWriter
+{
+public: // public interface
+    MonitorWriter ( std::ostream&  stream
+                  , const bool     binary
+                  , const uint64_t interval = DEFAULT_INTERVAL
+                  , const size_t   capacity = DEFAULT_CAPACITY );
+
+    virtual ~MonitorWriter();
+
+    void write(const MonitorEvent& event);
+
+    bool flush(const uint64_t now);
+
+    void flush();
+
+    uint64_t events() const
+    {
+        return _events;
+    }
+
+    uint64_t bytes() const
+    {
+        return _bytes;
+    }
+
+    uint64_t flushes() const
+    {
+        return _flushes;
+    }
+
+    static const char* decode(const uint8_t* data, const size_t size, char* buffer, const size_t length);
+
+public: // public static data
+    static constexpr uint64_t DEFAULT_INTERVAL = 100000;
+    static constexpr size_t   DEFAULT_CAPACITY = 65536;
+    static constexpr uint32_t MAGIC            = 0x4e4d504c; /* "LPMN" */
+    static constexpr uint16_t FORMAT_VERSION   = 1;
+
+private: // private interface
+    void text(const MonitorEvent& event);
+
+    void binary(const MonitorEvent& event);
+
+private: // private data
+    std::ostream&     _stream;
+    const bool        _binary;
+    const uint64_t    _interval;
+    const size_t      _capacity;
+    std::vector<char> _buffer;
+    uint64_t          _origin;
+    uint64_t          _previous;
+    uint64_t          _written;
+    uint64_t          _events;
+    uint64_t          _bytes;
+    uint64_t          _flushes;
+
+private: // disable copy and assignment
+    MonitorWriter(const MonitorWriter&) = delete;
+    MonitorWriter& operator=(const MonitorWriter&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Monitor_h__ */
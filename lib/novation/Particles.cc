@@ -0,0 +1,294 @@
+/*
+ * Particles.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <base/Cpu.h>
+#include "Particles.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ps
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ps
+{
+    typedef int32_t vec8 __attribute__((vector_size(32)));
+
+    static constexpr int32_t ROWS    = novation::DeepFrame::ROWS;
+    static constexpr int32_t COLS    = novation::DeepFrame::COLS;
+    static constexpr int32_t ONE     = novation::ParticleSystem::ONE;
+    static constexpr int32_t MARGIN  = 2 * ONE;
+    static constexpr int32_t CEILING = -16 * ONE;
+
+    static inline __attribute__((always_inline)) void load(vec8& vector, const int32_t* array)
+    {
+        ::memcpy(&vector, array, sizeof(vector));
+    }
+
+    static inline __attribute__((always_inline)) void store(const vec8& vector, int32_t* array)
+    {
+        ::memcpy(array, &vector, sizeof(vector));
+    }
+
+    /* the kernel of base::Cpu::dispatch() */
+    struct Update
+    {
+        inline __attribute__((always_inline)) void operator()(const novation::ParticlePhysics& physics, int32_t* x, int32_t* y, int32_t* vx, int32_t* vy, int32_t* level, const int32_t* decay, const size_t count) const
+        {
+            const int     shift   = (physics.drag != 0 ? physics.drag : 31);
+            const int32_t drag    = (physics.drag != 0 ? -1 : 0);
+            const int32_t gravity = physics.gravity;
+
+            for(size_t index = 0; index < count; index += novation::ParticleSystem::LANES) {
+                vec8 px, py, pvx, pvy, plevel, pdecay;
+                load(px, x + index);
+                load(py, y + index);
+                load(pvx, vx + index);
+                load(pvy, vy + index);
+                load(plevel, level + index);
+                load(pdecay, decay + index);
+                pvy    += gravity;
+                pvx    -= (pvx >> shift) & drag;
+                pvy    -= (pvy >> shift) & drag;
+                px     += pvx;
+                py     += pvy;
+                plevel -= pdecay;
+                store(px, x + index);
+                store(py, y + index);
+                store(pvx, vx + index);
+                store(pvy, vy + index);
+                store(plevel, level + index);
+            }
+        }
+    };
+
+    static int32_t magnitude(const int32_t vx, const int32_t vy)
+    {
+        /* the larger component is a close enough approximation here */
+        const int32_t ax = (vx < 0 ? -vx : vx);
+        const int32_t ay = (vy < 0 ? -vy : vy);
+        return (ax > ay ? ax : ay);
+    }
+
+    static bool visible(const int32_t x, const int32_t y, const int32_t level)
+    {
+        if(level <= 0) {
+            return false;
+        }
+        if((x < -MARGIN) || (x > (((COLS - 1) * ONE) + MARGIN))) {
+            return false;
+        }
+        if((y < CEILING) || (y > (((ROWS - 1) * ONE) + MARGIN))) {
+            return false;
+        }
+        return true;
+    }
+
+    static void splat(uint32_t* red, uint32_t* green, const int32_t row, const int32_t col, const uint32_t weight, const uint32_t r, const uint32_t g)
+    {
+        if((row >= 0) && (row < ROWS) && (col >= 0) && (col < COLS) && (weight != 0)) {
+            red[row * COLS + col]   += (r * weight) >> 16;
+            green[row * COLS + col] += (g * weight) >> 16;
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ParticleSystem
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+ParticleSystem::ParticleSystem(const size_t capacity, const uint64_t seed)
+    : _capacity(capacity)
+    , _count(0)
+    , _x(new int32_t[capacity + LANES]())
+    , _y(new int32_t[capacity + LANES]())
+    , _vx(new int32_t[capacity + LANES]())
+    , _vy(new int32_t[capacity + LANES]())
+    , _level(new int32_t[capacity + LANES]())
+    , _decay(new int32_t[capacity + LANES]())
+    , _color(new int32_t[capacity + LANES]())
+    , _kind(new int32_t[capacity + LANES]())
+    , _random(seed)
+    , _overflows(0)
+{
+    if((capacity == 0) || (capacity > MAXIMUM_CAPACITY)) {
+        throw std::runtime_error("invalid particle capacity");
+    }
+}
+
+ParticleSystem::~ParticleSystem()
+{
+}
+
+void ParticleSystem::clear()
+{
+    _count = 0;
+}
+
+bool ParticleSystem::spawn ( const ParticleKind kind
+                           , const int32_t      x
+                           , const int32_t      y
+                           , const int32_t      vx
+                           , const int32_t      vy
+                           , const int32_t      decay
+                           , const uint8_t      red
+                           , const uint8_t      green )
+{
+    if(_count >= _capacity) {
+        ++_overflows;
+        return false;
+    }
+    const size_t index = _count++;
+    _x[index]     = x;
+    _y[index]     = y;
+    _vx[index]    = vx;
+    _vy[index]    = vy;
+    _level[index] = BRIGHTNESS;
+    _decay[index] = decay;
+    _color[index] = (static_cast<int32_t>(green) << 8) | red;
+    _kind[index]  = static_cast<int32_t>(kind);
+    return true;
+}
+
+void ParticleSystem::update(const ParticlePhysics& physics)
+{
+    /* the vectorized pass also runs over the padding of the last batch */
+    base::Cpu::dispatch<ps::Update>(physics, _x.get(), _y.get(), _vx.get(), _vy.get(), _level.get(), _decay.get(), _count);
+    /* the few particles with a behavior, then the dead ones are removed */
+    const size_t count = _count;
+    for(size_t index = 0; index < count; ++index) {
+        switch(static_cast<ParticleKind>(_kind[index])) {
+            case ParticleKind::kDROP:
+                if(_level[index] > 0) {
+                    /* the trail adds up to the full brightness over one pad */
+                    const int64_t speed = ps::magnitude(_vx[index], _vy[index]);
+                    const int64_t level = std::min<int64_t>((static_cast<int64_t>(BRIGHTNESS) * speed) / ONE, BRIGHTNESS);
+                    const int64_t decay = std::max<int64_t>((static_cast<int64_t>(physics.trail) * level) / BRIGHTNESS, 1);
+                    if(spawn(ParticleKind::kSPARK, _x[index], _y[index], 0, 0, decay, physics.red, physics.green)) {
+                        _level[_count - 1] = static_cast<int32_t>(level);
+                    }
+                }
+                break;
+            case ParticleKind::kROCKET:
+                if(_vy[index] >= 0) {
+                    explode(index, physics);
+                    _level[index] = 0;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    for(size_t index = 0; index < _count;) {
+        if(ps::visible(_x[index], _y[index], _level[index])) {
+            ++index;
+        }
+        else {
+            remove(index);
+        }
+    }
+}
+
+void ParticleSystem::render(DeepFrame& frame) const
+{
+    uint32_t red[DeepFrame::ROWS * DeepFrame::COLS]   = {};
+    uint32_t green[DeepFrame::ROWS * DeepFrame::COLS] = {};
+
+    for(size_t index = 0; index < _count; ++index) {
+        const int32_t  x     = _x[index];
+        const int32_t  y     = _y[index];
+        const int32_t  col   = (x >> 16);
+        const int32_t  row   = (y >> 16);
+        const uint32_t fx    = (x >> 8) & 0xff;
+        const uint32_t fy    = (y >> 8) & 0xff;
+        const uint32_t level = (_level[index] >> 16);
+        const uint32_t r     = ((_color[index] & 0xff) * level) >> 8;
+        const uint32_t g     = (((_color[index] >> 8) & 0xff) * level) >> 8;
+        ps::splat(red, green, (row + 0), (col + 0), ((256 - fx) * (256 - fy)), r, g);
+        ps::splat(red, green, (row + 0), (col + 1), ((fx | 0) * (256 - fy)), r, g);
+        ps::splat(red, green, (row + 1), (col + 0), ((256 - fx) * (fy | 0)), r, g);
+        ps::splat(red, green, (row + 1), (col + 1), ((fx | 0) * (fy | 0)), r, g);
+    }
+    for(unsigned row = 0; row < DeepFrame::ROWS; ++row) {
+        for(unsigned col = 0; col < DeepFrame::COLS; ++col) {
+            const uint32_t r = red[row * DeepFrame::COLS + col];
+            const uint32_t g = green[row * DeepFrame::COLS + col];
+            frame.red[row][col]   = (r < 255 ? r : 255);
+            frame.green[row][col] = (g < 255 ? g : 255);
+        }
+    }
+}
+
+uint32_t ParticleSystem::random()
+{
+    return static_cast<uint32_t>(_random.next() >> 32);
+}
+
+void ParticleSystem::explode(const size_t index, const ParticlePhysics& physics)
+{
+    const int32_t x     = _x[index];
+    const int32_t y     = _y[index];
+    const uint8_t red   = (_color[index] & 0xff);
+    const uint8_t green = (_color[index] >> 8);
+
+    for(unsigned spark = 0; spark < physics.burst; ++spark) {
+        /* a random direction in a square, rejected outside the unit disc */
+        int32_t dx, dy;
+        do {
+            dx = static_cast<int32_t>(random() & 0x1ff) - 256;
+            dy = static_cast<int32_t>(random() & 0x1ff) - 256;
+        } while(((dx * dx) + (dy * dy)) > (256 * 256));
+        const int32_t vx = static_cast<int32_t>((static_cast<int64_t>(physics.speed) * dx) >> 8);
+        const int32_t vy = static_cast<int32_t>((static_cast<int64_t>(physics.speed) * dy) >> 8);
+        spawn(ParticleKind::kSPARK, x, y, vx, vy, physics.fade, red, green);
+    }
+}
+
+void ParticleSystem::remove(const size_t index)
+{
+    const size_t last = --_count;
+
+    _x[index]     = _x[last];
+    _y[index]     = _y[last];
+    _vx[index]    = _vx[last];
+    _vy[index]    = _vy[last];
+    _level[index] = _level[last];
+    _decay[index] = _decay[last];
+    _color[index] = _color[last];
+    _kind[index]  = _kind[last];
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
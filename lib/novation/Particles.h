@@ -0,0 +1,165 @@
+/*
+ * Particles.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Particles_h__
+#define __NOVATION_Particles_h__
+
+#include <base/Random.h>
+#include <novation/Temporal.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+enum class ParticleKind : int32_t;
+struct ParticlePhysics;
+class ParticleSystem;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ParticleKind
+//
+//   kSPARK      a plain particle
+//   kDROP       leaves a fading trail particle behind it at every step
+//   kROCKET     explodes into a burst of sparks at the top of its course
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+enum class ParticleKind : int32_t
+{
+    kSPARK  = 0,
+    kDROP   = 1,
+    kROCKET = 2,
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ParticlePhysics
+//
+// The parameters of a simulation step, in 16.16 fixed-point pads per step.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct ParticlePhysics
+{
+    int32_t  gravity; /* added to the vertical velocity             */
+    unsigned drag;    /* v -= v >> drag at each step, 0 for none     */
+    int32_t  trail;   /* brightness lost per step by trail particles */
+    uint8_t  red;     /* red component of the trail particles        */
+    uint8_t  green;   /* green component of the trail particles      */
+    unsigned burst;   /* number of sparks of an exploding rocket     */
+    int32_t  speed;   /* maximum speed of these sparks               */
+    int32_t  fade;    /* brightness lost per step by these sparks    */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ParticleSystem
+//
+// Particles stored as a structure of arrays: position, velocity, brightness,
+// decay, color and kind each live in their own contiguous array, so that a
+// step updates them by batches of 8 in 256-bit vectors. Positions are 16.16
+// fixed-point pads, with the pad centers at integer coordinates, and each
+// particle is splatted bilinearly over the 4 pads around it with additive
+// blending, so that motion is rendered with sub-pad precision.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class ParticleSystem
+{
+public: // public interface
+    ParticleSystem(const size_t capacity, const uint64_t seed);
+
+    virtual ~ParticleSystem();
+
+    void clear();
+
+    bool spawn ( const ParticleKind kind
+               , const int32_t      x
+               , const int32_t      y
+               , const int32_t      vx
+               , const int32_t      vy
+               , const int32_t      decay
+               , const uint8_t      red
+               , const uint8_t      green );
+
+    void update(const ParticlePhysics& physics);
+
+    void render(DeepFrame& frame) const;
+
+    uint32_t random();
+
+    size_t count() const
+    {
+        return _count;
+    }
+
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    uint64_t overflows() const
+    {
+        return _overflows;
+    }
+
+public: // public static data
+    static constexpr int32_t  ONE              = 1 << 16;
+    static constexpr int32_t  BRIGHTNESS       = 255 << 16;
+    static constexpr size_t   LANES            = 8;
+    static constexpr size_t   DEFAULT_CAPACITY = 4096;
+    static constexpr size_t   MAXIMUM_CAPACITY = 1 << 20;
+
+private: // private interface
+    void explode(const size_t index, const ParticlePhysics& physics);
+
+    void remove(const size_t index);
+
+private: // private data
+    const size_t               _capacity;
+    size_t                     _count;
+    std::unique_ptr<int32_t[]> _x;
+    std::unique_ptr<int32_t[]> _y;
+    std::unique_ptr<int32_t[]> _vx;
+    std::unique_ptr<int32_t[]> _vy;
+    std::unique_ptr<int32_t[]> _level;
+    std::unique_ptr<int32_t[]> _decay;
+    std::unique_ptr<int32_t[]> _color;
+    std::unique_ptr<int32_t[]> _kind;
+    base::Random               _random;
+    uint64_t                   _overflows;
+
+private: // disable copy and assignment
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Particles_h__ */
@@ -0,0 +1,880 @@
+/*
+ * Script.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <base/Cpu.h>
+#include <base/MappedFile.h>
+#include "Script.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::sc
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct sc
+{
+    typedef float   vec8f __attribute__((vector_size(32)));
+    typedef int32_t vec8i __attribute__((vector_size(32)));
+
+    static constexpr unsigned PADS  = novation::Script::PADS;
+    static constexpr unsigned LANES = 8;
+
+    enum Opcode : uint8_t
+    {
+        kMOV   = 0,
+        kNEG   = 1,
+        kNOT   = 2,
+        kADD   = 3,
+        kSUB   = 4,
+        kMUL   = 5,
+        kDIV   = 6,
+        kMOD   = 7,
+        kLT    = 8,
+        kLE    = 9,
+        kGT    = 10,
+        kGE    = 11,
+        kEQ    = 12,
+        kNE    = 13,
+        kAND   = 14,
+        kOR    = 15,
+        kSEL   = 16,
+        kSIN   = 17,
+        kCOS   = 18,
+        kABS   = 19,
+        kFLOOR = 20,
+        kFRACT = 21,
+        kSQRT  = 22,
+        kMIN   = 23,
+        kMAX   = 24,
+        kCLAMP = 25,
+        kMIX   = 26,
+        kSTEP  = 27,
+        kDIST  = 28,
+    };
+
+    /* the reserved registers, the variables and temporaries are allocated
+     * upwards from kFIRST, the constants and the variables read before being
+     * assigned downwards from the last one */
+    enum Register : uint8_t
+    {
+        kX     = 0,
+        kY     = 1,
+        kT     = 2,
+        kKEY   = 3,
+        kAGE   = 4,
+        kRAND  = 5,
+        kRED   = 6,
+        kGREEN = 7,
+        kFIRST = 8,
+    };
+
+    struct Function
+    {
+        const char* name;
+        Opcode      opcode;
+        unsigned    arity;
+    };
+
+    static const Function* function(const std::string& name)
+    {
+        static const Function functions[] = {
+            { "sin"  , kSIN   , 1 },
+            { "cos"  , kCOS   , 1 },
+            { "abs"  , kABS   , 1 },
+            { "floor", kFLOOR , 1 },
+            { "fract", kFRACT , 1 },
+            { "sqrt" , kSQRT  , 1 },
+            { "min"  , kMIN   , 2 },
+            { "max"  , kMAX   , 2 },
+            { "clamp", kCLAMP , 3 },
+            { "mix"  , kMIX   , 3 },
+            { "step" , kSTEP  , 2 },
+            { "dist" , kDIST  , 2 },
+        };
+        for(auto& function : functions) {
+            if(name == function.name) {
+                return &function;
+            }
+        }
+        return nullptr;
+    }
+
+    static inline __attribute__((always_inline)) void load(vec8f& vector, const float* array)
+    {
+        ::memcpy(&vector, array, sizeof(vector));
+    }
+
+    static inline __attribute__((always_inline)) void store(const vec8f& vector, float* array)
+    {
+        ::memcpy(array, &vector, sizeof(vector));
+    }
+
+    static inline __attribute__((always_inline)) void boolean(const vec8i& mask, vec8f& result)
+    {
+        const vec8i bits = mask & 0x3f800000;
+        result = reinterpret_cast<vec8f>(bits);
+    }
+
+    static inline __attribute__((always_inline)) void select(const vec8i& mask, const vec8f& a, const vec8f& b, vec8f& result)
+    {
+        const vec8i bits = (reinterpret_cast<vec8i>(a) & mask) | (reinterpret_cast<vec8i>(b) & ~mask);
+        result = reinterpret_cast<vec8f>(bits);
+    }
+
+    static inline __attribute__((always_inline)) void floor(const vec8f& a, vec8f& result)
+    {
+        /* rounds to the nearest integer, then corrects downwards, the
+         * values beyond 2^22 are left as is since they are integers */
+        const float limit   = 4194304.0f;
+        const float magic   = 12582912.0f;
+        const vec8f rounded = (a + magic) - magic;
+        vec8f       above;
+        boolean(rounded > a, above);
+        select((a < limit) & (a > -limit), rounded - above, a, result);
+    }
+
+    static inline __attribute__((always_inline)) void sine(const vec8f& a, vec8f& result)
+    {
+        /* parabolic approximation refined once, within 0.001 of sin(a) */
+        const vec8f turns = a * 0.15915494f;
+        vec8f       whole;
+        floor(turns + 0.5f, whole);
+        const vec8f r = turns - whole;
+        vec8f       y = (r * 8.0f);
+        vec8f       m;
+        absolute(r, m);
+        y -= (r * m) * 16.0f;
+        absolute(y, m);
+        result = ((y * m) - y) * 0.225f + y;
+    }
+
+    static inline __attribute__((always_inline)) void absolute(const vec8f& a, vec8f& result)
+    {
+        const vec8i bits = reinterpret_cast<vec8i>(a) & 0x7fffffff;
+        result = reinterpret_cast<vec8f>(bits);
+    }
+
+    static inline __attribute__((always_inline)) void root(const vec8f& a, vec8f& result)
+    {
+        for(unsigned lane = 0; lane < LANES; ++lane) {
+            result[lane] = (a[lane] > 0.0f ? __builtin_sqrtf(a[lane]) : 0.0f);
+        }
+    }
+
+    static inline __attribute__((always_inline)) void apply(const Opcode opcode, const vec8f& a, const vec8f& b, const vec8f& c, vec8f& r)
+    {
+        vec8f t;
+        switch(opcode) {
+            case kMOV:
+                r = a;
+                break;
+            case kNEG:
+                r = -a;
+                break;
+            case kNOT:
+                boolean(a == 0.0f, r);
+                break;
+            case kADD:
+                r = a + b;
+                break;
+            case kSUB:
+                r = a - b;
+                break;
+            case kMUL:
+                r = a * b;
+                break;
+            case kDIV:
+                r = a / b;
+                break;
+            case kMOD:
+                floor(a / b, t);
+                r = a - (b * t);
+                break;
+            case kLT:
+                boolean(a < b, r);
+                break;
+            case kLE:
+                boolean(a <= b, r);
+                break;
+            case kGT:
+                boolean(a > b, r);
+                break;
+            case kGE:
+                boolean(a >= b, r);
+                break;
+            case kEQ:
+                boolean(a == b, r);
+                break;
+            case kNE:
+                boolean(a != b, r);
+                break;
+            case kAND:
+                boolean((a != 0.0f) & (b != 0.0f), r);
+                break;
+            case kOR:
+                boolean((a != 0.0f) | (b != 0.0f), r);
+                break;
+            case kSEL:
+                select(a != 0.0f, b, c, r);
+                break;
+            case kSIN:
+                sine(a, r);
+                break;
+            case kCOS:
+                sine(a + 1.5707964f, r);
+                break;
+            case kABS:
+                absolute(a, r);
+                break;
+            case kFLOOR:
+                floor(a, r);
+                break;
+            case kFRACT:
+                floor(a, t);
+                r = a - t;
+                break;
+            case kSQRT:
+                root(a, r);
+                break;
+            case kMIN:
+                select(a < b, a, b, r);
+                break;
+            case kMAX:
+                select(a > b, a, b, r);
+                break;
+            case kCLAMP:
+                select(a > b, a, b, t);
+                select(t < c, t, c, r);
+                break;
+            case kMIX:
+                r = a + ((b - a) * c);
+                break;
+            case kSTEP:
+                boolean(b >= a, r);
+                break;
+            case kDIST:
+                root((a * a) + (b * b), r);
+                break;
+        }
+    }
+
+    template <Opcode OPCODE>
+    static inline __attribute__((always_inline)) void run(float* dst, const float* srca, const float* srcb, const float* srcc)
+    {
+        for(unsigned lane = 0; lane < PADS; lane += LANES) {
+            vec8f a, b, c, r;
+            load(a, srca + lane);
+            load(b, srcb + lane);
+            load(c, srcc + lane);
+            apply(OPCODE, a, b, c, r);
+            store(r, dst + lane);
+        }
+    }
+
+    /* one dispatch per instruction, then the whole register in vectors */
+    struct Execute
+    {
+        inline __attribute__((always_inline)) void operator()(const novation::ScriptInstruction* code, const size_t count, float* file) const
+        {
+            for(size_t index = 0; index < count; ++index) {
+                const novation::ScriptInstruction& instruction(code[index]);
+                float*       dst = file + (instruction.dst * PADS);
+                const float* a   = file + (instruction.a * PADS);
+                const float* b   = file + (instruction.b * PADS);
+                const float* c   = file + (instruction.c * PADS);
+                switch(instruction.opcode) {
+                    case kMOV   : run<kMOV   >(dst, a, b, c); break;
+                    case kNEG   : run<kNEG   >(dst, a, b, c); break;
+                    case kNOT   : run<kNOT   >(dst, a, b, c); break;
+                    case kADD   : run<kADD   >(dst, a, b, c); break;
+                    case kSUB   : run<kSUB   >(dst, a, b, c); break;
+                    case kMUL   : run<kMUL   >(dst, a, b, c); break;
+                    case kDIV   : run<kDIV   >(dst, a, b, c); break;
+                    case kMOD   : run<kMOD   >(dst, a, b, c); break;
+                    case kLT    : run<kLT    >(dst, a, b, c); break;
+                    case kLE    : run<kLE    >(dst, a, b, c); break;
+                    case kGT    : run<kGT    >(dst, a, b, c); break;
+                    case kGE    : run<kGE    >(dst, a, b, c); break;
+                    case kEQ    : run<kEQ    >(dst, a, b, c); break;
+                    case kNE    : run<kNE    >(dst, a, b, c); break;
+                    case kAND   : run<kAND   >(dst, a, b, c); break;
+                    case kOR    : run<kOR    >(dst, a, b, c); break;
+                    case kSEL   : run<kSEL   >(dst, a, b, c); break;
+                    case kSIN   : run<kSIN   >(dst, a, b, c); break;
+                    case kCOS   : run<kCOS   >(dst, a, b, c); break;
+                    case kABS   : run<kABS   >(dst, a, b, c); break;
+                    case kFLOOR : run<kFLOOR >(dst, a, b, c); break;
+                    case kFRACT : run<kFRACT >(dst, a, b, c); break;
+                    case kSQRT  : run<kSQRT  >(dst, a, b, c); break;
+                    case kMIN   : run<kMIN   >(dst, a, b, c); break;
+                    case kMAX   : run<kMAX   >(dst, a, b, c); break;
+                    case kCLAMP : run<kCLAMP >(dst, a, b, c); break;
+                    case kMIX   : run<kMIX   >(dst, a, b, c); break;
+                    case kSTEP  : run<kSTEP  >(dst, a, b, c); break;
+                    case kDIST  : run<kDIST  >(dst, a, b, c); break;
+                    default    : break;
+                }
+            }
+        }
+    };
+
+    static void fill(float* reg, const float value)
+    {
+        for(unsigned lane = 0; lane < PADS; ++lane) {
+            reg[lane] = value;
+        }
+    }
+
+    struct Value
+    {
+        bool     constant;
+        float    value;
+        unsigned reg;
+    };
+
+    struct Compiler
+    {
+        enum Token
+        {
+            kEND     = 256,
+            kNEWLINE = 257,
+            kNUMBER  = 258,
+            kNAME    = 259,
+            kLESS    = 260,
+            kGREATER = 261,
+            kEQUAL   = 262,
+            kDIFFER  = 263,
+            kBOTH    = 264,
+            kEITHER  = 265,
+        };
+
+        Compiler ( const std::string&                      name
+                 , const std::string&                      source
+                 , std::vector<novation::ScriptInstruction>& code
+                 , float*                                  file )
+            : name(name)
+            , source(source)
+            , code(code)
+            , file(file)
+            , symbols()
+            , constants()
+            , pending()
+            , cursor(0)
+            , line(1)
+            , where(1)
+            , depth(0)
+            , token(kEND)
+            , text()
+            , number(0.0f)
+            , bottom(kFIRST)
+            , temps(0)
+            , top(novation::Script::MAX_REGISTERS)
+            , random(false)
+        {
+            symbols["x"]     = kX;
+            symbols["y"]     = kY;
+            symbols["t"]     = kT;
+            symbols["key"]   = kKEY;
+            symbols["age"]   = kAGE;
+            symbols["rand"]  = kRAND;
+            symbols["red"]   = kRED;
+            symbols["green"] = kGREEN;
+        }
+
+        void error(const std::string& reason)
+        {
+            throw std::runtime_error(std::string("invalid script") + ' ' + '<' + name + ':' + std::to_string(where) + '>' + ':' + ' ' + reason);
+        }
+
+        void next()
+        {
+            const size_t length = source.size();
+            while(cursor < length) {
+                const char character = source[cursor];
+                if((character == ' ') || (character == '\t') || (character == '\r')) {
+                    ++cursor;
+                }
+                else if(character == '#') {
+                    while((cursor < length) && (source[cursor] != '\n')) {
+                        ++cursor;
+                    }
+                }
+                else if((character == '\n') && (depth > 0)) {
+                    ++cursor;
+                    ++line;
+                }
+                else {
+                    break;
+                }
+            }
+            where = line;
+            if(cursor >= length) {
+                token = kEND;
+                return;
+            }
+            const char* string    = source.c_str() + cursor;
+            const char  character = *string;
+            if(character == '\n') {
+                token = kNEWLINE;
+                ++cursor;
+                ++line;
+            }
+            else if((::isdigit(character) != 0) || ((character == '.') && (::isdigit(string[1]) != 0))) {
+                char* endptr = nullptr;
+                number = ::strtof(string, &endptr);
+                token  = kNUMBER;
+                cursor += (endptr - string);
+            }
+            else if((::isalpha(character) != 0) || (character == '_')) {
+                const char* last = string;
+                while((::isalnum(*last) != 0) || (*last == '_')) {
+                    ++last;
+                }
+                text.assign(string, last);
+                token  = kNAME;
+                cursor += (last - string);
+            }
+            else {
+                static const struct { const char* text; int token; } pairs[] = {
+                    { "<=", kLESS    },
+                    { ">=", kGREATER },
+                    { "==", kEQUAL   },
+                    { "!=", kDIFFER  },
+                    { "&&", kBOTH    },
+                    { "||", kEITHER  },
+                };
+                for(auto& pair : pairs) {
+                    if(::strncmp(string, pair.text, 2) == 0) {
+                        token  = pair.token;
+                        cursor += 2;
+                        return;
+                    }
+                }
+                if(::strchr("+-*/%<>!?:=(),;", character) == nullptr) {
+                    error(std::string("unexpected character") + ' ' + '\'' + character + '\'');
+                }
+                if(character == '(') {
+                    ++depth;
+                }
+                else if((character == ')') && (depth > 0)) {
+                    --depth;
+                }
+                token = character;
+                ++cursor;
+            }
+        }
+
+        void expect(const int expected, const char* what)
+        {
+            if(token != expected) {
+                error(std::string("expected") + ' ' + what);
+            }
+            next();
+        }
+
+        void program()
+        {
+            next();
+            while(token != kEND) {
+                if((token != kNEWLINE) && (token != ';')) {
+                    statement();
+                    if((token != kNEWLINE) && (token != ';') && (token != kEND)) {
+                        error("expected the end of the statement");
+                    }
+                }
+                if(token != kEND) {
+                    next();
+                }
+            }
+            if(code.empty()) {
+                error("no statement");
+            }
+            if(pending.empty() == false) {
+                auto first = pending.begin();
+                for(auto read = pending.begin(); read != pending.end(); ++read) {
+                    if(read->second < first->second) {
+                        first = read;
+                    }
+                }
+                where = first->second;
+                error(std::string("unknown variable") + ' ' + first->first);
+            }
+        }
+
+        void statement()
+        {
+            if(token != kNAME) {
+                error("expected an assignment");
+            }
+            const std::string target(text);
+            next();
+            expect('=', "'='");
+            if((target == "pi") || (function(target) != nullptr)) {
+                error(std::string("cannot assign to") + ' ' + target);
+            }
+            const Value    value = expression();
+            const auto     found = symbols.find(target);
+            const bool     fresh = (found == symbols.end());
+            const unsigned reg   = (fresh ? bottom : found->second);
+            if((fresh == false) && (reg < kRED)) {
+                error(std::string("cannot assign to") + ' ' + target);
+            }
+            static_cast<void>(pending.erase(target));
+            if(value.constant) {
+                emit(kMOV, reg, materialize(value), 0, 0);
+            }
+            else if((value.reg >= bottom) && (value.reg < top) && (code.empty() == false) && (code.back().dst == value.reg)) {
+                code.back().dst = static_cast<uint8_t>(reg);
+            }
+            else if(value.reg != reg) {
+                emit(kMOV, reg, value.reg, 0, 0);
+            }
+            temps = 0;
+            if(fresh) {
+                symbols[target] = reg;
+                if(++bottom > top) {
+                    error("too many variables and constants");
+                }
+            }
+        }
+
+        Value expression()
+        {
+            const Value condition = disjunction();
+            if(token != '?') {
+                return condition;
+            }
+            next();
+            const Value a = expression();
+            expect(':', "':'");
+            const Value b = expression();
+            return operation(kSEL, 3, condition, a, b);
+        }
+
+        Value disjunction()
+        {
+            Value value = conjunction();
+            while(token == kEITHER) {
+                next();
+                value = operation(kOR, 2, value, conjunction());
+            }
+            return value;
+        }
+
+        Value conjunction()
+        {
+            Value value = comparison();
+            while(token == kBOTH) {
+                next();
+                value = operation(kAND, 2, value, comparison());
+            }
+            return value;
+        }
+
+        Value comparison()
+        {
+            Value value = sum();
+            for(;;) {
+                Opcode opcode;
+                switch(token) {
+                    case '<'     : opcode = kLT; break;
+                    case kLESS   : opcode = kLE; break;
+                    case '>'     : opcode = kGT; break;
+                    case kGREATER: opcode = kGE; break;
+                    case kEQUAL  : opcode = kEQ; break;
+                    case kDIFFER : opcode = kNE; break;
+                    default      : return value;
+                }
+                next();
+                value = operation(opcode, 2, value, sum());
+            }
+        }
+
+        Value sum()
+        {
+            Value value = product();
+            while((token == '+') || (token == '-')) {
+                const Opcode opcode = (token == '+' ? kADD : kSUB);
+                next();
+                value = operation(opcode, 2, value, product());
+            }
+            return value;
+        }
+
+        Value product()
+        {
+            Value value = unary();
+            while((token == '*') || (token == '/') || (token == '%')) {
+                const Opcode opcode = (token == '*' ? kMUL : (token == '/' ? kDIV : kMOD));
+                next();
+                value = operation(opcode, 2, value, unary());
+            }
+            return value;
+        }
+
+        Value unary()
+        {
+            if(token == '-') {
+                next();
+                return operation(kNEG, 1, unary());
+            }
+            if(token == '!') {
+                next();
+                return operation(kNOT, 1, unary());
+            }
+            if(token == '+') {
+                next();
+                return unary();
+            }
+            return primary();
+        }
+
+        Value primary()
+        {
+            if(token == kNUMBER) {
+                const Value value { true, number, 0 };
+                next();
+                return value;
+            }
+            if(token == '(') {
+                next();
+                const Value value = expression();
+                expect(')', "')'");
+                return value;
+            }
+            if(token != kNAME) {
+                error("expected an expression");
+            }
+            const std::string name(text);
+            const unsigned    used = where;
+            next();
+            if(token == '(') {
+                const Function* callee = function(name);
+                if(callee == nullptr) {
+                    error(std::string("unknown function") + ' ' + name);
+                }
+                next();
+                Value args[3] = { { true, 0.0f, 0 }, { true, 0.0f, 0 }, { true, 0.0f, 0 } };
+                for(unsigned index = 0; index < callee->arity; ++index) {
+                    if(index != 0) {
+                        expect(',', "','");
+                    }
+                    args[index] = expression();
+                }
+                expect(')', "')'");
+                return operation(callee->opcode, callee->arity, args[0], args[1], args[2]);
+            }
+            if(name == "pi") {
+                return Value { true, 3.14159265f, 0 };
+            }
+            auto found = symbols.find(name);
+            if(found == symbols.end()) {
+                /* read before being assigned: starts at 0 and keeps the value
+                 * of the previous frame, but must be assigned somewhere */
+                if(function(name) != nullptr) {
+                    error(std::string("expected '(' after") + ' ' + name);
+                }
+                if(--top < (bottom + temps)) {
+                    error("too many variables and constants");
+                }
+                found = symbols.emplace(name, top).first;
+                pending[name] = used;
+            }
+            if(found->second == kRAND) {
+                random = true;
+            }
+            return Value { false, 0.0f, found->second };
+        }
+
+        unsigned materialize(const Value& value)
+        {
+            if(value.constant == false) {
+                return value.reg;
+            }
+            uint32_t bits;
+            ::memcpy(&bits, &value.value, sizeof(bits));
+            const auto found = constants.find(bits);
+            if(found != constants.end()) {
+                return found->second;
+            }
+            if(--top < (bottom + temps)) {
+                error("too many variables and constants");
+            }
+            fill(file + (top * PADS), value.value);
+            constants[bits] = top;
+            return top;
+        }
+
+        void release(const Value& value)
+        {
+            if((value.constant == false) && (value.reg >= bottom)) {
+                --temps;
+            }
+        }
+
+        void emit(const Opcode opcode, const unsigned dst, const unsigned a, const unsigned b, const unsigned c)
+        {
+            code.push_back(novation::ScriptInstruction { opcode, static_cast<uint8_t>(dst), static_cast<uint8_t>(a), static_cast<uint8_t>(b), static_cast<uint8_t>(c) });
+        }
+
+        Value operation(const Opcode opcode, const unsigned arity, const Value& a, const Value& b = Value { true, 0.0f, 0 }, const Value& c = Value { true, 0.0f, 0 })
+        {
+            /* constant operands are folded with the code of the VM itself */
+            if(a.constant && b.constant && c.constant) {
+                float scratch[4 * PADS];
+                fill(scratch + (0 * PADS), a.value);
+                fill(scratch + (1 * PADS), b.value);
+                fill(scratch + (2 * PADS), c.value);
+                const novation::ScriptInstruction instruction { opcode, 3, 0, 1, 2 };
+                base::Cpu::dispatch<Execute>(&instruction, 1, scratch);
+                return Value { true, scratch[3 * PADS], 0 };
+            }
+            const unsigned ra = materialize(a);
+            const unsigned rb = (arity > 1 ? materialize(b) : ra);
+            const unsigned rc = (arity > 2 ? materialize(c) : ra);
+            release(c);
+            release(b);
+            release(a);
+            const unsigned dst = bottom + temps++;
+            if(dst >= top) {
+                error("expression is too complex");
+            }
+            emit(opcode, dst, ra, rb, rc);
+            return Value { false, 0.0f, dst };
+        }
+
+        const std::string&                        name;
+        const std::string&                        source;
+        std::vector<novation::ScriptInstruction>& code;
+        float*                                    file;
+        std::map<std::string, unsigned>           symbols;
+        std::map<uint32_t, unsigned>              constants;
+        std::map<std::string, unsigned>           pending;
+        size_t                                    cursor;
+        unsigned                                  line;
+        unsigned                                  where;
+        unsigned                                  depth;
+        int                                       token;
+        std::string                               text;
+        float                                     number;
+        unsigned                                  bottom;
+        unsigned                                  temps;
+        unsigned                                  top;
+        bool                                      random;
+    };
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Script
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+Script::Script(const std::string& name, const std::string& source, const uint64_t seed)
+    : _name(name)
+    , _code()
+    , _file(new float[MAX_REGISTERS * PADS]())
+    , _registers(0)
+    , _random(false)
+    , _generator(seed)
+    , _now(0.0)
+    , _down()
+    , _strike()
+{
+    sc::Compiler compiler(_name, source, _code, _file.get());
+
+    compiler.program();
+    _registers = compiler.bottom + (MAX_REGISTERS - compiler.top);
+    _random    = compiler.random;
+    for(unsigned pad = 0; pad < PADS; ++pad) {
+        _file[(sc::kX * PADS) + pad] = static_cast<float>(pad % DeepFrame::COLS);
+        _file[(sc::kY * PADS) + pad] = static_cast<float>(pad / DeepFrame::COLS);
+        _strike[pad] = -1000000.0;
+    }
+}
+
+Script::~Script()
+{
+}
+
+std::string Script::read(const std::string& path)
+{
+    const base::MappedFile file(path);
+
+    return std::string(reinterpret_cast<const char*>(file.data()), file.size());
+}
+
+void Script::press(const uint8_t row, const uint8_t col, const bool down)
+{
+    const unsigned pad = (row % DeepFrame::ROWS) * DeepFrame::COLS + (col % DeepFrame::COLS);
+
+    _down[pad] = down;
+    if(down) {
+        _strike[pad] = _now;
+    }
+}
+
+void Script::evaluate(DeepFrame& frame, const double time)
+{
+    float* const file  = _file.get();
+    float* const key   = file + (sc::kKEY   * PADS);
+    float* const age   = file + (sc::kAGE   * PADS);
+    float* const rand  = file + (sc::kRAND  * PADS);
+    float* const red   = file + (sc::kRED   * PADS);
+    float* const green = file + (sc::kGREEN * PADS);
+
+    _now = time;
+    sc::fill(file + (sc::kT * PADS), static_cast<float>(time));
+    for(unsigned pad = 0; pad < PADS; ++pad) {
+        key[pad] = (_down[pad] ? 1.0f : 0.0f);
+        age[pad] = static_cast<float>(time - _strike[pad]);
+        red[pad] = green[pad] = 0.0f;
+    }
+    if(_random) {
+        /* 24 bits per value */
+        for(unsigned pad = 0; pad < PADS; ++pad) {
+            rand[pad] = static_cast<float>(_generator.next() >> 40) * (1.0f / 16777216.0f);
+        }
+    }
+    base::Cpu::dispatch<sc::Execute>(_code.data(), _code.size(), file);
+    for(unsigned pad = 0; pad < PADS; ++pad) {
+        const float r = red[pad];
+        const float g = green[pad];
+        frame.red[pad / DeepFrame::COLS][pad % DeepFrame::COLS]   = static_cast<uint8_t>(r > 0.0f ? (r < 1.0f ? (r * 255.0f) + 0.5f : 255.0f) : 0.0f);
+        frame.green[pad / DeepFrame::COLS][pad % DeepFrame::COLS] = static_cast<uint8_t>(g > 0.0f ? (g < 1.0f ? (g * 255.0f) + 0.5f : 255.0f) : 0.0f);
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,132 @@
+/*
+ * Script.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Script_h__
+#define __NOVATION_Script_h__
+
+#include <memory>
+#include <base/Random.h>
+#include <novation/Temporal.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct ScriptInstruction;
+class Script;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ScriptInstruction
+//
+// A register-based instruction: dst = opcode(a, b, c), where every register
+// holds one value per pad.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct ScriptInstruction
+{
+    uint8_t opcode;
+    uint8_t dst;
+    uint8_t a;
+    uint8_t b;
+    uint8_t c;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Script
+//
+// An animation written as a few assignments of expressions, where each pad
+// gets its color from the 'red' and 'green' variables (0 to 1):
+//
+//   # a red ring spreading from the center
+//   d     = dist(x - 3.5, y - 3.5)
+//   red   = clamp(1 - abs(d - fract(t) * 6), 0, 1)
+//   green = key
+//
+// The inputs are the pad coordinates 'x' and 'y' (0 to 7), the time 't' in
+// seconds, 'key' (1 while the pad is pressed), 'age' (seconds since the pad
+// was last pressed) and 'rand' (a uniform value from a seeded stream). The
+// operators are those of C, with comparisons and logical operators giving 0
+// or 1, and the functions are sin, cos, abs, floor, fract, sqrt, min, max,
+// clamp, mix, step and dist. Variables keep their value between frames: one
+// read before being assigned, as in 'n = n + 1', gives 0 on the first frame
+// and the value of the previous frame after that.
+//
+// The script is parsed once and compiled, with constant folding and a stack
+// allocation of the temporaries, into a register-based bytecode. Since every
+// register holds the 64 pads, each instruction is dispatched once per frame
+// and runs over the whole grid in 256-bit vectors.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class Script
+{
+public: // public interface
+    Script(const std::string& name, const std::string& source, const uint64_t seed);
+
+    virtual ~Script();
+
+    static std::string read(const std::string& path);
+
+    void press(const uint8_t row, const uint8_t col, const bool down);
+
+    void evaluate(DeepFrame& frame, const double time);
+
+    const std::vector<ScriptInstruction>& code() const
+    {
+        return _code;
+    }
+
+    unsigned registers() const
+    {
+        return _registers;
+    }
+
+public: // public static data
+    static constexpr unsigned PADS          = DeepFrame::ROWS * DeepFrame::COLS;
+    static constexpr unsigned MAX_REGISTERS = 64;
+
+private: // private data
+    const std::string              _name;
+    std::vector<ScriptInstruction> _code;
+    std::unique_ptr<float[]>       _file;
+    unsigned                       _registers;
+    bool                           _random;
+    base::Random                   _generator;
+    double                         _now;
+    bool                           _down[PADS];
+    double                         _strike[PADS];
+
+private: // disable copy and assignment
+    Script(const Script&) = delete;
+    Script& operator=(const Script&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Script_h__ */
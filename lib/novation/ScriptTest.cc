@@ -0,0 +1,115 @@
+/*
+ * ScriptTest.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include "Script.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::st
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct st
+{
+    /* evaluates one frame per expected value and checks the red level of a pad */
+    static bool check(const std::string& source, const std::vector<uint8_t>& expected, const uint8_t row = 0, const uint8_t col = 0)
+    {
+        novation::Script    script("test", source, 1);
+        novation::DeepFrame frame;
+        double              time = 0.0;
+
+        for(auto& level : expected) {
+            script.evaluate(frame, time);
+            if(frame.red[row][col] != level) {
+                std::cerr << '<' << source << '>' << ": red " << static_cast<unsigned>(frame.red[row][col]) << " at " << time << "s instead of " << static_cast<unsigned>(level) << std::endl;
+                return false;
+            }
+            time += 0.25;
+        }
+        return true;
+    }
+
+    /* checks that the source is rejected */
+    static bool reject(const std::string& source)
+    {
+        try {
+            novation::Script script("test", source, 1);
+        }
+        catch(const std::runtime_error&) {
+            return true;
+        }
+        std::cerr << '<' << source << '>' << ": accepted" << std::endl;
+        return false;
+    }
+
+    /* the value of the previous frame follows the pad pressed in between */
+    static bool previous()
+    {
+        novation::Script    script("test", "red = last\nlast = key", 1);
+        novation::DeepFrame frame;
+
+        script.evaluate(frame, 0.0);
+        script.press(2, 3, true);
+        script.evaluate(frame, 0.1);
+        if(frame.red[2][3] != 0) {
+            std::cerr << "the press is seen before the next frame" << std::endl;
+            return false;
+        }
+        script.evaluate(frame, 0.2);
+        if((frame.red[2][3] != 255) || (frame.red[3][2] != 0)) {
+            std::cerr << "the press is not seen on the next frame" << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// main
+// ---------------------------------------------------------------------------
+
+int main()
+{
+    bool success = true;
+
+    success &= st::check("a = 0.5\nred = a", { 128, 128 });
+    success &= st::check("n = n + 1\nred = n / 4", { 64, 128, 191, 255 });
+    success &= st::check("red = n / 4; n = n + 1", { 0, 64, 128, 191 });
+    success &= st::check("red = s; s = s + t", { 0, 0, 64, 191 });
+    success &= st::check("n = n + 1; c = n; red = c / 4", { 64, 128, 191, 255 });
+    success &= st::previous();
+    success &= st::reject("red = nope");
+    success &= st::reject("red = n; m = 1");
+    success &= st::reject("red = sin");
+    return (success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
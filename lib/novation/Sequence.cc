@@ -0,0 +1,296 @@
+/*
+ * Sequence.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <base/Endian.h>
+#include "Sequence.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::le
+// ---------------------------------------------------------------------------
+
+namespace {
+
+using le = base::LittleEndian;
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::seq
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct seq
+{
+    static constexpr size_t RECORD_SIZE = 2 + 8;
+
+    static void invalid(const std::string& reason)
+    {
+        throw std::runtime_error(std::string("invalid sequence file") + ':' + ' ' + reason);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::SequenceReader
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+SequenceReader::SequenceReader(Launchpad& launchpad, const std::string& path)
+    : _file(path)
+    , _begin(_file.data())
+    , _end(_file.data() + _file.size())
+    , _index(nullptr)
+    , _cursor(nullptr)
+    , _frames(0)
+    , _interval(0)
+    , _position(0)
+    , _duration(0)
+    , _palette()
+    , _colors(0)
+{
+    const size_t size = _file.size();
+
+    if(size < Sequence::HEADER_SIZE) {
+        seq::invalid("truncated header");
+    }
+    if(le::get32(_begin + 0) != Sequence::MAGIC) {
+        seq::invalid("bad magic");
+    }
+    if(le::get16(_begin + 4) != Sequence::FORMAT_VERSION) {
+        seq::invalid("unsupported version");
+    }
+    _colors   = le::get16(_begin +  6);
+    _frames   = le::get32(_begin +  8);
+    _interval = le::get16(_begin + 12);
+
+    const uint64_t index_offset  = le::get32(_begin + 16);
+    const uint64_t frames_offset = le::get32(_begin + 20);
+    const uint64_t index_count   = (_interval != 0 ? (static_cast<uint64_t>(_frames) + _interval - 1) / _interval : 0);
+
+    if((_colors == 0) || (_colors > Sequence::MAX_PALETTE)) {
+        seq::invalid("bad palette size");
+    }
+    if(_interval == 0) {
+        seq::invalid("bad keyframe interval");
+    }
+    if((Sequence::HEADER_SIZE + _colors * Sequence::PALETTE_ENTRY) > size) {
+        seq::invalid("truncated palette");
+    }
+    if((index_offset + index_count * 4) > size) {
+        seq::invalid("truncated index");
+    }
+    if(frames_offset > size) {
+        seq::invalid("truncated frames");
+    }
+    for(uint16_t color = 0; color < _colors; ++color) {
+        const uint8_t* entry = _begin + Sequence::HEADER_SIZE + color * Sequence::PALETTE_ENTRY;
+        _palette[color] = launchpad.makeColor(entry[0], entry[1]);
+    }
+    _index  = _begin + index_offset;
+    _cursor = _begin + frames_offset;
+}
+
+SequenceReader::~SequenceReader()
+{
+}
+
+bool SequenceReader::next(Frame& frame)
+{
+    if(_position < _frames) {
+        decode(frame);
+        ++_position;
+        return true;
+    }
+    return false;
+}
+
+void SequenceReader::seek(const uint32_t index, Frame& frame)
+{
+    if(index >= _frames) {
+        throw std::runtime_error("sequence seek out of range");
+    }
+    const uint32_t keyframe = index / _interval;
+    const uint32_t offset   = le::get32(_index + keyframe * 4);
+
+    if(offset >= _file.size()) {
+        seq::invalid("bad index entry");
+    }
+    _cursor   = _begin + offset;
+    _position = keyframe * _interval;
+    do {
+        decode(frame);
+    } while(_position++ < index);
+}
+
+void SequenceReader::decode(Frame& frame)
+{
+    if((_end - _cursor) < static_cast<ptrdiff_t>(seq::RECORD_SIZE)) {
+        seq::invalid("truncated frame");
+    }
+    const uint16_t duration = le::get16(_cursor + 0);
+    uint64_t       mask     = le::get64(_cursor + 2);
+    const uint8_t* pixels   = _cursor + seq::RECORD_SIZE;
+    const int      count    = __builtin_popcountll(mask);
+
+    if((_end - pixels) < count) {
+        seq::invalid("truncated frame");
+    }
+    uint8_t* data = &frame.data[0][0];
+    while(mask != 0) {
+        const int pad = __builtin_ctzll(mask);
+        data[pad] = _palette[*pixels++];
+        mask &= (mask - 1);
+    }
+    _cursor   = pixels;
+    _duration = duration;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::SequenceWriter
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+SequenceWriter::SequenceWriter(const uint16_t interval)
+    : _interval(interval != 0 ? interval : Sequence::DEFAULT_INTERVAL)
+    , _palette()
+    , _data()
+    , _index()
+    , _frames(0)
+    , _previous()
+{
+    _previous.fill(0x00);
+}
+
+SequenceWriter::~SequenceWriter()
+{
+}
+
+uint8_t SequenceWriter::color(const uint8_t red, const uint8_t green)
+{
+    const size_t count = _palette.size() / Sequence::PALETTE_ENTRY;
+
+    for(size_t index = 0; index < count; ++index) {
+        const uint8_t* entry = &_palette[index * Sequence::PALETTE_ENTRY];
+        if((entry[0] == red) && (entry[1] == green)) {
+            return static_cast<uint8_t>(index);
+        }
+    }
+    if(count >= Sequence::MAX_PALETTE) {
+        throw std::runtime_error("sequence palette is full");
+    }
+    _palette.push_back(red);
+    _palette.push_back(green);
+
+    return static_cast<uint8_t>(count);
+}
+
+void SequenceWriter::add(const Frame& indices, const uint16_t duration)
+{
+    const uint8_t* curr = &indices.data[0][0];
+    const uint8_t* prev = &_previous.data[0][0];
+    uint64_t       mask = 0;
+
+    if((_frames % _interval) == 0) {
+        _index.push_back(_data.size());
+        mask = Sequence::FULL_MASK;
+    }
+    else for(int pad = 0; pad < (Frame::ROWS * Frame::COLS); ++pad) {
+        if(curr[pad] != prev[pad]) {
+            mask |= (1ULL << pad);
+        }
+    }
+    le::put16(_data, duration);
+    le::put64(_data, mask);
+    for(int pad = 0; pad < (Frame::ROWS * Frame::COLS); ++pad) {
+        if((mask & (1ULL << pad)) != 0) {
+            le::put8(_data, curr[pad]);
+        }
+    }
+    _previous = indices;
+    ++_frames;
+}
+
+void SequenceWriter::save(const std::string& path) const
+{
+    const size_t colors        = (_palette.size() > 0 ? _palette.size() / Sequence::PALETTE_ENTRY : 1);
+    const size_t frames_offset = Sequence::HEADER_SIZE + colors * Sequence::PALETTE_ENTRY;
+    const size_t index_offset  = frames_offset + _data.size();
+    std::vector<uint8_t> head;
+
+    if((index_offset + _index.size() * 4) > UINT32_MAX) {
+        throw std::runtime_error("sequence is too large");
+    }
+    /* header */ {
+        le::put32(head, Sequence::MAGIC);
+        le::put16(head, Sequence::FORMAT_VERSION);
+        le::put16(head, colors);
+        le::put32(head, _frames);
+        le::put16(head, _interval);
+        le::put16(head, 0);
+        le::put32(head, index_offset);
+        le::put32(head, frames_offset);
+        le::put32(head, 0);
+        le::put32(head, 0);
+    }
+    /* palette */ {
+        head.insert(head.end(), _palette.begin(), _palette.end());
+        if(_palette.empty()) {
+            le::put16(head, 0);
+        }
+    }
+    std::vector<uint8_t> tail;
+    /* index */ {
+        for(auto offset : _index) {
+            le::put32(tail, frames_offset + offset);
+        }
+    }
+    FILE* file = ::fopen(path.c_str(), "wb");
+    if(file == nullptr) {
+        throw std::runtime_error(std::string("unable to create") + ' ' + '<' + path + '>');
+    }
+    bool success = true;
+    success &= (::fwrite(head.data(), 1, head.size(), file) == head.size());
+    success &= (::fwrite(_data.data(), 1, _data.size(), file) == _data.size());
+    success &= (::fwrite(tail.data(), 1, tail.size(), file) == tail.size());
+    success &= (::fclose(file) == 0);
+    if(success == false) {
+        throw std::runtime_error(std::string("unable to write") + ' ' + '<' + path + '>');
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,155 @@
+/*
+ * Sequence.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Sequence_h__
+#define __NOVATION_Sequence_h__
+
+#include <base/MappedFile.h>
+#include <novation/Frame.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Sequence;
+class SequenceReader;
+class SequenceWriter;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Sequence
+//
+// All integers are little-endian.
+//
+//   header   32 bytes  magic "LPSQ", version, palette size, frame count,
+//                      keyframe interval, index offset, frames offset
+//   palette  2 bytes   per entry (red, green)
+//   frames   variable  u16 duration (ms), u64 changed pads mask, then one
+//                      palette index per changed pad, in row-major order
+//   index    4 bytes   per keyframe, offset of frames 0, N, 2N, ...
+//
+// Every N-th frame is a keyframe: its mask has all 64 bits set, so any
+// frame is reachable from the closest keyframe with less than N deltas.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Sequence
+{
+    static constexpr uint32_t MAGIC            = 0x5153504c; /* "LPSQ" */
+    static constexpr uint16_t FORMAT_VERSION   = 1;
+    static constexpr size_t   HEADER_SIZE      = 32;
+    static constexpr size_t   PALETTE_ENTRY    = 2;
+    static constexpr size_t   MAX_PALETTE      = 256;
+    static constexpr uint16_t DEFAULT_INTERVAL = 64;
+    static constexpr uint64_t FULL_MASK        = ~0ULL;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::SequenceReader
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class SequenceReader
+{
+public: // public interface
+    SequenceReader(Launchpad& launchpad, const std::string& path);
+
+    virtual ~SequenceReader();
+
+    bool next(Frame& frame);
+
+    void seek(const uint32_t index, Frame& frame);
+
+    uint32_t frames() const
+    {
+        return _frames;
+    }
+
+    uint32_t position() const
+    {
+        return _position;
+    }
+
+    uint16_t duration() const
+    {
+        return _duration;
+    }
+
+private: // private interface
+    void decode(Frame& frame);
+
+private: // private data
+    const base::MappedFile _file;
+    const uint8_t*         _begin;
+    const uint8_t*         _end;
+    const uint8_t*         _index;
+    const uint8_t*         _cursor;
+    uint32_t               _frames;
+    uint16_t               _interval;
+    uint32_t               _position;
+    uint16_t               _duration;
+    uint8_t                _palette[Sequence::MAX_PALETTE];
+    uint16_t               _colors;
+
+private: // disable copy and assignment
+    SequenceReader(const SequenceReader&) = delete;
+    SequenceReader& operator=(const SequenceReader&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::SequenceWriter
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class SequenceWriter
+{
+public: // public interface
+    SequenceWriter(const uint16_t interval = Sequence::DEFAULT_INTERVAL);
+
+    virtual ~SequenceWriter();
+
+    uint8_t color(const uint8_t red, const uint8_t green);
+
+    void add(const Frame& indices, const uint16_t duration);
+
+    void save(const std::string& path) const;
+
+private: // private data
+    const uint16_t        _interval;
+    std::vector<uint8_t>  _palette;
+    std::vector<uint8_t>  _data;
+    std::vector<uint32_t> _index;
+    uint32_t              _frames;
+    Frame                 _previous;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Sequence_h__ */
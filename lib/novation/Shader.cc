@@ -0,0 +1,360 @@
+/*
+ * Shader.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <stdexcept>
+#include <base/Cpu.h>
+#include <base/Random.h>
+#include "Shader.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::sh
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct sh
+{
+    typedef int32_t vec8 __attribute__((vector_size(32)));
+
+    typedef void (*Palette)(const unsigned value, uint8_t& red, uint8_t& green);
+
+    static constexpr unsigned ROWS    = novation::DeepFrame::ROWS;
+    static constexpr unsigned LANES   = novation::DeepFrame::COLS;
+    static constexpr int32_t  ONE     = novation::Shader::ONE;
+    static constexpr unsigned SINES   = 1024;
+    static constexpr int32_t  PHASE   = SINES - 1;
+    static constexpr int32_t  REACH   = 63;
+    static constexpr int32_t  PERIOD  = (novation::Shader::LATTICE * ONE) - 1;
+    static constexpr int32_t  LATTICE = novation::Shader::LATTICE - 1;
+
+    struct Tables
+    {
+        uint8_t  sine[SINES];                    /* biased sine of a phase, 0 to 254      */
+        uint16_t distance[REACH + 1][REACH + 1]; /* 8.8 pads, by |dy| and |dx| half-pads */
+        uint8_t  fade[256];                      /* smoothstep of an 8-bit fraction       */
+    };
+
+    struct Context
+    {
+        const Tables&  tables;
+        const uint8_t* lattice;
+        const uint32_t ticks;
+        const int32_t  cx;
+        const int32_t  cy;
+    };
+
+    static const Tables& tables()
+    {
+        static const Tables tables(build());
+
+        return tables;
+    }
+
+    static Tables build()
+    {
+        const double pi = 3.14159265358979323846;
+        Tables       tables;
+
+        for(unsigned index = 0; index < SINES; ++index) {
+            tables.sine[index] = static_cast<uint8_t>(std::lround(127.0 + 127.0 * std::sin((2.0 * pi * index) / SINES)));
+        }
+        for(int32_t dy = 0; dy <= REACH; ++dy) {
+            for(int32_t dx = 0; dx <= REACH; ++dx) {
+                tables.distance[dy][dx] = static_cast<uint16_t>(std::lround(std::sqrt(static_cast<double>((dx * dx) + (dy * dy))) * (ONE / 2)));
+            }
+        }
+        for(unsigned index = 0; index < 256; ++index) {
+            const double t = index / 256.0;
+            tables.fade[index] = static_cast<uint8_t>(std::lround(255.0 * t * t * (3.0 - 2.0 * t)));
+        }
+        return tables;
+    }
+
+    /* a phase offset growing by 'mul / 2^shift' turns per second */
+    static int32_t phase(const uint32_t ticks, const uint32_t mul, const unsigned shift)
+    {
+        return static_cast<int32_t>(((ticks * mul) >> shift) & PHASE);
+    }
+
+    /* a noise offset growing by 'mul / 2^shift' * 4 pads per second */
+    static int32_t offset(const uint32_t ticks, const uint32_t mul, const unsigned shift)
+    {
+        return static_cast<int32_t>(((ticks * mul) >> shift) & PERIOD);
+    }
+
+    static uint8_t clamp(const int32_t value)
+    {
+        return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+
+    static inline __attribute__((always_inline)) void gather(const uint8_t* table, const vec8& index, vec8& result)
+    {
+        for(unsigned lane = 0; lane < LANES; ++lane) {
+            result[lane] = table[index[lane]];
+        }
+    }
+
+    static inline __attribute__((always_inline)) void sine(const Context& context, const vec8& phase, vec8& result)
+    {
+        gather(context.tables.sine, phase & PHASE, result);
+    }
+
+    static inline __attribute__((always_inline)) void distance(const Context& context, const vec8& dx, const vec8& dy, vec8& result)
+    {
+        const vec8 ax = ((dx ^ (dx >> 31)) - (dx >> 31)) >> 7;
+        const vec8 ay = ((dy ^ (dy >> 31)) - (dy >> 31)) >> 7;
+
+        for(unsigned lane = 0; lane < LANES; ++lane) {
+            result[lane] = context.tables.distance[ay[lane] < REACH ? ay[lane] : REACH][ax[lane] < REACH ? ax[lane] : REACH];
+        }
+    }
+
+    /* bilinear value noise over a lattice of one cell per pad */
+    static inline __attribute__((always_inline)) void noise(const Context& context, const vec8& x, const vec8& y, vec8& result)
+    {
+        const uint8_t* lattice(context.lattice);
+        const vec8     xi = (x >> 8) & LATTICE;
+        const vec8     yi = (y >> 8) & LATTICE;
+        vec8           a, b, c, d;
+        vec8           u, v;
+
+        for(unsigned lane = 0; lane < LANES; ++lane) {
+            const int32_t x0 = xi[lane];
+            const int32_t x1 = (x0 + 1) & LATTICE;
+            const int32_t y0 = yi[lane];
+            const int32_t y1 = (y0 + 1) & LATTICE;
+            a[lane] = lattice[(lattice[x0] + y0) & LATTICE];
+            b[lane] = lattice[(lattice[x1] + y0) & LATTICE];
+            c[lane] = lattice[(lattice[x0] + y1) & LATTICE];
+            d[lane] = lattice[(lattice[x1] + y1) & LATTICE];
+        }
+        gather(context.tables.fade, x & 255, u);
+        gather(context.tables.fade, y & 255, v);
+        const vec8 top    = a + (((b - a) * u) >> 8);
+        const vec8 bottom = c + (((d - c) * u) >> 8);
+        result = top + (((bottom - top) * v) >> 8);
+    }
+
+    /* the kernel of base::Cpu::dispatch(), one column per lane */
+    template <typename Effect>
+    struct Shade
+    {
+        inline __attribute__((always_inline)) void operator()(const uint8_t* lattice, const uint32_t ticks, const int32_t cx, const int32_t cy, uint8_t* values) const
+        {
+            const Context context { tables(), lattice, ticks, cx, cy };
+            vec8 x;
+            for(unsigned lane = 0; lane < LANES; ++lane) {
+                x[lane] = static_cast<int32_t>(lane) * ONE;
+            }
+            for(unsigned row = 0; row < ROWS; ++row) {
+                const vec8 y = vec8() + static_cast<int32_t>(row) * ONE;
+                vec8       value;
+                Effect::shade(context, x, y, value);
+                for(unsigned lane = 0; lane < LANES; ++lane) {
+                    *values++ = clamp(value[lane]);
+                }
+            }
+        }
+    };
+
+    template <typename Effect>
+    static void program(const uint8_t* lattice, const uint32_t ticks, const int32_t cx, const int32_t cy, uint8_t* values)
+    {
+        base::Cpu::dispatch<Shade<Effect>>(lattice, ticks, cx, cy, values);
+    }
+
+    struct Plasma
+    {
+        static inline __attribute__((always_inline)) void shade(const Context& context, const vec8& x, const vec8& y, vec8& value)
+        {
+            const int32_t orbit = phase(context.ticks, 1, 3);
+            const int32_t cx    = context.cx + (((context.tables.sine[orbit] - 127) * 3 * ONE) / 127);
+            const int32_t cy    = context.cy + (((context.tables.sine[(orbit + (SINES / 4)) & PHASE] - 127) * 3 * ONE) / 127);
+            vec8 p1, p2, p3, p4, d;
+
+            sine(context, ((x * 96) >> 8) + phase(context.ticks, 1, 1), p1);
+            sine(context, ((y * 80) >> 8) - phase(context.ticks, 3, 2), p2);
+            sine(context, (((x + y) * 56) >> 8) + phase(context.ticks, 1, 2), p3);
+            distance(context, x - cx, y - cy, d);
+            sine(context, ((d * 192) >> 8) - phase(context.ticks, 1, 0), p4);
+            value = (p1 + p2 + p3 + p4) >> 2;
+        }
+
+        static void palette(const unsigned value, uint8_t& red, uint8_t& green)
+        {
+            const double pi    = 3.14159265358979323846;
+            const double angle = (2.0 * pi * value) / 256.0;
+
+            red   = static_cast<uint8_t>(std::lround(127.5 + 127.5 * std::sin(angle)));
+            green = static_cast<uint8_t>(std::lround(127.5 + 127.5 * std::sin(angle + (2.0 * pi / 3.0))));
+        }
+    };
+
+    struct Fire
+    {
+        static inline __attribute__((always_inline)) void shade(const Context& context, const vec8& x, const vec8& y, vec8& value)
+        {
+            const int32_t rise = offset(context.ticks, 3, 2);
+            vec8 n1, n2;
+
+            noise(context, x, y + rise, n1);
+            noise(context, (x * 2) + (97 * ONE), (y * 2) + (rise * 2), n2);
+            /* hotter at the bottom, where y is the largest */
+            const vec8 heat = ((((n1 * 2) + n2) / 3) * (y + ONE)) >> 11;
+            value = ((heat * 3) >> 1) - 32;
+        }
+
+        static void palette(const unsigned value, uint8_t& red, uint8_t& green)
+        {
+            red   = static_cast<uint8_t>(value < 85 ? value * 3 : 255);
+            green = static_cast<uint8_t>(value < 128 ? 0 : (value - 128) * 2);
+        }
+    };
+
+    struct Waves
+    {
+        static inline __attribute__((always_inline)) void shade(const Context& context, const vec8& x, const vec8& y, vec8& value)
+        {
+            vec8 d, s;
+
+            distance(context, x - context.cx, y - context.cy, d);
+            /* a wavelength of 3 pads moving at 3 pads per second */
+            sine(context, ((d * 341) >> 8) - phase(context.ticks, 1, 0), s);
+            value = (s * ((9 * ONE) - d)) >> 11;
+        }
+
+        static void palette(const unsigned value, uint8_t& red, uint8_t& green)
+        {
+            red   = static_cast<uint8_t>((value * value) / 255);
+            green = static_cast<uint8_t>(value);
+        }
+    };
+
+    struct Noise
+    {
+        static inline __attribute__((always_inline)) void shade(const Context& context, const vec8& x, const vec8& y, vec8& value)
+        {
+            vec8 n1, n2, n3;
+
+            noise(context, x + offset(context.ticks, 1, 2), y + offset(context.ticks, 1, 3), n1);
+            noise(context, (x * 2) + (PERIOD - offset(context.ticks, 1, 2)), (y * 2) + (53 * ONE), n2);
+            noise(context, (x * 4) + (29 * ONE), (y * 4) + offset(context.ticks, 1, 1), n3);
+            value = ((n1 * 2) + n2 + n3) >> 2;
+        }
+
+        static void palette(const unsigned value, uint8_t& red, uint8_t& green)
+        {
+            red   = static_cast<uint8_t>(value);
+            green = static_cast<uint8_t>(255 - value);
+        }
+    };
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Shader
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+Shader::Shader(const std::string& effect, const uint64_t seed)
+    : _effect(effect)
+    , _program(nullptr)
+    , _cx((7 * ONE) / 2)
+    , _cy((7 * ONE) / 2)
+    , _lattice()
+    , _red()
+    , _green()
+    , _values()
+{
+    sh::Palette palette = nullptr;
+
+    if(effect == "plasma") {
+        _program = &sh::program<sh::Plasma>;
+        palette  = &sh::Plasma::palette;
+    }
+    else if(effect == "fire") {
+        _program = &sh::program<sh::Fire>;
+        palette  = &sh::Fire::palette;
+    }
+    else if(effect == "waves") {
+        _program = &sh::program<sh::Waves>;
+        palette  = &sh::Waves::palette;
+    }
+    else if(effect == "noise") {
+        _program = &sh::program<sh::Noise>;
+        palette  = &sh::Noise::palette;
+    }
+    else {
+        throw std::runtime_error(std::string("unknown effect") + ' ' + '<' + effect + '>');
+    }
+    for(unsigned level = 0; level < LEVELS; ++level) {
+        palette(level, _red[level], _green[level]);
+    }
+    /* the noise lattice is a seeded permutation (Fisher-Yates) */
+    base::Random generator(seed);
+    for(unsigned index = 0; index < LATTICE; ++index) {
+        _lattice[index] = static_cast<uint8_t>(index);
+    }
+    for(unsigned index = LATTICE - 1; index > 0; --index) {
+        const unsigned other = static_cast<unsigned>(generator.below(index + 1));
+        std::swap(_lattice[index], _lattice[other]);
+    }
+}
+
+Shader::~Shader()
+{
+}
+
+void Shader::focus(const uint8_t row, const uint8_t col)
+{
+    _cx = col * ONE;
+    _cy = row * ONE;
+}
+
+void Shader::render(DeepFrame& frame, const uint64_t time)
+{
+    const uint32_t ticks = static_cast<uint32_t>((time * TICKS) / 1000000UL);
+
+    (*_program)(_lattice, ticks, _cx, _cy, _values);
+
+    const uint8_t* value = _values;
+    for(uint8_t row = 0; row < DeepFrame::ROWS; ++row) {
+        for(uint8_t col = 0; col < DeepFrame::COLS; ++col) {
+            frame.red[row][col]   = _red[*value];
+            frame.green[row][col] = _green[*value];
+            ++value;
+        }
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,98 @@
+/*
+ * Shader.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Shader_h__
+#define __NOVATION_Shader_h__
+
+#include <novation/Temporal.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class Shader;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Shader
+//
+// A procedural effect computed as a function of (x, y, t) for every pad:
+//
+//   plasma      interfering sine waves around a moving center
+//   fire        value noise scrolling upwards, hotter at the bottom
+//   waves       radial waves spreading from the focus
+//   noise       drifting fractal value noise
+//
+// Each effect is a template argument of the rendering loop, which is then
+// instantiated once per effect: a row of 8 pads is evaluated at a time in a
+// 256-bit vector of 8.8 fixed-point values, with precomputed sine, distance
+// and smoothstep tables instead of floating-point functions. The resulting
+// intensities go through a 256-entry palette of the effect.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class Shader
+{
+public: // public interface
+    Shader(const std::string& effect, const uint64_t seed);
+
+    virtual ~Shader();
+
+    void focus(const uint8_t row, const uint8_t col);
+
+    void render(DeepFrame& frame, const uint64_t time);
+
+    const std::string& effect() const
+    {
+        return _effect;
+    }
+
+public: // public static data
+    static constexpr int32_t  ONE     = 1 << 8;
+    static constexpr uint64_t TICKS   = 1024;
+    static constexpr unsigned PADS    = DeepFrame::ROWS * DeepFrame::COLS;
+    static constexpr unsigned LEVELS  = 256;
+    static constexpr unsigned LATTICE = 256;
+
+private: // private interface
+    typedef void (*Program)(const uint8_t* lattice, const uint32_t ticks, const int32_t cx, const int32_t cy, uint8_t* values);
+
+private: // private data
+    const std::string _effect;
+    Program           _program;
+    int32_t           _cx;
+    int32_t           _cy;
+    uint8_t           _lattice[LATTICE];
+    uint8_t           _red[LEVELS];
+    uint8_t           _green[LEVELS];
+    uint8_t           _values[PADS];
+
+private: // disable copy and assignment
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Shader_h__ */
@@ -0,0 +1,473 @@
+/*
+ * Spectrum.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "Spectrum.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::sp
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct sp
+{
+    using clock = std::chrono::steady_clock;
+
+    static constexpr int POLL_TIMEOUT = 100;
+
+    static int open(const std::string& path)
+    {
+        if(path.empty() || (path == "-")) {
+            return STDIN_FILENO;
+        }
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) {
+            throw std::runtime_error(std::string("unable to open") + ' ' + '<' + path + '>' + ':' + ' ' + ::strerror(errno));
+        }
+        return fd;
+    }
+
+    /* only a regular file can be read faster than it is played */
+    static bool regular(const int fd)
+    {
+        struct stat st;
+        if(::fstat(fd, &st) != 0) {
+            return false;
+        }
+        return S_ISREG(st.st_mode);
+    }
+
+    /* bytes already waiting in a pipe */
+    static size_t pending(const int fd)
+    {
+        int count = 0;
+        if(::ioctl(fd, FIONREAD, &count) != 0) {
+            return 0;
+        }
+        return (count > 0 ? static_cast<size_t>(count) : 0);
+    }
+
+    /* reads and forgets whole blocks, so that the frames stay aligned */
+    static bool skip(const int fd, uint8_t* data, const size_t block, size_t blocks)
+    {
+        for(; blocks != 0; --blocks) {
+            size_t rest = block;
+            while(rest != 0) {
+                const ssize_t got = ::read(fd, data, rest);
+                if(got > 0) {
+                    rest -= got;
+                    continue;
+                }
+                if((got < 0) && (errno == EINTR)) {
+                    continue;
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static uint64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(clock::now().time_since_epoch()).count();
+    }
+
+    static bool power_of_two(const unsigned value)
+    {
+        return (value != 0) && ((value & (value - 1)) == 0);
+    }
+
+    /* mixes interleaved frames down to mono samples */
+    static void convert(const uint8_t* data, const size_t count, const novation::PcmFormat format, const unsigned channels, float* output)
+    {
+        const float scale = 1.0f / static_cast<float>(channels);
+
+        for(size_t index = 0; index < count; ++index) {
+            float sum = 0.0f;
+            for(unsigned channel = 0; channel < channels; ++channel) {
+                if(format == novation::PcmFormat::kS16) {
+                    const int16_t value = static_cast<int16_t>(data[0] | (data[1] << 8));
+                    sum  += static_cast<float>(value) * (1.0f / 32768.0f);
+                    data += 2;
+                }
+                else {
+                    float value;
+                    ::memcpy(&value, data, sizeof(value));
+                    sum  += (std::isfinite(value) ? value : 0.0f);
+                    data += 4;
+                }
+            }
+            output[index] = sum * scale;
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::RealFFT
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+RealFFT::RealFFT(const unsigned size)
+    : _size(size)
+    , _half(size / 2)
+    , _reverse(_half)
+    , _cos(_half + 1)
+    , _sin(_half + 1)
+    , _re(_half)
+    , _im(_half)
+{
+    if((size < 4) || (sp::power_of_two(size) == false)) {
+        throw std::runtime_error("invalid FFT size");
+    }
+    unsigned bits = 0;
+    while((1U << bits) < _half) {
+        ++bits;
+    }
+    for(unsigned index = 0; index < _half; ++index) {
+        unsigned reversed = 0;
+        for(unsigned bit = 0; bit < bits; ++bit) {
+            reversed |= ((index >> bit) & 1) << (bits - 1 - bit);
+        }
+        _reverse[index] = reversed;
+    }
+    /* W^k = cos - i.sin of 2.pi.k/N, the N/2-point FFT uses the even ones */
+    const double pi = 3.14159265358979323846;
+    for(unsigned index = 0; index <= _half; ++index) {
+        _cos[index] = static_cast<float>(std::cos((2.0 * pi * index) / _size));
+        _sin[index] = static_cast<float>(std::sin((2.0 * pi * index) / _size));
+    }
+}
+
+RealFFT::~RealFFT()
+{
+}
+
+void RealFFT::power(const float* input, float* output)
+{
+    float* const re = _re.data();
+    float* const im = _im.data();
+
+    for(unsigned index = 0; index < _half; ++index) {
+        re[_reverse[index]] = input[(2 * index) + 0];
+        im[_reverse[index]] = input[(2 * index) + 1];
+    }
+    for(unsigned length = 2; length <= _half; length <<= 1) {
+        const unsigned half   = length / 2;
+        const unsigned stride = _size / length;
+        for(unsigned start = 0; start < _half; start += length) {
+            for(unsigned index = 0; index < half; ++index) {
+                const unsigned a  = start + index;
+                const unsigned b  = a + half;
+                const float    wr = _cos[index * stride];
+                const float    ws = _sin[index * stride];
+                const float    tr = (re[b] * wr) + (im[b] * ws);
+                const float    ti = (im[b] * wr) - (re[b] * ws);
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+    /* X[k] = E[k] + W^k.O[k], with E and O the spectra of the even and odd samples */
+    for(unsigned index = 0; index <= _half; ++index) {
+        const unsigned k  = (index < _half ? index : 0);
+        const unsigned c  = (index > 0 ? _half - index : 0);
+        const float    zr = re[k];
+        const float    zi = im[k];
+        const float    cr = re[c];
+        const float    ci = -im[c];
+        const float    er = 0.5f * (zr + cr);
+        const float    ei = 0.5f * (zi + ci);
+        const float    or_ = 0.5f * (zi - ci);
+        const float    oi = -0.5f * (zr - cr);
+        const float    wr = _cos[index];
+        const float    ws = _sin[index];
+        const float    xr = er + (or_ * wr) + (oi * ws);
+        const float    xi = ei + (oi * wr) - (or_ * ws);
+        output[index] = (xr * xr) + (xi * xi);
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::SpectrumAnalyzer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+SpectrumAnalyzer::SpectrumAnalyzer(const unsigned rate, const unsigned size)
+    : _rate(rate)
+    , _size(size)
+    , _hop(size / OVERLAP)
+    , _step(static_cast<float>(size / OVERLAP) / static_cast<float>(rate))
+    , _fft(size)
+    , _window(size)
+    , _samples(size)
+    , _input(size)
+    , _power((size / 2) + 1)
+    , _edges()
+    , _head(0)
+    , _pending(0)
+    , _level()
+    , _peak()
+    , _hold()
+    , _sequence(0)
+{
+    if((size < MINIMUM_SIZE) || (size > MAXIMUM_SIZE)) {
+        throw std::runtime_error("invalid FFT size");
+    }
+    const double pi = 3.14159265358979323846;
+    for(unsigned index = 0; index < _size; ++index) {
+        _window[index] = static_cast<float>(0.5 - 0.5 * std::cos((2.0 * pi * index) / _size));
+    }
+    /* the bins of each band, at least one per band */
+    const double   highest = (MAX_FREQUENCY < (rate / 2.0) ? MAX_FREQUENCY : (rate / 2.0));
+    const unsigned bins    = (_size / 2) + 1;
+    for(unsigned band = 0; band <= BANDS; ++band) {
+        const double   frequency = MIN_FREQUENCY * std::pow(highest / MIN_FREQUENCY, static_cast<double>(band) / BANDS);
+        const unsigned bin       = static_cast<unsigned>(std::ceil((frequency * _size) / rate));
+        _edges[band] = (bin < 1 ? 1 : (bin > bins ? bins : bin));
+        if((band > 0) && (_edges[band] <= _edges[band - 1]) && (_edges[band - 1] < bins)) {
+            _edges[band] = _edges[band - 1] + 1;
+        }
+    }
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+}
+
+bool SpectrumAnalyzer::push(const float* samples, const size_t count)
+{
+    bool analyzed = false;
+
+    for(size_t index = 0; index < count; ++index) {
+        _samples[_head] = samples[index];
+        if(++_head >= _size) {
+            _head = 0;
+        }
+        if(++_pending >= _hop) {
+            _pending = 0;
+            analyze();
+            analyzed = true;
+        }
+    }
+    return analyzed;
+}
+
+void SpectrumAnalyzer::bars(SpectrumBars& bars) const
+{
+    for(unsigned band = 0; band < BANDS; ++band) {
+        bars.level[band] = _level[band];
+        bars.peak[band]  = _peak[band];
+    }
+    bars.sequence = _sequence;
+}
+
+void SpectrumAnalyzer::analyze()
+{
+    /* the oldest sample is at the head of the ring */
+    for(unsigned index = 0; index < _size; ++index) {
+        const size_t sample = (_head + index) % _size;
+        _input[index] = _window[index] * _samples[sample];
+    }
+    _fft.power(_input.data(), _power.data());
+
+    /* a full-scale sine peaks at (N/4)^2 through a Hann window */
+    const float reference = static_cast<float>(_size / 4) * static_cast<float>(_size / 4);
+    for(unsigned band = 0; band < BANDS; ++band) {
+        float energy = 0.0f;
+        for(unsigned bin = _edges[band]; bin < _edges[band + 1]; ++bin) {
+            energy += _power[bin];
+        }
+        const float decibels = 10.0f * std::log10((energy / reference) + 1e-12f);
+        float       value    = 1.0f + (decibels / static_cast<float>(RANGE));
+        value = (value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value));
+
+        float& level(_level[band]);
+        float& peak(_peak[band]);
+        float& hold(_hold[band]);
+        const float fallen = level - static_cast<float>(FALL_RATE) * _step;
+        level = (value > fallen ? value : fallen);
+        if(level >= peak) {
+            peak = level;
+            hold = static_cast<float>(PEAK_HOLD);
+        }
+        else if(hold > 0.0f) {
+            hold -= _step;
+        }
+        else {
+            const float dropped = peak - static_cast<float>(PEAK_FALL_RATE) * _step;
+            peak = (dropped > level ? dropped : level);
+        }
+    }
+    ++_sequence;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::SpectrumStream
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+SpectrumStream::SpectrumStream ( const std::string& path
+                               , const PcmFormat    format
+                               , const unsigned     rate
+                               , const unsigned     channels
+                               , const unsigned     size )
+    : _path(path.empty() ? std::string("-") : path)
+    , _fd(sp::open(path))
+    , _paced(sp::regular(_fd))
+    , _format(format)
+    , _rate(rate)
+    , _channels(channels)
+    , _analyzer(rate, size)
+    , _mutex()
+    , _bars()
+    , _fetched(0)
+    , _error()
+    , _stop(false)
+    , _finished(false)
+    , _thread()
+{
+    _thread = std::thread(&SpectrumStream::run, this);
+}
+
+SpectrumStream::~SpectrumStream()
+{
+    _stop = true;
+    if(_thread.joinable()) {
+        _thread.join();
+    }
+    if(_fd != STDIN_FILENO) {
+        static_cast<void>(::close(_fd));
+    }
+}
+
+bool SpectrumStream::fetch(SpectrumBars& bars)
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+
+    if(_error) {
+        std::rethrow_exception(_error);
+    }
+    if(_bars.sequence == _fetched) {
+        return false;
+    }
+    bars     = _bars;
+    _fetched = _bars.sequence;
+    return true;
+}
+
+void SpectrumStream::run()
+{
+    try {
+        const size_t         bytes = (_format == PcmFormat::kS16 ? 2 : 4) * _channels;
+        const size_t         block = _analyzer.hop() * bytes;
+        std::vector<uint8_t> buffer(block);
+        std::vector<uint8_t> scratch(_paced ? 0 : block);
+        std::vector<float>   samples(_analyzer.hop());
+        size_t               filled = 0;
+        uint64_t             played = 0;
+        sp::clock::time_point start;
+
+        while(_stop == false) {
+            struct pollfd pfd = { _fd, POLLIN, 0 };
+            const int rc = ::poll(&pfd, 1, sp::POLL_TIMEOUT);
+            if(rc == 0) {
+                continue;
+            }
+            if((rc < 0) && (errno != EINTR)) {
+                throw std::runtime_error(std::string("unable to read") + ' ' + '<' + _path + '>' + ':' + ' ' + ::strerror(errno));
+            }
+            /* a live source got ahead of the analysis, only its newest hop is kept */
+            if((rc > 0) && (_paced == false)) {
+                const size_t behind = sp::pending(_fd) / block;
+                if((behind > 1) && (sp::skip(_fd, scratch.data(), block, behind - 1) == false)) {
+                    break;
+                }
+            }
+            const ssize_t got = (rc > 0 ? ::read(_fd, buffer.data() + filled, block - filled) : -1);
+            if(got == 0) {
+                break;
+            }
+            if(got < 0) {
+                if((errno == EINTR) || (errno == EAGAIN)) {
+                    continue;
+                }
+                throw std::runtime_error(std::string("unable to read") + ' ' + '<' + _path + '>' + ':' + ' ' + ::strerror(errno));
+            }
+            filled += got;
+            const size_t count = filled / bytes;
+            if(count == 0) {
+                continue;
+            }
+            sp::convert(buffer.data(), count, _format, _channels, samples.data());
+            filled -= count * bytes;
+            ::memmove(buffer.data(), buffer.data() + (count * bytes), filled);
+            if(played == 0) {
+                start = sp::clock::now();
+            }
+            if(_analyzer.push(samples.data(), count)) {
+                const std::lock_guard<std::mutex> lock(_mutex);
+                _analyzer.bars(_bars);
+                _bars.time = sp::now();
+            }
+            /* a file is played in real time, a pipe as fast as it is fed */
+            played += count;
+            if(_paced) {
+                std::this_thread::sleep_until(start + std::chrono::microseconds((played * 1000000UL) / _rate));
+            }
+        }
+    }
+    catch(...) {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _error = std::current_exception();
+    }
+    _finished = true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
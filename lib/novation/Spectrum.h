@@ -0,0 +1,249 @@
+/*
+ * Spectrum.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Spectrum_h__
+#define __NOVATION_Spectrum_h__
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <exception>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+enum class PcmFormat : uint8_t;
+struct SpectrumBars;
+class RealFFT;
+class SpectrumAnalyzer;
+class SpectrumStream;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::PcmFormat
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+enum class PcmFormat : uint8_t
+{
+    kS16 = 0, /* signed 16-bit little-endian integers */
+    kF32 = 1, /* 32-bit native floats, from -1 to 1   */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::SpectrumBars
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct SpectrumBars
+{
+    static constexpr unsigned BANDS = 8;
+
+    float    level[BANDS]; /* from 0 to 1, over the displayed range of decibels */
+    float    peak[BANDS];  /* the held peaks of the levels                       */
+    uint64_t sequence;     /* number of analyses so far                          */
+    uint64_t time;         /* steady clock time of the analysis, in microseconds */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::RealFFT
+//
+// The power spectrum of N real samples computed with a complex FFT of N/2
+// points: the even and odd samples are packed as real and imaginary parts,
+// transformed with an iterative radix-2 FFT, then separated again with a
+// last twiddle pass. Bit reversal and twiddles are precomputed.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class RealFFT
+{
+public: // public interface
+    RealFFT(const unsigned size);
+
+    virtual ~RealFFT();
+
+    void power(const float* input, float* output);
+
+    unsigned size() const
+    {
+        return _size;
+    }
+
+private: // private data
+    const unsigned        _size;
+    const unsigned        _half;
+    std::vector<uint32_t> _reverse;
+    std::vector<float>    _cos;
+    std::vector<float>    _sin;
+    std::vector<float>    _re;
+    std::vector<float>    _im;
+
+private: // disable copy and assignment
+    RealFFT(const RealFFT&) = delete;
+    RealFFT& operator=(const RealFFT&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::SpectrumAnalyzer
+//
+// Runs a Hann-windowed FFT every HOP samples over the last N samples, then
+// sums the power of the bins into 8 bands spaced logarithmically from 40Hz
+// to 16kHz. The bars rise immediately, fall at a constant rate, and their
+// peaks are held for a moment before falling too. The time is measured in
+// samples, so that the result does not depend on the reading speed.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class SpectrumAnalyzer
+{
+public: // public interface
+    SpectrumAnalyzer(const unsigned rate, const unsigned size);
+
+    virtual ~SpectrumAnalyzer();
+
+    bool push(const float* samples, const size_t count);
+
+    void bars(SpectrumBars& bars) const;
+
+    unsigned hop() const
+    {
+        return _hop;
+    }
+
+public: // public static data
+    static constexpr unsigned BANDS          = SpectrumBars::BANDS;
+    static constexpr unsigned DEFAULT_SIZE   = 1024;
+    static constexpr unsigned MINIMUM_SIZE   = 256;
+    static constexpr unsigned MAXIMUM_SIZE   = 16384;
+    static constexpr unsigned OVERLAP        = 4;
+    static constexpr double   MIN_FREQUENCY  = 40.0;
+    static constexpr double   MAX_FREQUENCY  = 16000.0;
+    static constexpr double   RANGE          = 60.0;
+    static constexpr double   FALL_RATE      = 1.5;
+    static constexpr double   PEAK_HOLD      = 0.5;
+    static constexpr double   PEAK_FALL_RATE = 0.5;
+
+private: // private interface
+    void analyze();
+
+private: // private data
+    const unsigned        _rate;
+    const unsigned        _size;
+    const unsigned        _hop;
+    const float           _step;
+    RealFFT               _fft;
+    std::vector<float>    _window;
+    std::vector<float>    _samples;
+    std::vector<float>    _input;
+    std::vector<float>    _power;
+    unsigned              _edges[BANDS + 1];
+    size_t                _head;
+    size_t                _pending;
+    float                 _level[BANDS];
+    float                 _peak[BANDS];
+    float                 _hold[BANDS];
+    uint64_t              _sequence;
+
+private: // disable copy and assignment
+    SpectrumAnalyzer(const SpectrumAnalyzer&) = delete;
+    SpectrumAnalyzer& operator=(const SpectrumAnalyzer&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::SpectrumStream
+//
+// Reads raw PCM from a file or the standard input in a thread of its own,
+// by blocks of one hop, and feeds the analyzer. A regular file is paced by
+// the sample rate, so that it is played in real time, whereas a pipe is read
+// as fast as the data arrives, and when it got more than one hop ahead the
+// older hops are dropped so that the newest one is analyzed. The memory used
+// is bounded whatever the stream. Only the latest bars are kept for the
+// display, which never waits for the analysis.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class SpectrumStream
+{
+public: // public interface
+    SpectrumStream ( const std::string& path
+                   , const PcmFormat    format
+                   , const unsigned     rate
+                   , const unsigned     channels
+                   , const unsigned     size );
+
+    virtual ~SpectrumStream();
+
+    bool fetch(SpectrumBars& bars);
+
+    bool finished() const
+    {
+        return _finished.load();
+    }
+
+public: // public static data
+    static constexpr unsigned DEFAULT_RATE     = 44100;
+    static constexpr unsigned MINIMUM_RATE     = 8000;
+    static constexpr unsigned MAXIMUM_RATE     = 192000;
+    static constexpr unsigned MAXIMUM_CHANNELS = 8;
+
+private: // private interface
+    void run();
+
+private: // private data
+    const std::string  _path;
+    const int          _fd;
+    const bool         _paced;
+    const PcmFormat    _format;
+    const unsigned     _rate;
+    const unsigned     _channels;
+    SpectrumAnalyzer   _analyzer;
+    std::mutex         _mutex;
+    SpectrumBars       _bars;
+    uint64_t           _fetched;
+    std::exception_ptr _error;
+    std::atomic<bool>  _stop;
+    std::atomic<bool>  _finished;
+    std::thread        _thread;
+
+private: // disable copy and assignment
+    SpectrumStream(const SpectrumStream&) = delete;
+    SpectrumStream& operator=(const SpectrumStream&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Spectrum_h__ */
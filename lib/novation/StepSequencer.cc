@@ -0,0 +1,242 @@
+/*
+ * StepSequencer.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <pthread.h>
+#include <sched.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "StepSequencer.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ss
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ss
+{
+    using clock = std::chrono::steady_clock;
+
+    /* the scheduler spins for the last part of every wait, at least SPIN */
+    static constexpr clock::duration SPIN     = std::chrono::microseconds(500);
+    static constexpr clock::duration MAX_SPIN = std::chrono::milliseconds(5);
+    static constexpr clock::duration SLICE    = std::chrono::milliseconds(50);
+    static constexpr clock::duration LEAD     = std::chrono::milliseconds(10);
+
+    static constexpr uint8_t CONTROLLER_ALL_NOTES_OFF = 0x7b;
+
+    static clock::duration period(const unsigned tempo)
+    {
+        if((tempo < novation::StepSequencer::MINIMUM_TEMPO) || (tempo > novation::StepSequencer::MAXIMUM_TEMPO)) {
+            throw std::runtime_error("invalid tempo");
+        }
+        return std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds(60000000000ULL / (tempo * novation::StepSequencer::STEPS_PER_BEAT)));
+    }
+
+    static clock::duration gate(const unsigned tempo, const unsigned gate)
+    {
+        if((gate < 1) || (gate > 100)) {
+            throw std::runtime_error("invalid gate");
+        }
+        return (period(tempo) * gate) / 100;
+    }
+
+    static bool realtime()
+    {
+        struct sched_param param;
+        ::memset(&param, 0, sizeof(param));
+        param.sched_priority = ::sched_get_priority_min(SCHED_FIFO);
+        return ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param) == 0;
+    }
+
+    static uint8_t channel(const uint8_t channel)
+    {
+        if(channel > 15) {
+            throw std::runtime_error("invalid channel");
+        }
+        return channel;
+    }
+};
+
+constexpr ss::clock::duration ss::SPIN;
+constexpr ss::clock::duration ss::MAX_SPIN;
+constexpr ss::clock::duration ss::SLICE;
+constexpr ss::clock::duration ss::LEAD;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::StepSequencer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+constexpr uint8_t StepSequencer::NOTES[];
+
+StepSequencer::StepSequencer ( const std::string& name
+                             , const std::string& port
+                             , const unsigned     tempo
+                             , const unsigned     gate
+                             , const uint8_t      channel )
+    : _output(new RtMidiOut(RtMidi::UNSPECIFIED, name))
+    , _period(ss::period(tempo))
+    , _gate(ss::gate(tempo, gate))
+    , _channel(ss::channel(channel))
+    , _pattern(0)
+    , _playhead(-1)
+    , _stop(false)
+    , _realtime(false)
+    , _spin(ss::SPIN)
+    , _jitter()
+    , _thread()
+{
+    if(port.empty()) {
+        _output->openVirtualPort(name + ' ' + "sequencer");
+    }
+    else if(Midi::open(*_output, port, name + ' ' + "sequencer") == false) {
+        throw std::runtime_error("*** unable to open MIDI output ***");
+    }
+}
+
+StepSequencer::~StepSequencer()
+{
+    stop();
+    static_cast<void>(Midi::close(*_output));
+}
+
+void StepSequencer::start()
+{
+    if(_thread.joinable() == false) {
+        _stop = false;
+        _thread = std::thread(&StepSequencer::run, this);
+    }
+}
+
+void StepSequencer::stop()
+{
+    _stop = true;
+    if(_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void StepSequencer::toggle(const uint8_t step, const uint8_t track)
+{
+    static_cast<void>(_pattern.fetch_xor(bit(step, track)));
+}
+
+bool StepSequencer::wait(const clock::time_point deadline)
+{
+    /* sleep by slices to stay responsive to stop(), then spin to the deadline */
+    for(;;) {
+        if(_stop) {
+            return false;
+        }
+        const clock::time_point now  = clock::now();
+        const clock::time_point wake = deadline - _spin;
+        if(now >= wake) {
+            break;
+        }
+        const clock::time_point until = ((wake - now) > ss::SLICE ? now + ss::SLICE : wake);
+        std::this_thread::sleep_until(until);
+        if(until == wake) {
+            /* the spin covers the worst oversleep seen, which slowly decays */
+            const clock::duration oversleep = clock::now() - wake;
+            const clock::duration decayed   = _spin - (_spin / 64);
+            const clock::duration wanted    = oversleep + ss::SPIN;
+            _spin = (wanted > decayed ? wanted : decayed);
+            _spin = (_spin < ss::SPIN ? ss::SPIN : (_spin > ss::MAX_SPIN ? ss::MAX_SPIN : _spin));
+        }
+    }
+    while(clock::now() < deadline) {
+        continue;
+    }
+    return true;
+}
+
+void StepSequencer::send(const uint8_t* messages, const unsigned count, const clock::time_point deadline)
+{
+    for(unsigned index = 0; index < count; ++index, messages += 3) {
+        const clock::duration lateness = clock::now() - deadline;
+        _output->sendMessage(messages, 3);
+        _jitter.record(lateness.count() > 0 ? std::chrono::duration_cast<std::chrono::microseconds>(lateness).count() : 0);
+    }
+}
+
+void StepSequencer::run()
+{
+    _realtime = ss::realtime();
+
+    const clock::time_point origin = clock::now() + ss::LEAD;
+    uint8_t                 on[TRACKS * 3];
+    uint8_t                 off[TRACKS * 3];
+    unsigned                sounding = 0;
+
+    for(uint64_t index = 0; _stop == false; ++index) {
+        const uint8_t           step     = (index % STEPS);
+        const clock::time_point deadline = origin + (_period * static_cast<clock::rep>(index));
+        const uint64_t          pattern  = _pattern.load();
+        unsigned                count    = 0;
+
+        /* the messages are ready before the deadline */
+        for(uint8_t track = 0; track < TRACKS; ++track) {
+            if((pattern & bit(step, track)) != 0) {
+                uint8_t* message = &on[count * 3];
+                message[0] = Midi::CHANNEL_01_NOTE_ON | _channel;
+                message[1] = NOTES[track];
+                message[2] = VELOCITY;
+                message = &off[count * 3];
+                message[0] = Midi::CHANNEL_01_NOTE_OFF | _channel;
+                message[1] = NOTES[track];
+                message[2] = 0;
+                ++count;
+            }
+        }
+        if(wait(deadline) == false) {
+            break;
+        }
+        send(on, count, deadline);
+        sounding = count;
+        _playhead.store(step);
+        if(count != 0) {
+            if(wait(deadline + _gate) == false) {
+                break;
+            }
+            send(off, count, deadline + _gate);
+            sounding = 0;
+        }
+    }
+    for(unsigned index = 0; index < sounding; ++index) {
+        _output->sendMessage(&off[index * 3], 3);
+    }
+    Midi::send(*_output, Midi::CHANNEL_01_CONTROL_CHANGE | _channel, ss::CONTROLLER_ALL_NOTES_OFF, 0);
+    _playhead.store(-1);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,146 @@
+/*
+ * StepSequencer.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_StepSequencer_h__
+#define __NOVATION_StepSequencer_h__
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <novation/Midi.h>
+#include <novation/Jitter.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class StepSequencer;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::StepSequencer
+//
+// An 8-track by 8-step pattern played on a MIDI output of its own, a virtual
+// port by default. Every step is due at an absolute deadline computed from
+// the start time, so that the tempo never drifts. The messages of a step are
+// prepared ahead of time, then the scheduler thread sleeps until shortly
+// before the deadline and spins for the rest, and sends them at the exact
+// time. The spin adapts to the worst oversleep of the system, and the thread
+// asks for a real-time priority, which is optional. The lateness of every
+// message is measured.
+//
+// The pattern and the playhead are atomics: the input thread toggles steps
+// and the display polls the playhead, neither ever blocks the scheduler.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class StepSequencer
+{
+public: // public interface
+    StepSequencer ( const std::string& name
+                  , const std::string& port
+                  , const unsigned     tempo
+                  , const unsigned     gate
+                  , const uint8_t      channel );
+
+    virtual ~StepSequencer();
+
+    void start();
+
+    void stop();
+
+    void toggle(const uint8_t step, const uint8_t track);
+
+    bool active(const uint8_t step, const uint8_t track) const
+    {
+        return (_pattern.load() & bit(step, track)) != 0;
+    }
+
+    uint64_t pattern() const
+    {
+        return _pattern.load();
+    }
+
+    int playhead() const
+    {
+        return _playhead.load();
+    }
+
+    const JitterMeter& jitter() const
+    {
+        return _jitter;
+    }
+
+    bool realtime() const
+    {
+        return _realtime;
+    }
+
+public: // public static data
+    static constexpr unsigned STEPS          = 8;
+    static constexpr unsigned TRACKS         = 8;
+    static constexpr unsigned STEPS_PER_BEAT = 4;
+    static constexpr unsigned DEFAULT_TEMPO  = 120;
+    static constexpr unsigned MINIMUM_TEMPO  = 20;
+    static constexpr unsigned MAXIMUM_TEMPO  = 300;
+    static constexpr unsigned DEFAULT_GATE   = 50;
+    static constexpr uint8_t  CHANNEL        = 9;
+    static constexpr uint8_t  VELOCITY       = 100;
+    static constexpr uint8_t  NOTES[TRACKS]  = { 36, 38, 42, 46, 39, 45, 48, 49 };
+
+private: // private interface
+    using clock = std::chrono::steady_clock;
+
+    static uint64_t bit(const uint8_t step, const uint8_t track)
+    {
+        return 1ULL << (((step % STEPS) * TRACKS) + (track % TRACKS));
+    }
+
+    bool wait(const clock::time_point deadline);
+
+    void send(const uint8_t* messages, const unsigned count, const clock::time_point deadline);
+
+    void run();
+
+private: // private data
+    MidiOutUniquePtr      _output;
+    const clock::duration _period;
+    const clock::duration _gate;
+    const uint8_t         _channel;
+    std::atomic<uint64_t> _pattern;
+    std::atomic<int>      _playhead;
+    std::atomic<bool>     _stop;
+    bool                  _realtime;
+    clock::duration       _spin;
+    JitterMeter           _jitter;
+    std::thread           _thread;
+
+private: // disable copy and assignment
+    StepSequencer(const StepSequencer&) = delete;
+    StepSequencer& operator=(const StepSequencer&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_StepSequencer_h__ */
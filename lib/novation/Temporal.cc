@@ -0,0 +1,160 @@
+/*
+ * Temporal.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <stdexcept>
+#include "Temporal.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::td
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct td
+{
+    static constexpr unsigned SCALE = 255;
+    static constexpr unsigned STEP  = SCALE / (novation::TemporalRenderer::LEVELS - 1);
+
+    /* returns the lower hardware level and accumulates the remainder */
+    static unsigned level(const uint8_t value, uint8_t& error)
+    {
+        const unsigned scaled = value * (novation::TemporalRenderer::LEVELS - 1);
+        const unsigned lower  = scaled / SCALE;
+        const unsigned sum    = error + (scaled % SCALE);
+
+        if(sum >= SCALE) {
+            error = sum - SCALE;
+            return lower + 1;
+        }
+        error = sum;
+        return lower;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::DeepFrame
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+void DeepFrame::fill(const uint8_t r, const uint8_t g)
+{
+    ::memset(red, r, sizeof(red));
+    ::memset(green, g, sizeof(green));
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::TemporalRenderer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+TemporalRenderer::TemporalRenderer(Launchpad& launchpad, const unsigned subframes)
+    : LaunchpadDecorator(launchpad)
+    , _subframes(subframes != 0 ? subframes : DEFAULT_SUBFRAMES)
+    , _colors()
+    , _error()
+    , _curr()
+    , _prev()
+    , _valid(false)
+    , _messages(0)
+{
+    for(unsigned index = 0; index < (LEVELS * LEVELS); ++index) {
+        _colors[index] = _launchpad.makeColor((index / LEVELS) * td::STEP, (index % LEVELS) * td::STEP);
+    }
+    /* spread the initial error so that neighbouring pads do not blink in phase */
+    for(unsigned pad = 0; pad < PADS; ++pad) {
+        _error[0][pad] = (pad * 97) % td::SCALE;
+        _error[1][pad] = (pad * 61) % td::SCALE;
+    }
+}
+
+TemporalRenderer::~TemporalRenderer()
+{
+}
+
+void TemporalRenderer::render(const DeepFrame& frame, const uint64_t duration)
+{
+    using clock = std::chrono::steady_clock;
+
+    const uint8_t* red    = &frame.red[0][0];
+    const uint8_t* green  = &frame.green[0][0];
+    const auto     period = std::chrono::microseconds(duration / _subframes);
+    auto           deadline = clock::now();
+
+    for(unsigned subframe = 0; subframe < _subframes; ++subframe) {
+        for(unsigned pad = 0; pad < PADS; ++pad) {
+            const unsigned r = td::level(red[pad], _error[0][pad]);
+            const unsigned g = td::level(green[pad], _error[1][pad]);
+            _curr[pad] = _colors[r * LEVELS + g];
+        }
+        present();
+        deadline += period;
+        std::this_thread::sleep_until(deadline);
+    }
+}
+
+void TemporalRenderer::present()
+{
+    unsigned changed = 0;
+
+    if(_valid != false) {
+        for(unsigned pad = 0; pad < PADS; ++pad) {
+            changed += (_curr[pad] != _prev[pad] ? 1 : 0);
+        }
+    }
+    else {
+        changed = PADS;
+    }
+    /* a rapid update costs one message for two pads plus the cursor rewind */
+    if(changed > (PADS / 2)) {
+        _launchpad.setPads(_curr, PADS);
+        _messages += (PADS / 2) + 1;
+    }
+    else if(changed != 0) {
+        for(unsigned pad = 0; pad < PADS; ++pad) {
+            if(_curr[pad] != _prev[pad]) {
+                _launchpad.setPad(pad / Frame::COLS, pad % Frame::COLS, _curr[pad]);
+            }
+        }
+        _messages += changed;
+    }
+    ::memcpy(_prev, _curr, sizeof(_prev));
+    _valid = true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,124 @@
+/*
+ * Temporal.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Temporal_h__
+#define __NOVATION_Temporal_h__
+
+#include <novation/Frame.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct DeepFrame;
+class TemporalRenderer;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::DeepFrame
+//
+// An 8x8 frame with 8 bits per channel instead of device color bytes.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct DeepFrame
+{
+    static constexpr uint8_t ROWS = Frame::ROWS;
+    static constexpr uint8_t COLS = Frame::COLS;
+
+    void fill(const uint8_t r, const uint8_t g);
+
+    void set(const uint8_t row, const uint8_t col, const uint8_t r, const uint8_t g)
+    {
+        red[row % ROWS][col % COLS]   = r;
+        green[row % ROWS][col % COLS] = g;
+    }
+
+    uint8_t red[ROWS][COLS];
+    uint8_t green[ROWS][COLS];
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::TemporalRenderer
+//
+// The hardware only has 4 levels per channel. Each deep frame is shown as a
+// burst of subframes in which every pad alternates between the two hardware
+// levels surrounding its value: the fractional part is accumulated per pad
+// and per channel, and the upper level is shown whenever it overflows, so
+// the average over the burst matches the requested value.
+//
+// Only pads that changed since the previous subframe are sent, and a rapid
+// update of the whole grid is used instead when it is cheaper.
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class TemporalRenderer
+    : public LaunchpadDecorator
+{
+public: // public interface
+    TemporalRenderer(Launchpad& launchpad, const unsigned subframes);
+
+    virtual ~TemporalRenderer();
+
+    void render(const DeepFrame& frame, const uint64_t duration);
+
+    unsigned subframes() const
+    {
+        return _subframes;
+    }
+
+    uint64_t messages() const
+    {
+        return _messages;
+    }
+
+public: // public static data
+    static constexpr unsigned PADS              = Frame::ROWS * Frame::COLS;
+    static constexpr unsigned LEVELS            = 4;
+    static constexpr unsigned DEFAULT_SUBFRAMES = 8;
+    static constexpr unsigned MAXIMUM_SUBFRAMES = 64;
+
+private: // private interface
+    void present();
+
+private: // private data
+    const unsigned _subframes;
+    uint8_t        _colors[LEVELS * LEVELS];
+    uint8_t        _error[2][PADS];
+    uint8_t        _curr[PADS];
+    uint8_t        _prev[PADS];
+    bool           _valid;
+    uint64_t       _messages;
+
+private: // disable copy and assignment
+    TemporalRenderer(const TemporalRenderer&) = delete;
+    TemporalRenderer& operator=(const TemporalRenderer&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Temporal_h__ */
@@ -0,0 +1,473 @@
+/*
+ * Timeline.cc - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <chrono>
+#include "Font8x8.h"
+#include "Timeline.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::lp
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct lp
+{
+    static constexpr uint8_t ROWS = novation::Frame::ROWS;
+    static constexpr uint8_t COLS = novation::Frame::COLS;
+
+    static double ease(const novation::Tween tween, const double t)
+    {
+        switch(tween) {
+            case novation::Tween::kSTEP:
+                return 0.0;
+            case novation::Tween::kLINEAR:
+                return t;
+            case novation::Tween::kEASE_IN:
+                return t * t;
+            case novation::Tween::kEASE_OUT:
+                return t * (2.0 - t);
+            case novation::Tween::kEASE_IN_OUT:
+                return t * t * (3.0 - 2.0 * t);
+            default:
+                break;
+        }
+        return t;
+    }
+
+    static uint8_t glyph(const int32_t character)
+    {
+        if((character >= 0) && (character < novation::Font8x8::MAX_CHARS)) {
+            return static_cast<uint8_t>(character);
+        }
+        return 0;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Curve
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+Curve::Curve()
+    : _keyframes()
+{
+}
+
+Curve::~Curve()
+{
+}
+
+void Curve::add(const uint64_t time, const int32_t value, const Tween tween)
+{
+    if((_keyframes.size() > 0) && (time < _keyframes.back().time)) {
+        throw std::runtime_error("keyframes must be added in chronological order");
+    }
+    _keyframes.push_back(Keyframe{time, value, tween});
+}
+
+int32_t Curve::sample(const uint64_t time) const
+{
+    auto compare = [](const uint64_t time, const Keyframe& keyframe) -> bool
+    {
+        return time < keyframe.time;
+    };
+
+    if(_keyframes.empty()) {
+        return 0;
+    }
+    const auto next = std::upper_bound(_keyframes.begin(), _keyframes.end(), time, compare);
+    if(next == _keyframes.begin()) {
+        return next->value;
+    }
+    const auto prev = next - 1;
+    if((next == _keyframes.end()) || (prev->tween == Tween::kSTEP)) {
+        return prev->value;
+    }
+    const int64_t  v0 = prev->value;
+    const int64_t  v1 = next->value;
+    const uint64_t dt = next->time - prev->time;
+    const uint64_t et = time - prev->time;
+    if(prev->tween == Tween::kLINEAR) {
+        return static_cast<int32_t>(v0 + ((v1 - v0) * static_cast<int64_t>(et)) / static_cast<int64_t>(dt));
+    }
+    const double t = lp::ease(prev->tween, static_cast<double>(et) / static_cast<double>(dt));
+    return static_cast<int32_t>(std::lround(v0 + (v1 - v0) * t));
+}
+
+uint64_t Curve::duration() const
+{
+    if(_keyframes.empty()) {
+        return 0;
+    }
+    return _keyframes.back().time;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Track
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+Track::Track()
+{
+}
+
+Track::~Track()
+{
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ColorTrack
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+ColorTrack::ColorTrack(Launchpad& launchpad)
+    : Track()
+    , _launchpad(launchpad)
+    , _red()
+    , _green()
+{
+}
+
+ColorTrack::~ColorTrack()
+{
+}
+
+void ColorTrack::render(Frame& frame, const uint64_t time) const
+{
+    const uint8_t red   = static_cast<uint8_t>(std::min(std::max(_red.sample(time), 0), 255));
+    const uint8_t green = static_cast<uint8_t>(std::min(std::max(_green.sample(time), 0), 255));
+
+    frame.fill(_launchpad.makeColor(red, green));
+}
+
+uint64_t ColorTrack::duration() const
+{
+    return std::max(_red.duration(), _green.duration());
+}
+
+void ColorTrack::add(const uint64_t time, const uint8_t red, const uint8_t green, const Tween tween)
+{
+    _red.add(time, red, tween);
+    _green.add(time, green, tween);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::GlyphTrack
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+GlyphTrack::GlyphTrack(const uint8_t foreground, const uint8_t background)
+    : Track()
+    , _foreground(foreground)
+    , _background(background)
+    , _glyph()
+{
+}
+
+GlyphTrack::~GlyphTrack()
+{
+}
+
+void GlyphTrack::render(Frame& frame, const uint64_t time) const
+{
+    const uint8_t index = lp::glyph(_glyph.sample(time));
+
+    for(uint8_t row = 0; row < lp::ROWS; ++row) {
+        const uint8_t val = Font8x8::data[index][row];
+        uint8_t       bit = 0x01;
+        for(uint8_t col = 0; col < lp::COLS; ++col) {
+            frame.data[row][col] = ((val & bit) != 0 ? _foreground : _background);
+            bit <<= 1;
+        }
+    }
+}
+
+uint64_t GlyphTrack::duration() const
+{
+    return _glyph.duration();
+}
+
+void GlyphTrack::add(const uint64_t time, const char character)
+{
+    _glyph.add(time, static_cast<uint8_t>(character), Tween::kSTEP);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ScrollTrack
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+ScrollTrack::ScrollTrack(const std::string& text, const uint8_t foreground, const uint8_t background)
+    : Track()
+    , _text(text)
+    , _foreground(foreground)
+    , _background(background)
+    , _offset()
+{
+}
+
+ScrollTrack::~ScrollTrack()
+{
+}
+
+void ScrollTrack::render(Frame& frame, const uint64_t time) const
+{
+    const int32_t pix  = _offset.sample(time);
+    const int32_t size = static_cast<int32_t>(_text.size());
+
+    for(uint8_t row = 0; row < lp::ROWS; ++row) {
+        for(uint8_t col = 0; col < lp::COLS; ++col) {
+            const int32_t pos = col + pix;
+            const int32_t chr = pos / lp::COLS;
+            if((pos >= 0) && (chr < size)) {
+                const uint8_t idx = lp::glyph(static_cast<uint8_t>(_text[chr]));
+                const uint8_t bit = 1 << (pos % lp::COLS);
+                const uint8_t val = Font8x8::data[idx][row];
+                frame.data[row][col] = ((val & bit) != 0 ? _foreground : _background);
+            }
+            else {
+                frame.data[row][col] = _background;
+            }
+        }
+    }
+}
+
+uint64_t ScrollTrack::duration() const
+{
+    return _offset.duration();
+}
+
+void ScrollTrack::add(const uint64_t time, const int32_t offset, const Tween tween)
+{
+    _offset.add(time, offset, tween);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Timeline
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+Timeline::Timeline(const uint64_t period, const uint64_t duration)
+    : _period(period > 0 ? period : 1)
+    , _duration(duration)
+    , _tracks()
+{
+}
+
+Timeline::~Timeline()
+{
+}
+
+void Timeline::render(Frame& frame, const uint64_t index) const
+{
+    const uint64_t time = index * _period;
+
+    frame.fill(0x00);
+    for(auto& track : _tracks) {
+        track->render(frame, time);
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::FrameRing
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+FrameRing::FrameRing(const size_t capacity)
+    : _frames(capacity > 0 ? capacity : 1)
+    , _head(0)
+    , _tail(0)
+    , _count(0)
+    , _closed(false)
+    , _mutex()
+    , _notEmpty()
+    , _notFull()
+{
+}
+
+FrameRing::~FrameRing()
+{
+    close();
+}
+
+Frame* FrameRing::acquire()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _notFull.wait(lock, [&]() -> bool { return (_closed != false) || (_count < _frames.size()); });
+    if(_closed != false) {
+        return nullptr;
+    }
+    return &_frames[_tail];
+}
+
+void FrameRing::commit()
+{
+    /* commit the acquired frame */ {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _tail = (_tail + 1) % _frames.size();
+        ++_count;
+    }
+    _notEmpty.notify_one();
+}
+
+const Frame* FrameRing::front()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _notEmpty.wait(lock, [&]() -> bool { return (_closed != false) || (_count > 0); });
+    if(_count == 0) {
+        return nullptr;
+    }
+    return &_frames[_head];
+}
+
+void FrameRing::release()
+{
+    /* release the front frame */ {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _head = (_head + 1) % _frames.size();
+        --_count;
+    }
+    _notFull.notify_one();
+}
+
+void FrameRing::close()
+{
+    /* close the ring */ {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _closed = true;
+    }
+    _notEmpty.notify_all();
+    _notFull.notify_all();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::TimelinePlayer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+TimelinePlayer::TimelinePlayer(const Timeline& timeline, Renderer& renderer, const size_t lookahead)
+    : _timeline(timeline)
+    , _renderer(renderer)
+    , _ring(lookahead)
+    , _producer()
+    , _late(0)
+{
+}
+
+TimelinePlayer::~TimelinePlayer()
+{
+    _ring.close();
+    if(_producer.joinable()) {
+        _producer.join();
+    }
+}
+
+void TimelinePlayer::play(const bool& stop)
+{
+    using clock = std::chrono::steady_clock;
+
+    const uint64_t frames = _timeline.frames();
+    const auto     period = std::chrono::microseconds(_timeline.period());
+
+    std::thread(&TimelinePlayer::produce, this).swap(_producer);
+
+    clock::time_point deadline;
+    for(uint64_t index = 0; index < frames; ++index) {
+        if(stop != false) {
+            break;
+        }
+        const Frame* frame = _ring.front();
+        if(frame == nullptr) {
+            break;
+        }
+        if(index == 0) {
+            deadline = clock::now();
+        }
+        else if(clock::now() > deadline) {
+            ++_late;
+        }
+        std::this_thread::sleep_until(deadline);
+        _renderer.render(*frame);
+        _ring.release();
+        deadline += period;
+    }
+    if(stop == false) {
+        std::this_thread::sleep_until(deadline);
+    }
+    _ring.close();
+    _producer.join();
+}
+
+void TimelinePlayer::produce()
+{
+    const uint64_t frames = _timeline.frames();
+
+    for(uint64_t index = 0; index < frames; ++index) {
+        Frame* frame = _ring.acquire();
+        if(frame == nullptr) {
+            break;
+        }
+        _timeline.render(*frame, index);
+        _ring.commit();
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,350 @@
+/*
+ * Timeline.h - Copyright (c) 2001-2025 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __NOVATION_Timeline_h__
+#define __NOVATION_Timeline_h__
+
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <novation/Frame.h>
+
+// ---------------------------------------------------------------------------
+// novation
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Keyframe;
+class Curve;
+class Track;
+class ColorTrack;
+class GlyphTrack;
+class ScrollTrack;
+class Timeline;
+class FrameRing;
+class TimelinePlayer;
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Tween
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+enum class Tween : uint8_t
+{
+    kSTEP        = 0,
+    kLINEAR      = 1,
+    kEASE_IN     = 2,
+    kEASE_OUT    = 3,
+    kEASE_IN_OUT = 4,
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Keyframe
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+struct Keyframe
+{
+    uint64_t time;  /* keyframe time in microseconds     */
+    int32_t  value; /* keyframe value                    */
+    Tween    tween; /* tween towards the next keyframe   */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Curve
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class Curve
+{
+public: // public interface
+    Curve();
+
+    virtual ~Curve();
+
+    void add(const uint64_t time, const int32_t value, const Tween tween);
+
+    int32_t sample(const uint64_t time) const;
+
+    uint64_t duration() const;
+
+private: // private data
+    std::vector<Keyframe> _keyframes;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Track
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class Track
+{
+public: // public interface
+    Track();
+
+    virtual ~Track();
+
+    virtual void render(Frame& frame, const uint64_t time) const = 0;
+
+    virtual uint64_t duration() const = 0;
+
+private: // disable copy and assignment
+    Track(const Track&) = delete;
+    Track& operator=(const Track&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ColorTrack
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class ColorTrack final
+    : public Track
+{
+public: // public interface
+    ColorTrack(Launchpad& launchpad);
+
+    virtual ~ColorTrack();
+
+    virtual void render(Frame& frame, const uint64_t time) const override;
+
+    virtual uint64_t duration() const override;
+
+    void add(const uint64_t time, const uint8_t red, const uint8_t green, const Tween tween);
+
+private: // private data
+    Launchpad& _launchpad;
+    Curve      _red;
+    Curve      _green;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::GlyphTrack
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class GlyphTrack final
+    : public Track
+{
+public: // public interface
+    GlyphTrack(const uint8_t foreground, const uint8_t background);
+
+    virtual ~GlyphTrack();
+
+    virtual void render(Frame& frame, const uint64_t time) const override;
+
+    virtual uint64_t duration() const override;
+
+    void add(const uint64_t time, const char character);
+
+private: // private data
+    const uint8_t _foreground;
+    const uint8_t _background;
+    Curve         _glyph;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::ScrollTrack
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class ScrollTrack final
+    : public Track
+{
+public: // public interface
+    ScrollTrack(const std::string& text, const uint8_t foreground, const uint8_t background);
+
+    virtual ~ScrollTrack();
+
+    virtual void render(Frame& frame, const uint64_t time) const override;
+
+    virtual uint64_t duration() const override;
+
+    void add(const uint64_t time, const int32_t offset, const Tween tween);
+
+private: // private data
+    const std::string _text;
+    const uint8_t     _foreground;
+    const uint8_t     _background;
+    Curve             _offset;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::Timeline
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class Timeline
+{
+public: // public interface
+    Timeline(const uint64_t period, const uint64_t duration);
+
+    virtual ~Timeline();
+
+    template <typename T, typename... Args>
+    T& add(Args&&... args)
+    {
+        std::unique_ptr<T> track(new T(std::forward<Args>(args)...));
+        T& reference(*track);
+        _tracks.push_back(std::move(track));
+        return reference;
+    }
+
+    void render(Frame& frame, const uint64_t index) const;
+
+    uint64_t period() const
+    {
+        return _period;
+    }
+
+    uint64_t duration() const
+    {
+        return _duration;
+    }
+
+    uint64_t frames() const
+    {
+        return (_duration + _period - 1) / _period;
+    }
+
+private: // private data
+    const uint64_t                      _period;
+    const uint64_t                      _duration;
+    std::vector<std::unique_ptr<Track>> _tracks;
+
+private: // disable copy and assignment
+    Timeline(const Timeline&) = delete;
+    Timeline& operator=(const Timeline&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::FrameRing
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class FrameRing
+{
+public: // public interface
+    FrameRing(const size_t capacity);
+
+    virtual ~FrameRing();
+
+    Frame* acquire();
+
+    void commit();
+
+    const Frame* front();
+
+    void release();
+
+    void close();
+
+    size_t capacity() const
+    {
+        return _frames.size();
+    }
+
+private: // private data
+    std::vector<Frame>      _frames;
+    size_t                  _head;
+    size_t                  _tail;
+    size_t                  _count;
+    bool                    _closed;
+    std::mutex              _mutex;
+    std::condition_variable _notEmpty;
+    std::condition_variable _notFull;
+
+private: // disable copy and assignment
+    FrameRing(const FrameRing&) = delete;
+    FrameRing& operator=(const FrameRing&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// novation::TimelinePlayer
+// ---------------------------------------------------------------------------
+
+namespace novation {
+
+class TimelinePlayer
+{
+public: // public interface
+    TimelinePlayer(const Timeline& timeline, Renderer& renderer, const size_t lookahead);
+
+    virtual ~TimelinePlayer();
+
+    void play(const bool& stop);
+
+    uint64_t late() const
+    {
+        return _late;
+    }
+
+public: // public static data
+    static constexpr size_t DEFAULT_LOOKAHEAD = 4;
+    static constexpr size_t MAXIMUM_LOOKAHEAD = 256;
+
+private: // private interface
+    void produce();
+
+private: // private data
+    const Timeline& _timeline;
+    Renderer&       _renderer;
+    FrameRing       _ring;
+    std::thread     _producer;
+    uint64_t        _late;
+
+private: // disable copy and assignment
+    TimelinePlayer(const TimelinePlayer&) = delete;
+    TimelinePlayer& operator=(const TimelinePlayer&) = delete;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __NOVATION_Timeline_h__ */
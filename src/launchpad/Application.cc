@@ -41,6 +41,7 @@ struct arg
     static constexpr long MS_SCALE = 1000L;
     static constexpr long SS_SCALE = 1000L * 1000L;
     static constexpr long MN_SCALE = 1000L * 1000L * 60L;
+    static constexpr long WN_SCALE = 4L * MidiClock::BEAT;
 
     static const char* basename(const std::string& argument)
     {
@@ -53,6 +54,11 @@ struct arg
         return str;
     }
 
+    static bool is_option(const std::string& argument)
+    {
+        return argument.compare(0, 2, "--") == 0;
+    }
+
     static bool equals(const std::string& argument, const std::string& expected)
     {
         return argument == expected;
@@ -118,7 +124,7 @@ struct arg
             constexpr long max_delay = 1000000UL;
             if((delay < min_delay) || (delay > max_delay)) {
                 char error[256];
-                const int rc = ::snprintf(error, sizeof(error), "invalid delay <%s>: it must be expressed in [us, ms, s, m] and must be [%ldms <= delay <= %ldms]", string, (min_delay / 1000), (max_delay / 1000));
+                const int rc = ::snprintf(error, sizeof(error), "invalid delay <%s>: it must be expressed in [us, ms, s, m] or as a note and must be [%ldms <= delay <= %ldms]", string, (min_delay / 1000), (max_delay / 1000));
                 if((rc < 0) || (rc == sizeof(error))) {
                     throw std::runtime_error("invalid delay");
                 }
@@ -127,6 +133,15 @@ struct arg
             return delay;
         };
 
+        if((endptr != nullptr) && (*endptr == '/')) {
+            /* a note value, e.g. 1/16, where a whole note lasts 4 beats */
+            const char* const denominator = endptr + 1;
+            const long        divisor     = ::strtol(denominator, const_cast<char**>(&endptr), 10);
+            if((endptr == denominator) || (*endptr != '\0') || (divisor <= 0)) {
+                return check(-1);
+            }
+            return check((value * WN_SCALE) / divisor);
+        }
         if((endptr != nullptr) && (*endptr != '\0')) {
             if(::strcmp(endptr, "us") == 0) {
                 return check(value * US_SCALE);
@@ -144,6 +159,50 @@ struct arg
         }
         return check(value * MS_SCALE);
     }
+
+    static uint64_t seed(const std::string& argument)
+    {
+        const char*              string = argument.c_str();
+        char*                    endptr = nullptr;
+        const unsigned long long value  = ::strtoull(string, &endptr, 0);
+
+        if((*string == '\0') || (*string == '-') || (endptr == nullptr) || (*endptr != '\0')) {
+            throw std::runtime_error(std::string("invalid seed") + ' ' + '<' + argument + '>');
+        }
+        return value;
+    }
+
+    static double speed(const std::string& argument)
+    {
+        const char*  string = argument.c_str();
+        char*        endptr = nullptr;
+        const double value  = ::strtod(string, &endptr);
+
+        if((*string == '\0') || (endptr == nullptr) || (*endptr != '\0') || !(value >= 0.0) || (value > 1000.0)) {
+            throw std::runtime_error(std::string("invalid speed") + ' ' + '<' + argument + '>');
+        }
+        return value;
+    }
+
+    static std::string journal(const char* action, const std::string& path, const uint64_t frames, const uint64_t events, const uint64_t seed)
+    {
+        char buffer[256];
+        const int rc = ::snprintf(buffer, sizeof(buffer), ", %llu frames, %llu events, seed 0x%016llx", static_cast<unsigned long long>(frames), static_cast<unsigned long long>(events), static_cast<unsigned long long>(seed));
+        if((rc < 0) || (rc >= static_cast<int>(sizeof(buffer)))) {
+            throw std::runtime_error("snprintf() has failed");
+        }
+        return std::string("journal") + ' ' + action + ' ' + path + buffer;
+    }
+
+    static std::string clock(const MidiClockStatus& status)
+    {
+        char buffer[256];
+        const int rc = ::snprintf(buffer, sizeof(buffer), "clock %s, %.2f bpm, period %.1f us, phase error %.1f us, jitter %.1f us, max %.1f us, drift %.1f us, %llu ticks, %llu resyncs", (status.running ? "running" : "stopped"), status.tempo, status.period, status.error, status.jitter, status.maximum, status.drift, static_cast<unsigned long long>(status.ticks), static_cast<unsigned long long>(status.resyncs));
+        if((rc < 0) || (rc >= static_cast<int>(sizeof(buffer)))) {
+            throw std::runtime_error("snprintf() has failed");
+        }
+        return buffer;
+    }
 };
 
 }
@@ -157,11 +216,20 @@ Application::Application ( const ArgList& arglist
      : Program(arglist, console)
      , _lpCommandType(CommandType::kNONE)
      , _lpLaunchpadPtr()
+     , _lpClockPtr()
+     , _lpScaledPtr()
+     , _lpReplayPtr()
+     , _lpRecordPtr()
      , _lpCommandPtr()
      , _lpArguments()
      , _lpName("Launchpad Mini")
      , _lpInput(_lpName)
      , _lpOutput(_lpName)
+     , _lpClock()
+     , _lpSeed()
+     , _lpRecord()
+     , _lpReplay()
+     , _lpSpeed()
      , _lpProgram("launchpad")
      , _lpCommand()
      , _lpParam1()
@@ -220,6 +288,26 @@ bool Application::parseOption(const std::string& option)
         _lpOutput = value;
         return true;
     }
+    else if(arg::is(option, "--clock")) {
+        _lpClock  = value;
+        return true;
+    }
+    else if(arg::is(option, "--seed")) {
+        _lpSeed   = value;
+        return true;
+    }
+    else if(arg::is(option, "--record")) {
+        _lpRecord = value;
+        return true;
+    }
+    else if(arg::is(option, "--replay")) {
+        _lpReplay = value;
+        return true;
+    }
+    else if(arg::is(option, "--speed")) {
+        _lpSpeed  = value;
+        return true;
+    }
     return false;
 }
 
@@ -259,13 +347,38 @@ bool Application::parseCommand(const std::string& command)
         if(arg::equals(command, "gameoflife")) {
             return setCommand(CommandType::kGAMEOFLIFE);
         }
+        if(arg::equals(command, "play")) {
+            return setCommand(CommandType::kPLAY);
+        }
+        if(arg::equals(command, "image")) {
+            return setCommand(CommandType::kIMAGE);
+        }
+        if(arg::equals(command, "fx")) {
+            return setCommand(CommandType::kFX);
+        }
+        if(arg::equals(command, "run")) {
+            return setCommand(CommandType::kRUN);
+        }
+        if(arg::equals(command, "spectrum")) {
+            return setCommand(CommandType::kSPECTRUM);
+        }
+        if(arg::equals(command, "sequencer")) {
+            return setCommand(CommandType::kSEQUENCER);
+        }
+        if(arg::equals(command, "monitor")) {
+            return setCommand(CommandType::kMONITOR);
+        }
     }
     return false;
 }
 
 bool Application::parseArgument(const std::string& argument)
 {
-    if(_lpCommand.empty()) {
+    if(arg::is_option(argument)) {
+        _lpArguments.add(argument);
+        return true;
+    }
+    else if(_lpCommand.empty()) {
         return false;
     }
     else if(_lpParam1.empty()) {
@@ -288,6 +401,10 @@ bool Application::parseArgument(const std::string& argument)
         _lpParam4 = argument;
         return true;
     }
+    else {
+        _lpArguments.add(argument);
+        return true;
+    }
     return false;
 }
 
@@ -316,6 +433,7 @@ bool Application::init()
 
 bool Application::loop()
 {
+    setupJournal();
     switch(_lpCommandType) {
         default:
         case CommandType::kHELP:
@@ -366,13 +484,112 @@ bool Application::loop()
                 _lpCommandPtr   = std::make_unique<launchpad::GameOfLifeCmd>(*_lpLaunchpadPtr, _lpArguments, _console, arg::delay(_lpDelay));
             }
             break;
+        case CommandType::kPLAY:
+            {
+                _lpLaunchpadPtr = std::make_unique<Launchpad>(_lpName, _lpInput, _lpOutput);
+                _lpCommandPtr   = std::make_unique<launchpad::PlayCmd>(*_lpLaunchpadPtr, _lpArguments, _console, arg::delay(_lpDelay));
+            }
+            break;
+        case CommandType::kIMAGE:
+            {
+                _lpLaunchpadPtr = std::make_unique<Launchpad>(_lpName, _lpInput, _lpOutput);
+                _lpCommandPtr   = std::make_unique<launchpad::ImageCmd>(*_lpLaunchpadPtr, _lpArguments, _console, arg::delay(_lpDelay));
+            }
+            break;
+        case CommandType::kFX:
+            {
+                _lpLaunchpadPtr = std::make_unique<Launchpad>(_lpName, _lpInput, _lpOutput);
+                _lpCommandPtr   = std::make_unique<launchpad::FxCmd>(*_lpLaunchpadPtr, _lpArguments, _console, arg::delay(_lpDelay));
+            }
+            break;
+        case CommandType::kRUN:
+            {
+                _lpLaunchpadPtr = std::make_unique<Launchpad>(_lpName, _lpInput, _lpOutput);
+                _lpCommandPtr   = std::make_unique<launchpad::RunCmd>(*_lpLaunchpadPtr, _lpArguments, _console, arg::delay(_lpDelay));
+            }
+            break;
+        case CommandType::kSPECTRUM:
+            {
+                _lpLaunchpadPtr = std::make_unique<Launchpad>(_lpName, _lpInput, _lpOutput);
+                _lpCommandPtr   = std::make_unique<launchpad::SpectrumCmd>(*_lpLaunchpadPtr, _lpArguments, _console, arg::delay(_lpDelay));
+            }
+            break;
+        case CommandType::kSEQUENCER:
+            {
+                _lpLaunchpadPtr = std::make_unique<Launchpad>(_lpName, _lpInput, _lpOutput);
+                _lpCommandPtr   = std::make_unique<launchpad::SequencerCmd>(*_lpLaunchpadPtr, _lpArguments, _console, arg::delay(_lpDelay));
+            }
+            break;
+        case CommandType::kMONITOR:
+            {
+                _lpLaunchpadPtr = std::make_unique<Launchpad>(_lpName, _lpInput, _lpOutput);
+                _lpCommandPtr   = std::make_unique<launchpad::MonitorCmd>(*_lpLaunchpadPtr, _lpArguments, _console, arg::delay(_lpDelay));
+            }
+            break;
     }
     if(_lpCommandPtr) {
+        setupCommand();
         _lpCommandPtr->execute();
     }
+    if(_lpClockPtr) {
+        _console.printStream << arg::clock(_lpClockPtr->status()) << std::endl;
+    }
+    if(_lpRecordPtr) {
+        _lpRecordPtr->close();
+        _console.printStream << arg::journal("recorded", _lpRecord, _lpRecordPtr->frames(), _lpRecordPtr->events(), _lpRecordPtr->seed()) << std::endl;
+    }
+    if(_lpReplayPtr) {
+        _console.printStream << arg::journal("replayed", _lpReplay, _lpReplayPtr->frames(), _lpReplayPtr->events(), _lpReplayPtr->seed()) << std::endl;
+    }
     return true;
 }
 
+void Application::setupJournal()
+{
+    /* the seed is set before the command is created, which draws its seeds */
+    if(_lpReplay.empty() == false) {
+        if(_lpRecord.empty() == false) {
+            throw std::runtime_error("--record cannot be used with --replay");
+        }
+        if(_lpSeed.empty() == false) {
+            throw std::runtime_error("--seed cannot be used with --replay");
+        }
+        _lpReplayPtr = std::make_unique<JournalReader>(_lpReplay);
+        Random::setSeed(_lpReplayPtr->seed());
+    }
+    else if(_lpSpeed.empty() == false) {
+        throw std::runtime_error("--speed requires --replay");
+    }
+    else if((_lpSeed.empty() == false) || (_lpRecord.empty() == false)) {
+        const uint64_t seed = (_lpSeed.empty() == false ? arg::seed(_lpSeed) : Random::entropy());
+        Random::setSeed(seed);
+        if(_lpRecord.empty() == false) {
+            _lpRecordPtr = std::make_unique<JournalWriter>(_lpRecord, seed);
+        }
+    }
+}
+
+void Application::setupCommand()
+{
+    if(_lpRecordPtr) {
+        _lpCommandPtr->setJournal(*_lpRecordPtr);
+    }
+    if(_lpReplayPtr) {
+        _lpCommandPtr->setJournal(*_lpReplayPtr);
+    }
+    if(_lpClock.empty() == false) {
+        if(_lpCommandPtr->paced() == false) {
+            throw std::runtime_error("this command does not support --clock");
+        }
+        _lpClockPtr = std::make_unique<MidiClock>(_lpName, _lpClock);
+        _lpCommandPtr->setClock(*_lpClockPtr);
+    }
+    if(_lpSpeed.empty() == false) {
+        _lpScaledPtr = std::make_unique<ScaledClock>(_lpCommandPtr->clock(), arg::speed(_lpSpeed));
+        _lpCommandPtr->setClock(*_lpScaledPtr);
+    }
+}
+
 void Application::stop()
 {
     if(_lpCommandPtr) {
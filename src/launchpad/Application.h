@@ -60,25 +60,37 @@ private: // private interface
     bool init();
     bool loop();
 
+    void setupJournal();
+    void setupCommand();
+
     bool parseOption(const std::string& option);
     bool parseCommand(const std::string& command);
     bool parseArgument(const std::string& argument);
 
 private: // private data
-    CommandType        _lpCommandType;
-    LaunchpadUniquePtr _lpLaunchpadPtr;
-    CommandUniquePtr   _lpCommandPtr;
-    ArgList            _lpArguments;
-    std::string        _lpName;
-    std::string        _lpInput;
-    std::string        _lpOutput;
-    std::string        _lpProgram;
-    std::string        _lpCommand;
-    std::string        _lpParam1;
-    std::string        _lpParam2;
-    std::string        _lpParam3;
-    std::string        _lpParam4;
-    std::string        _lpDelay;
+    CommandType            _lpCommandType;
+    LaunchpadUniquePtr     _lpLaunchpadPtr;
+    MidiClockUniquePtr     _lpClockPtr;
+    ScaledClockUniquePtr   _lpScaledPtr;
+    JournalReaderUniquePtr _lpReplayPtr;
+    JournalWriterUniquePtr _lpRecordPtr;
+    CommandUniquePtr       _lpCommandPtr;
+    ArgList                _lpArguments;
+    std::string            _lpName;
+    std::string            _lpInput;
+    std::string            _lpOutput;
+    std::string            _lpClock;
+    std::string            _lpSeed;
+    std::string            _lpRecord;
+    std::string            _lpReplay;
+    std::string            _lpSpeed;
+    std::string            _lpProgram;
+    std::string            _lpCommand;
+    std::string            _lpParam1;
+    std::string            _lpParam2;
+    std::string            _lpParam3;
+    std::string            _lpParam4;
+    std::string            _lpDelay;
 };
 
 // ---------------------------------------------------------------------------
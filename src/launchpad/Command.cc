@@ -29,7 +29,6 @@
 #include <stdexcept>
 #include <chrono>
 #include <thread>
-#include <random>
 #include "Command.h"
 
 // ---------------------------------------------------------------------------
@@ -50,6 +49,8 @@ struct lp
     static constexpr bool    DO_COPY  = true;
     static constexpr bool    NO_COPY  = false;
 
+    static constexpr uint64_t MAXIMUM_RATE = 1000;
+
     static uint64_t check_delay(const uint64_t delay, const uint64_t default_delay)
     {
         if(delay == 0UL) {
@@ -58,11 +59,6 @@ struct lp
         return delay;
     }
 
-    static void sleep(Launchpad& launchpad, const uint64_t delay)
-    {
-        std::this_thread::sleep_for(std::chrono::microseconds(delay));
-    }
-
     static void clear(Launchpad& launchpad)
     {
         for(uint8_t row = 0; row < ROWS; ++row) {
@@ -72,61 +68,149 @@ struct lp
         }
     }
 
-    static void print(Launchpad& launchpad, const std::string& string, const uint8_t foreground, const uint8_t background, const uint64_t delay, bool& stop)
+    static bool is_option(const std::string& argument)
     {
-        for(auto character : string) {
-            if(stop != false) {
-                break;
-            }
-            launchpad.setBuffer(BUFFER0, BUFFER1, NO_FLASH, NO_COPY);
-            const uint8_t index = (character < Font8x8::MAX_CHARS ? character : 0);
-            for(uint8_t row = 0; row < ROWS; ++row) {
-                const uint8_t val = Font8x8::data[index][row];
-                uint8_t       bit = 0x01;
-                for(uint8_t col = 0; col < COLS; ++col) {
-                    if((val & bit) != 0) {
-                        launchpad.setPad(row, col, foreground);
-                    }
-                    else {
-                        launchpad.setPad(row, col, background);
-                    }
-                    bit <<= 1;
-                }
+        return argument.compare(0, 2, "--") == 0;
+    }
+
+    static bool is_option(const std::string& argument, const std::string& expected)
+    {
+        const size_t pos = 0;
+        const size_t len = expected.length();
+
+        if(argument.compare(pos, len, expected) == 0) {
+            return (argument.length() == len) || (argument[len] == '=');
+        }
+        return false;
+    }
+
+    static std::string option_value(const std::string& argument)
+    {
+        const size_t equ = argument.find('=');
+
+        if(equ != std::string::npos) {
+            return argument.substr(equ + 1);
+        }
+        return std::string();
+    }
+
+    static void invalid_option(const std::string& option)
+    {
+        throw std::runtime_error(std::string("invalid option") + ' ' + '<' + option + '>');
+    }
+
+    static uint64_t parse_uint(const std::string& option, const uint64_t min_value, const uint64_t max_value)
+    {
+        const std::string value(option_value(option));
+        const char* string = value.c_str();
+        const char* endptr = nullptr;
+        const unsigned long long result = ::strtoull(string, const_cast<char**>(&endptr), 10);
+
+        if((*string == '\0') || (*endptr != '\0') || (result < min_value) || (result > max_value)) {
+            char error[256];
+            const int rc = ::snprintf(error, sizeof(error), "invalid option <%s>: value must be [%llu <= value <= %llu]", option.c_str(), static_cast<unsigned long long>(min_value), static_cast<unsigned long long>(max_value));
+            if((rc < 0) || (rc == sizeof(error))) {
+                throw std::runtime_error("invalid option");
             }
-            launchpad.setBuffer(BUFFER1, BUFFER0, NO_FLASH, DO_COPY);
-            launchpad.setBuffer(BUFFER0, BUFFER0, NO_FLASH, NO_COPY);
-            lp::sleep(launchpad, delay);
+            throw std::runtime_error(error);
         }
+        return result;
     }
 
-    static void scroll(Launchpad& launchpad, const std::string& string, const uint8_t foreground, const uint8_t background, const uint64_t delay, bool& stop)
+    static Dither parse_dither(const std::string& option)
     {
-        const char*  data = string.c_str();
-        const size_t size = string.size();
-        const int    pixs = COLS * (size > 0 ? size - 1 : 0);
+        const std::string value(option_value(option));
 
-        for(int pix = 0; pix < pixs; ++pix) {
-            if(stop != false) {
-                break;
+        if(value == "none") {
+            return Dither::kNONE;
+        }
+        if(value == "ordered") {
+            return Dither::kORDERED;
+        }
+        if(value == "floyd-steinberg") {
+            return Dither::kFLOYD_STEINBERG;
+        }
+        invalid_option(option);
+        return Dither::kNONE;
+    }
+
+    static uint64_t parse_rate(const std::string& option)
+    {
+        return parse_uint(option, 1, MAXIMUM_RATE);
+    }
+
+    static uint64_t rate_period(const uint64_t rate, const uint64_t delay)
+    {
+        if(rate == 0UL) {
+            return delay;
+        }
+        return 1000000UL / rate;
+    }
+
+    static std::string pacing(const Pacer& pacer)
+    {
+        char buffer[256];
+        const int rc = ::snprintf(buffer, sizeof(buffer), "%llu steps, %llu frames presented, %llu superseded frames dropped, %llu late steps skipped", static_cast<unsigned long long>(pacer.steps()), static_cast<unsigned long long>(pacer.frames()), static_cast<unsigned long long>(pacer.dropped()), static_cast<unsigned long long>(pacer.skipped()));
+        if((rc < 0) || (rc >= static_cast<int>(sizeof(buffer)))) {
+            throw std::runtime_error("snprintf() has failed");
+        }
+        return buffer;
+    }
+
+    static std::string input(const InputQueue& queue)
+    {
+        char buffer[256];
+        const int rc = ::snprintf(buffer, sizeof(buffer), "%llu input events, %llu coalesced, %llu dropped on overflow", static_cast<unsigned long long>(queue.pushed()), static_cast<unsigned long long>(queue.coalesced()), static_cast<unsigned long long>(queue.overflows()));
+        if((rc < 0) || (rc >= static_cast<int>(sizeof(buffer)))) {
+            throw std::runtime_error("snprintf() has failed");
+        }
+        return buffer;
+    }
+
+    static std::string latency(const EchoRenderer& renderer)
+    {
+        char buffer[256];
+        const JitterMeter& meter(renderer.latency());
+        const int rc = ::snprintf(buffer, sizeof(buffer), "%llu presses, %llu echoes, press to LED latency p50 %llu us, p90 %llu us, p99 %llu us, max %llu us", static_cast<unsigned long long>(meter.count()), static_cast<unsigned long long>(renderer.echoes()), static_cast<unsigned long long>(meter.percentile(50)), static_cast<unsigned long long>(meter.percentile(90)), static_cast<unsigned long long>(meter.percentile(99)), static_cast<unsigned long long>(meter.maximum()));
+        if((rc < 0) || (rc >= static_cast<int>(sizeof(buffer)))) {
+            throw std::runtime_error("snprintf() has failed");
+        }
+        return buffer;
+    }
+
+    static size_t parse_lookahead(const std::string& option)
+    {
+        return parse_uint(option, 1, TimelinePlayer::MAXIMUM_LOOKAHEAD);
+    }
+
+    static unsigned parse_subframes(const std::string& option)
+    {
+        if(option_value(option).empty()) {
+            return TemporalRenderer::DEFAULT_SUBFRAMES;
+        }
+        return parse_uint(option, 2, TemporalRenderer::MAXIMUM_SUBFRAMES);
+    }
+
+    static ArgList arguments(const ArgList& arglist)
+    {
+        ArgList arguments;
+        for(auto& argument : arglist) {
+            if(is_option(argument) == false) {
+                arguments.add(argument);
             }
-            launchpad.setBuffer(BUFFER0, BUFFER1, NO_FLASH, NO_COPY);
-            for(uint8_t row = 0; row < ROWS; ++row) {
-                for(uint8_t col = 0; col < COLS; ++col) {
-                    const uint8_t chr = data[((col + pix) / COLS)];
-                    const uint8_t bit = 1 << ((col + pix) % COLS);
-                    const uint8_t val = Font8x8::data[chr][row];
-                    if((val & bit) != 0) {
-                        launchpad.setPad(row, col, foreground);
-                    }
-                    else {
-                        launchpad.setPad(row, col, background);
-                    }
-                }
+        }
+        return arguments;
+    }
+
+    static ArgList options(const ArgList& arglist)
+    {
+        ArgList options;
+        for(auto& argument : arglist) {
+            if(is_option(argument) != false) {
+                options.add(argument);
             }
-            launchpad.setBuffer(BUFFER1, BUFFER0, NO_FLASH, DO_COPY);
-            launchpad.setBuffer(BUFFER0, BUFFER0, NO_FLASH, NO_COPY);
-            lp::sleep(launchpad, delay);
         }
+        return options;
     }
 };
 
@@ -138,12 +222,14 @@ struct lp
 
 AbstractCommand::AbstractCommand(const Console& console)
     : _arglist()
+    , _options()
     , _console(console)
 {
 }
 
 AbstractCommand::AbstractCommand(const ArgList& arglist, const Console& console)
-    : _arglist(arglist)
+    : _arglist(lp::arguments(arglist))
+    , _options(lp::options(arglist))
     , _console(console)
 {
 }
@@ -192,11 +278,14 @@ Command::Command ( Launchpad&     launchpad
     , LaunchpadDecorator(launchpad)
     , LaunchpadListener()
     , _delay(delay)
-    , _black(_launchpad.makeColor(0, 0))
-    , _red(_launchpad.makeColor(255, 0))
-    , _green(_launchpad.makeColor(0, 255))
-    , _amber(_launchpad.makeColor(255, 255))
     , _stop(false)
+    , _paced(false)
+    , _clock(&PacerClock::steady())
+    , _input()
+    , _events()
+    , _coalesce(false)
+    , _recorder(nullptr)
+    , _player(nullptr)
 {
     _launchpad.setListener(this);
 }
@@ -206,11 +295,181 @@ Command::~Command()
     _launchpad.setListener(nullptr);
 }
 
+void Command::setClock(PacerClock& clock)
+{
+    if(_paced == false) {
+        throw std::runtime_error("this command is not paced by a clock");
+    }
+    _clock = &clock;
+}
+
 void Command::sleep(const uint64_t delay)
 {
     std::this_thread::sleep_for(std::chrono::microseconds(delay));
 }
 
+void Command::onLaunchpadInput(const std::string& message)
+{
+    constexpr uint8_t GRID_KEY = novation::Midi::CHANNEL_01_NOTE_ON;
+    constexpr uint8_t LIVE_KEY = novation::Midi::CHANNEL_01_CONTROL_CHANGE;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(message.data());
+    const size_t   size = message.size();
+
+    /* without a queue, the handlers are called on the input thread */
+    if(!_input) {
+        LaunchpadListener::onLaunchpadInput(message);
+        return;
+    }
+    /* a replay ignores the live input */
+    if(_player != nullptr) {
+        return;
+    }
+    if((size == 3) && ((data[0] == GRID_KEY) || (data[0] == LIVE_KEY))) {
+        InputEvent event = {};
+        event.type     = (data[0] == GRID_KEY ? InputType::kGRID_KEY : InputType::kLIVE_KEY);
+        event.key      = data[1];
+        event.velocity = data[2];
+        event.time     = InputQueue::now();
+        /* queued first, so that what it triggers is drained after it */
+        static_cast<void>(_input->push(event));
+        onInputQueued(event);
+    }
+}
+
+void Command::queueInput(const bool coalesce)
+{
+    _input.reset(new InputQueue());
+    _events.reserve(_input->capacity());
+    _coalesce = coalesce;
+}
+
+void Command::postInput(const InputEvent& event)
+{
+    if(_input) {
+        static_cast<void>(_input->push(event));
+    }
+}
+
+void Command::setJournal(JournalWriter& journal)
+{
+    if(!_input) {
+        throw std::runtime_error("this command does not support --record");
+    }
+    _recorder = &journal;
+}
+
+void Command::setJournal(JournalReader& journal)
+{
+    if(!_input) {
+        throw std::runtime_error("this command does not support --replay");
+    }
+    _player = &journal;
+}
+
+unsigned Command::drainInput(const unsigned steps)
+{
+    if(!_input) {
+        return steps;
+    }
+    /* a replay runs the recorded steps of the frame, whatever the time */
+    if(_player != nullptr) {
+        unsigned   recorded = 0;
+        InputEvent event;
+        _events.clear();
+        if(_player->frame(recorded) == false) {
+            _stop = true;
+            return 0;
+        }
+        while(_player->event(event)) {
+            _events.push_back(event);
+        }
+        if(_player->done()) {
+            _stop = true;
+        }
+        for(auto& event : _events) {
+            onInputEvent(event);
+        }
+        return recorded;
+    }
+    _input->drain(_events, _coalesce);
+    if(_recorder != nullptr) {
+        _recorder->frame(steps);
+        for(auto& event : _events) {
+            _recorder->event(event);
+        }
+    }
+    for(auto& event : _events) {
+        onInputEvent(event);
+    }
+    return steps;
+}
+
+void Command::animate(DeepFrame& frame, const uint64_t fps, const unsigned subframes)
+{
+    const uint64_t period = lp::rate_period(fps, _delay);
+    Pacer          pacer(period, period, *_clock);
+    Renderer       renderer(_launchpad);
+    Frame          quantized;
+    uint64_t       steps = 0;
+    std::unique_ptr<TemporalRenderer> temporal(subframes != 0 ? new TemporalRenderer(_launchpad, subframes) : nullptr);
+
+    auto display = [&]() -> void
+    {
+        onAnimate(frame, steps * period);
+        if(temporal) {
+            temporal->render(frame, period);
+            return;
+        }
+        for(uint8_t row = 0; row < DeepFrame::ROWS; ++row) {
+            for(uint8_t col = 0; col < DeepFrame::COLS; ++col) {
+                quantized.data[row][col] = Palettes::TABLE(Color(frame.red[row][col], frame.green[row][col]));
+            }
+        }
+        renderer.render(quantized);
+    };
+
+    display();
+    do {
+        /* the input is drained on every frame, even without any step */
+        const unsigned due = drainInput(pacer.wait());
+        if((due != 0) || hasEvents()) {
+            steps += due;
+            display();
+        }
+    } while(_stop == false);
+    if(fps != 0) {
+        println(lp::pacing(pacer));
+    }
+    if(_coalesce || (_input->overflows() != 0)) {
+        println(lp::input(*_input));
+    }
+}
+
+void Command::onInputQueued(const InputEvent& event)
+{
+    static_cast<void>(event);
+}
+
+void Command::onInputEvent(const InputEvent& event)
+{
+    switch(event.type) {
+        case InputType::kGRID_KEY:
+            onLaunchpadGridKey(event.key, event.velocity);
+            break;
+        case InputType::kLIVE_KEY:
+            onLaunchpadLiveKey(event.key, event.velocity);
+            break;
+        default:
+            break;
+    }
+}
+
+void Command::onAnimate(DeepFrame& frame, const uint64_t time)
+{
+    static_cast<void>(frame);
+    static_cast<void>(time);
+}
+
 // ---------------------------------------------------------------------------
 // HelpCmd
 // ---------------------------------------------------------------------------
@@ -229,6 +488,9 @@ HelpCmd::HelpCmd ( Launchpad&         launchpad
     , _midiIn(midiIn)
     , _midiOut(midiOut)
 {
+    for(auto& option : _options) {
+        lp::invalid_option(option);
+    }
 }
 
 HelpCmd::~HelpCmd()
@@ -270,6 +532,27 @@ void HelpCmd::execute()
     else if(command == "gameoflife") {
         gameoflifeUsage(_console.printStream);
     }
+    else if(command == "play") {
+        playUsage(_console.printStream);
+    }
+    else if(command == "image") {
+        imageUsage(_console.printStream);
+    }
+    else if(command == "fx") {
+        fxUsage(_console.printStream);
+    }
+    else if(command == "run") {
+        runUsage(_console.printStream);
+    }
+    else if(command == "spectrum") {
+        spectrumUsage(_console.printStream);
+    }
+    else if(command == "sequencer") {
+        sequencerUsage(_console.printStream);
+    }
+    else if(command == "monitor") {
+        monitorUsage(_console.printStream);
+    }
     else {
         throw std::runtime_error(std::string("no help for") + ' ' + '<' + command + '>');
     }
@@ -314,6 +597,13 @@ void HelpCmd::baseUsage(std::ostream& stream)
         stream << "    scroll {message}                    scroll a message"          << std::endl;
         stream << "    matrix                              matrix-like rain effect"   << std::endl;
         stream << "    gameoflife [{pattern}]              display the game of life"  << std::endl;
+        stream << "    play {file}                         play a sequence file"      << std::endl;
+        stream << "    image {file} [{file}...]            display images"            << std::endl;
+        stream << "    fx {effect}                         display an effect"         << std::endl;
+        stream << "    run {script}                        run an animation script"   << std::endl;
+        stream << "    spectrum [{file}]                   display an audio spectrum" << std::endl;
+        stream << "    sequencer                           8-track step sequencer"    << std::endl;
+        stream << "    monitor                             print the MIDI input"      << std::endl;
         stream << ""                                                                  << std::endl;
         stream << "Options:"                                                          << std::endl;
         stream << ""                                                                  << std::endl;
@@ -321,10 +611,17 @@ void HelpCmd::baseUsage(std::ostream& stream)
         stream << "    -l, --list                          list available MIDI ports" << std::endl;
         stream << ""                                                                  << std::endl;
         stream << "    --delay={value[us|ms|s|m]}          delay (ms by default)"     << std::endl;
+        stream << "    --delay={note}                      note value, e.g. 1/16"     << std::endl;
         stream << ""                                                                  << std::endl;
         stream << "    --midi={port}                       MIDI input/output"         << std::endl;
         stream << "    --midi-input={port}                 MIDI input"                << std::endl;
         stream << "    --midi-output={port}                MIDI output"               << std::endl;
+        stream << "    --clock={port}                      MIDI clock input"          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --seed={number}                     random number seed"        << std::endl;
+        stream << "    --record={file}                     record the input"          << std::endl;
+        stream << "    --replay={file}                     replay a recorded input"   << std::endl;
+        stream << "    --speed={factor}                    replay speed, 0 for max"   << std::endl;
         stream << ""                                                                  << std::endl;
         stream << "MIDI input/output:"                                                << std::endl;
         stream << ""                                                                  << std::endl;
@@ -387,6 +684,11 @@ void HelpCmd::cycleUsage(std::ostream& stream)
         stream << ""                                                                  << std::endl;
         stream << "    none"                                                          << std::endl;
         stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --lookahead={frames}    number of precomputed frames"          << std::endl;
+        stream << "    --subframes[={count}]   temporal dithering (64 colors)"        << std::endl;
+        stream << ""                                                                  << std::endl;
     }
 }
 
@@ -401,6 +703,10 @@ void HelpCmd::printUsage(std::ostream& stream)
         stream << ""                                                                  << std::endl;
         stream << "    message             specifies the message to print"            << std::endl;
         stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --lookahead={frames}    number of precomputed frames"          << std::endl;
+        stream << ""                                                                  << std::endl;
     }
 }
 
@@ -415,6 +721,10 @@ void HelpCmd::scrollUsage(std::ostream& stream)
         stream << ""                                                                  << std::endl;
         stream << "    message             specifies the message to scroll"           << std::endl;
         stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --lookahead={frames}    number of precomputed frames"          << std::endl;
+        stream << ""                                                                  << std::endl;
     }
 }
 
@@ -423,12 +733,23 @@ void HelpCmd::matrixUsage(std::ostream& stream)
     if(stream.good()) {
         stream << "Usage: " << _program << ' ' << "[options] matrix"                  << std::endl;
         stream << ""                                                                  << std::endl;
-        stream << "Display a Matrix-like rain effect"                                 << std::endl;
+        stream << "Display a Matrix-like rain or another particle effect"             << std::endl;
         stream << ""                                                                  << std::endl;
         stream << "Arguments:"                                                        << std::endl;
         stream << ""                                                                  << std::endl;
         stream << "    none"                                                          << std::endl;
         stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --effect={name}         matrix, sparks or fireworks"           << std::endl;
+        stream << "    --particles={count}     maximum number of particles (4096)"    << std::endl;
+        stream << "    --subframes[={count}]   temporal dithering (64 colors)"        << std::endl;
+        stream << "    --sim-rate={hz}         simulation steps per second"           << std::endl;
+        stream << "    --fps={hz}              displayed frames per second"           << std::endl;
+        stream << "    --no-echo               light pads at the next frame only"     << std::endl;
+        stream << "    --latency               measure the press to LED latency"      << std::endl;
+        stream << "    --coalesce              merge the key events of a frame"       << std::endl;
+        stream << ""                                                                  << std::endl;
     }
 }
 
@@ -446,6 +767,168 @@ void HelpCmd::gameoflifeUsage(std::ostream& stream)
         stream << "                        'random' display a random pattern"         << std::endl;
         stream << "                        'glider' display a glider pattern"         << std::endl;
         stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --rule={rule}           automaton rule (B3/S23 by default)"    << std::endl;
+        stream << "    --pattern-file={file}   RLE or Life 1.06 pattern collection"   << std::endl;
+        stream << "    --pattern={name}        pattern name or number in the file"    << std::endl;
+        stream << "    --cycle={policy}        on cycle: reseed, perturb or freeze"   << std::endl;
+        stream << "    --history={count}       cycle detection window (64)"           << std::endl;
+        stream << "    --hashlife              simulate an unbounded world"           << std::endl;
+        stream << "    --step={log2}           2^log2 generations per frame"          << std::endl;
+        stream << "    --memory={MiB}          node cache limit"                      << std::endl;
+        stream << "    --world={W}x{H}         simulate a large torus"                << std::endl;
+        stream << "    --threads={count}       number of worker threads"              << std::endl;
+        stream << "    --zoom                  display the whole world downsampled"   << std::endl;
+        stream << "    --search[={soups}]      search long-lived 8x8 random soups"    << std::endl;
+        stream << "    --top={count}           number of soups to keep (8)"           << std::endl;
+        stream << "    --sim-rate={hz}         simulation steps per second"           << std::endl;
+        stream << "    --fps={hz}              displayed frames per second"           << std::endl;
+        stream << "    --rewind={count}        generations kept for rewind (1024)"    << std::endl;
+        stream << "    --no-echo               light pads at the next frame only"     << std::endl;
+        stream << "    --latency               measure the press to LED latency"      << std::endl;
+        stream << "    --gestures              hold, double tap, chord and swipe"     << std::endl;
+        stream << "    --coalesce              merge the key events of a frame"       << std::endl;
+        stream << ""                                                                  << std::endl;
+    }
+}
+
+void HelpCmd::playUsage(std::ostream& stream)
+{
+    if(stream.good()) {
+        stream << "Usage: " << _program << ' ' << "[options] play {file}"             << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Play a sequence file on the Launchpad"                             << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Arguments:"                                                        << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    file                specifies the sequence file to play"       << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --start={frame}         start playing at the given frame"      << std::endl;
+        stream << "    --loop                  loop forever"                          << std::endl;
+        stream << ""                                                                  << std::endl;
+    }
+}
+
+void HelpCmd::imageUsage(std::ostream& stream)
+{
+    if(stream.good()) {
+        stream << "Usage: " << _program << ' ' << "[options] image {file} [{file}...]" << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Display one or more images on the Launchpad"                       << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Arguments:"                                                        << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    file                specifies a PPM, PGM or farbfeld image"    << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --dither={mode}         none, ordered or floyd-steinberg"      << std::endl;
+        stream << "    --loop                  loop forever"                          << std::endl;
+        stream << "    --save={file}           save as a sequence file instead"       << std::endl;
+        stream << ""                                                                  << std::endl;
+    }
+}
+
+void HelpCmd::fxUsage(std::ostream& stream)
+{
+    if(stream.good()) {
+        stream << "Usage: " << _program << ' ' << "[options] fx {effect}"             << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Display a procedural effect on the Launchpad"                      << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Arguments:"                                                        << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    effect              specifies the effect to display:"          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "                        'plasma' interfering sine waves"           << std::endl;
+        stream << "                        'fire'   rising flames"                    << std::endl;
+        stream << "                        'waves'  radial waves"                     << std::endl;
+        stream << "                        'noise'  drifting value noise"             << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --subframes[={count}]   temporal dithering (64 colors)"        << std::endl;
+        stream << "    --fps={hz}              displayed frames per second"           << std::endl;
+        stream << "    --coalesce              merge the key events of a frame"       << std::endl;
+        stream << ""                                                                  << std::endl;
+    }
+}
+
+void HelpCmd::runUsage(std::ostream& stream)
+{
+    if(stream.good()) {
+        stream << "Usage: " << _program << ' ' << "[options] run {script}"            << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Run an animation script on the Launchpad"                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Arguments:"                                                        << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    script              specifies the script file to run"          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --subframes[={count}]   temporal dithering (64 colors)"        << std::endl;
+        stream << "    --fps={hz}              displayed frames per second"           << std::endl;
+        stream << "    --coalesce              merge the key events of a frame"       << std::endl;
+        stream << ""                                                                  << std::endl;
+    }
+}
+
+void HelpCmd::spectrumUsage(std::ostream& stream)
+{
+    if(stream.good()) {
+        stream << "Usage: " << _program << ' ' << "[options] spectrum [{file}]"       << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Display the spectrum of a raw PCM stream on the Launchpad"         << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Arguments:"                                                        << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    file                specifies the PCM file ('-' for stdin)"    << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --format={format}       s16 (default) or f32"                  << std::endl;
+        stream << "    --rate={hz}             sample rate (44100 by default)"        << std::endl;
+        stream << "    --channels={count}      interleaved channels (2 by default)"   << std::endl;
+        stream << "    --fft={size}            FFT size (1024 by default)"            << std::endl;
+        stream << "    --fps={hz}              displayed frames per second"           << std::endl;
+        stream << ""                                                                  << std::endl;
+    }
+}
+
+void HelpCmd::sequencerUsage(std::ostream& stream)
+{
+    if(stream.good()) {
+        stream << "Usage: " << _program << ' ' << "[options] sequencer"               << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Play an 8-track by 8-step pattern on a MIDI output"                << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --bpm={tempo}           tempo in beats per minute (120)"       << std::endl;
+        stream << "    --gate={percent}        note length in percent of a step (50)" << std::endl;
+        stream << "    --channel={channel}     MIDI channel of the notes (10)"        << std::endl;
+        stream << "    --output={port}         MIDI output (virtual by default)"      << std::endl;
+        stream << "    --fps={hz}              displayed frames per second"           << std::endl;
+        stream << ""                                                                  << std::endl;
+    }
+}
+
+void HelpCmd::monitorUsage(std::ostream& stream)
+{
+    if(stream.good()) {
+        stream << "Usage: " << _program << ' ' << "[options] monitor"                 << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Print the decoded MIDI input of the Launchpad"                     << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "Options:"                                                          << std::endl;
+        stream << ""                                                                  << std::endl;
+        stream << "    --flush={ms}            output flush interval (100)"           << std::endl;
+        stream << "    --binary                binary records instead of text"        << std::endl;
+        stream << ""                                                                  << std::endl;
     }
 }
 
@@ -463,6 +946,9 @@ ListCmd::ListCmd ( Launchpad&     launchpad
                  , const uint64_t delay )
     : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
 {
+    for(auto& option : _options) {
+        lp::invalid_option(option);
+    }
     if(_arglist.count() != 0) {
         throw std::runtime_error("invalid argument count");
     }
@@ -520,6 +1006,9 @@ ResetCmd::ResetCmd ( Launchpad&     launchpad
                    , const uint64_t delay )
     : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
 {
+    for(auto& option : _options) {
+        lp::invalid_option(option);
+    }
     if(_arglist.count() != 0) {
         throw std::runtime_error("invalid argument count");
     }
@@ -547,7 +1036,20 @@ CycleCmd::CycleCmd ( Launchpad&     launchpad
                    , const Console& console
                    , const uint64_t delay )
     : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
+    , _lookahead(TimelinePlayer::DEFAULT_LOOKAHEAD)
+    , _subframes(0)
 {
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--lookahead")) {
+            _lookahead = lp::parse_lookahead(option);
+        }
+        else if(lp::is_option(option, "--subframes")) {
+            _subframes = lp::parse_subframes(option);
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
     if(_arglist.count() != 0) {
         throw std::runtime_error("invalid argument count");
     }
@@ -560,40 +1062,44 @@ CycleCmd::~CycleCmd()
 
 void CycleCmd::execute()
 {
-    auto begin = [&]() -> void
+    auto temporal = [&]() -> void
     {
-        _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER1, lp::NO_FLASH, lp::NO_COPY);
-    };
+        constexpr uint64_t levels = 8;
+        constexpr uint64_t colors = levels * levels;
+        const     uint64_t delay  = (16 * _delay) / colors;
 
-    auto end = [&]() -> void
-    {
-        _launchpad.setBuffer(lp::BUFFER1, lp::BUFFER0, lp::NO_FLASH, lp::DO_COPY);
-        _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER0, lp::NO_FLASH, lp::NO_COPY);
-        sleep(_delay);
+        TemporalRenderer renderer(_launchpad, _subframes);
+        DeepFrame        frame;
+        for(uint64_t index = 0; index < colors; ++index) {
+            if(_stop != false) {
+                break;
+            }
+            const uint8_t red   = ((index / levels) * 255) / (levels - 1);
+            const uint8_t green = ((index % levels) * 255) / (levels - 1);
+            frame.fill(red, green);
+            renderer.render(frame, delay);
+        }
     };
 
-    auto display = [&](const uint8_t color) -> void
-    {
-        for(uint8_t row = 0; row < lp::ROWS; ++row) {
-            for(uint8_t col = 0; col < lp::COLS; ++col) {
-                _launchpad.setPad(row, col, color);
-            }
-        }
-    };
+    if(_subframes != 0) {
+        temporal();
+        return;
+    }
 
-    for(int r = 0; r < 256; r += 85) {
-        if(_stop != false) {
-            break;
-        }
-        for(int g = 0; g < 256; g += 85) {
-            if(_stop != false) {
-                break;
-            }
-            begin();
-            display(_launchpad.makeColor(r, g));
-            end();
-        }
+    constexpr uint64_t levels = 4;
+    constexpr uint64_t colors = levels * levels;
+
+    Timeline    timeline(_delay, colors * _delay);
+    ColorTrack& track(timeline.add<ColorTrack>(_launchpad));
+    for(uint64_t index = 0; index < colors; ++index) {
+        const uint8_t red   = (index / levels) * 85;
+        const uint8_t green = (index % levels) * 85;
+        track.add(index * _delay, red, green, Tween::kSTEP);
     }
+
+    Renderer       renderer(_launchpad);
+    TimelinePlayer player(timeline, renderer, _lookahead);
+    player.play(_stop);
 }
 
 }
@@ -610,7 +1116,16 @@ PrintCmd::PrintCmd ( Launchpad&     launchpad
                    , const uint64_t delay )
     : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
     , _text()
+    , _lookahead(TimelinePlayer::DEFAULT_LOOKAHEAD)
 {
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--lookahead")) {
+            _lookahead = lp::parse_lookahead(option);
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
     if(_arglist.count() != 1) {
         throw std::runtime_error("invalid argument count");
     }
@@ -626,7 +1141,17 @@ PrintCmd::~PrintCmd()
 
 void PrintCmd::execute()
 {
-    lp::print(_launchpad, _text, _red, _black, _delay, _stop);
+    const uint64_t count = _text.size();
+
+    Timeline    timeline(_delay, count * _delay);
+    GlyphTrack& track(timeline.add<GlyphTrack>(Palettes::TABLE(Colors::RED), Palettes::TABLE(Colors::BLACK)));
+    for(uint64_t index = 0; index < count; ++index) {
+        track.add(index * _delay, _text[index]);
+    }
+
+    Renderer       renderer(_launchpad);
+    TimelinePlayer player(timeline, renderer, _lookahead);
+    player.play(_stop);
 }
 
 }
@@ -643,7 +1168,16 @@ ScrollCmd::ScrollCmd ( Launchpad&     launchpad
                      , const uint64_t delay )
     : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
     , _text()
+    , _lookahead(TimelinePlayer::DEFAULT_LOOKAHEAD)
 {
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--lookahead")) {
+            _lookahead = lp::parse_lookahead(option);
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
     if(_arglist.count() != 1) {
         throw std::runtime_error("invalid argument count");
     }
@@ -659,7 +1193,17 @@ ScrollCmd::~ScrollCmd()
 
 void ScrollCmd::execute()
 {
-    lp::scroll(_launchpad, _text, _red, _black, _delay, _stop);
+    const uint64_t size = _text.size();
+    const uint64_t pixs = lp::COLS * (size > 0 ? size - 1 : 0);
+
+    Timeline     timeline(_delay, pixs * _delay);
+    ScrollTrack& track(timeline.add<ScrollTrack>(_text, Palettes::TABLE(Colors::RED), Palettes::TABLE(Colors::BLACK)));
+    track.add(0, 0, Tween::kLINEAR);
+    track.add(pixs * _delay, pixs, Tween::kLINEAR);
+
+    Renderer       renderer(_launchpad);
+    TimelinePlayer player(timeline, renderer, _lookahead);
+    player.play(_stop);
 }
 
 }
@@ -675,17 +1219,70 @@ MatrixCmd::MatrixCmd ( Launchpad&     launchpad
                      , const Console& console
                      , const uint64_t delay )
     : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
-    , _color0(_launchpad.makeColor(0, 0))
-    , _color1(_launchpad.makeColor(0, 85))
-    , _color2(_launchpad.makeColor(0, 170))
-    , _color3(_launchpad.makeColor(0, 255))
-    , _color4(_launchpad.makeColor(255, 255))
-    , _color5(_launchpad.makeColor(255, 0))
-    , _matrix()
+    , _effect(Effect::kMATRIX)
+    , _simRate(0)
+    , _fps(0)
+    , _subframes(0)
+    , _particles()
+    , _physics()
+    , _rate(0)
+    , _emission(0)
+    , _speed(0)
+    , _frame()
+    , _renderer(_launchpad)
 {
+    size_t particles = ParticleSystem::DEFAULT_CAPACITY;
+    bool   coalesce  = false;
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--effect")) {
+            const std::string effect(lp::option_value(option));
+            if(effect == "matrix") {
+                _effect = Effect::kMATRIX;
+            }
+            else if(effect == "sparks") {
+                _effect = Effect::kSPARKS;
+            }
+            else if(effect == "fireworks") {
+                _effect = Effect::kFIREWORKS;
+            }
+            else {
+                lp::invalid_option(option);
+            }
+        }
+        else if(lp::is_option(option, "--particles")) {
+            particles = lp::parse_uint(option, 1, ParticleSystem::MAXIMUM_CAPACITY);
+        }
+        else if(lp::is_option(option, "--subframes")) {
+            _subframes = lp::parse_subframes(option);
+        }
+        else if(lp::is_option(option, "--sim-rate")) {
+            _simRate = lp::parse_rate(option);
+        }
+        else if(lp::is_option(option, "--fps")) {
+            _fps = lp::parse_rate(option);
+        }
+        else if(lp::is_option(option, "--no-echo")) {
+            _renderer.setImmediate(false);
+        }
+        else if(lp::is_option(option, "--latency")) {
+            _renderer.setMeasured(true);
+        }
+        else if(lp::is_option(option, "--coalesce")) {
+            coalesce = true;
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
     if(_arglist.count() != 0) {
         throw std::runtime_error("invalid argument count");
     }
+    if((_subframes != 0) && _renderer.measured()) {
+        throw std::runtime_error("--latency is not supported with --subframes");
+    }
+    _particles.reset(new ParticleSystem(particles, Random::seed()));
+    queueInput(coalesce);
+    _paced = true;
 }
 
 MatrixCmd::~MatrixCmd()
@@ -696,11 +1293,46 @@ MatrixCmd::~MatrixCmd()
 void MatrixCmd::execute()
 {
     if(_stop == false) {
-        init();
+        const uint64_t step  = lp::rate_period(_simRate, (1000000UL / DEFAULT_SIM_RATE));
+        const uint64_t frame = lp::rate_period(_fps, _delay);
+        Pacer          pacer(step, frame, *_clock);
+        Frame          quantized;
+        std::unique_ptr<TemporalRenderer> temporal(_subframes != 0 ? new TemporalRenderer(_launchpad, _subframes) : nullptr);
+
+        auto display = [&]() -> void
+        {
+            if(temporal) {
+                temporal->render(_frame, frame);
+                return;
+            }
+            for(uint8_t row = 0; row < ROWS; ++row) {
+                for(uint8_t col = 0; col < COLS; ++col) {
+                    quantized.data[row][col] = Palettes::TABLE(Color(_frame.red[row][col], _frame.green[row][col]));
+                }
+            }
+            _renderer.render(quantized);
+        };
+
+        init(step);
+        loop(0);
+        display();
         do {
-            loop();
-            wait();
+            /* the input is drained on every frame, even without any step */
+            const unsigned steps = drainInput(pacer.wait());
+            if((steps != 0) || hasEvents()) {
+                loop(steps);
+                display();
+            }
         } while(_stop == false);
+        if((_simRate != 0) || (_fps != 0)) {
+            println(lp::pacing(pacer));
+        }
+        if(_renderer.measured()) {
+            println(lp::latency(_renderer));
+        }
+        if(_coalesce || (_input->overflows() != 0)) {
+            println(lp::input(*_input));
+        }
     }
 }
 
@@ -708,8 +1340,17 @@ void MatrixCmd::onLaunchpadGridKey(const uint8_t key, const uint8_t velocity)
 {
     const uint8_t row = key / 16;
     const uint8_t col = key % 16;
-    if((row < ROWS) && (col < COLS)) {
-        _matrix.data[row % ROWS][col % COLS] = Cell::kLEVEL5;
+
+    if((row < ROWS) && (col < COLS) && (velocity != 0)) {
+        const int32_t x = col * ParticleSystem::ONE;
+        const int32_t y = row * ParticleSystem::ONE;
+        if(_effect == Effect::kMATRIX) {
+            _particles->spawn(ParticleKind::kDROP, x, y, 0, _speed, 0, 255, 255);
+        }
+        else {
+            /* a motionless rocket explodes at the next step */
+            _particles->spawn(ParticleKind::kROCKET, x, y, 0, 0, 0, 255, 255);
+        }
     }
 }
 
@@ -719,107 +1360,137 @@ void MatrixCmd::onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity)
     static_cast<void>(velocity);
 }
 
-void MatrixCmd::init()
+void MatrixCmd::onInputQueued(const InputEvent& event)
 {
-    ::srand(::time(nullptr));
+    const uint8_t row = event.key / 16;
+    const uint8_t col = event.key % 16;
+
+    /* the pad lights up at once, the particle shows up at the next step */
+    if((event.type == InputType::kGRID_KEY) && (row < ROWS) && (col < COLS) && (event.velocity != 0) && (_subframes == 0)) {
+        _renderer.echo(row, col, _launchpad.makeColor(255, 255));
+    }
 }
 
-void MatrixCmd::loop()
+void MatrixCmd::init(const uint64_t step)
 {
-    auto color = [&](const Cell cell) -> uint8_t
+    const double seconds = static_cast<double>(step) / 1000000.0;
+
+    /* the effects are given in pads and seconds, then converted to steps */
+    auto speed = [&](const double pads_per_second) -> int32_t
     {
-        switch(cell) {
-            case Cell::kLEVEL0:
-                return _color0;
-            case Cell::kLEVEL1:
-                return _color1;
-            case Cell::kLEVEL2:
-                return _color2;
-            case Cell::kLEVEL3:
-                return _color3;
-            case Cell::kLEVEL4:
-                return _color4;
-            case Cell::kLEVEL5:
-                return _color5;
-            default:
-                break;
-        }
-        return _black;
+        return static_cast<int32_t>(pads_per_second * seconds * ParticleSystem::ONE);
     };
 
-    auto mutate = [&](const Cell cell) -> Cell
+    auto acceleration = [&](const double pads_per_second2) -> int32_t
     {
-        switch(cell) {
-            case Cell::kLEVEL5:
-                return Cell::kLEVEL4;
-            case Cell::kLEVEL4:
-                return Cell::kLEVEL3;
-            case Cell::kLEVEL3:
-                return Cell::kLEVEL2;
-            case Cell::kLEVEL2:
-                return Cell::kLEVEL1;
-            case Cell::kLEVEL1:
-                return Cell::kLEVEL0;
-            case Cell::kLEVEL0:
-                return Cell::kLEVEL0;
-            default:
-                break;
-        }
-        return cell;
+        return static_cast<int32_t>(pads_per_second2 * seconds * seconds * ParticleSystem::ONE);
     };
 
-    auto display = [&]() -> void
+    auto fade = [&](const double duration) -> int32_t
     {
-        _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER1, lp::NO_FLASH, lp::NO_COPY);
-        for(uint8_t row = 0; row < ROWS; ++row) {
-            for(uint8_t col = 0; col < COLS; ++col) {
-                const Cell& cell(_matrix.get(row, col));
-                _launchpad.setPad(row, col, color(cell));
-            }
-        }
-        _launchpad.setBuffer(lp::BUFFER1, lp::BUFFER0, lp::NO_FLASH, lp::DO_COPY);
-        _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER0, lp::NO_FLASH, lp::NO_COPY);
+        const int32_t decay = static_cast<int32_t>((seconds / duration) * ParticleSystem::BRIGHTNESS);
+        return (decay > 0 ? decay : 1);
     };
 
-    auto prepare = [&]() -> void
+    auto rate = [&](const double per_second) -> uint32_t
     {
+        return static_cast<uint32_t>(per_second * seconds * 65536.0);
     };
 
-    auto process = [&]() -> void
+    _physics.burst = 32;
+    _physics.speed = speed(4.0);
+    _physics.fade  = fade(0.8);
+    switch(_effect) {
+        case Effect::kMATRIX:
+            _physics.trail = fade(0.6);
+            _physics.red   = 0;
+            _physics.green = 255;
+            _rate          = rate(4.0);
+            _speed         = speed(5.0);
+            break;
+        case Effect::kSPARKS:
+            _physics.gravity = acceleration(12.0);
+            _rate            = rate(150.0);
+            _speed           = speed(9.0);
+            break;
+        case Effect::kFIREWORKS:
+            _physics.gravity = acceleration(9.0);
+            _physics.burst   = 48;
+            _physics.fade    = fade(1.0);
+            _rate            = rate(1.2);
+            _speed           = speed(8.5);
+            break;
+        default:
+            break;
+    }
+}
+
+void MatrixCmd::loop(const unsigned steps)
+{
+    for(unsigned step = 0; step < steps; ++step) {
+        emit();
+        _particles->update(_physics);
+    }
+    _particles->render(_frame);
+}
+
+void MatrixCmd::emit()
+{
+    constexpr int32_t ONE    = ParticleSystem::ONE;
+    constexpr int32_t BOTTOM = 8 * ONE;
+
+    struct Tint
     {
-        for(uint8_t row = 0; row < ROWS; ++row) {
-            for(uint8_t col = 0; col < COLS; ++col) {
-                const Cell& prev(_matrix.get(((ROWS - 1) - row - 1), col));
-                Cell&       cell(_matrix.get(((ROWS - 1) - row - 0), col));
-                if(prev == Cell::kLEVEL5) {
-                    cell = prev;
-                }
-                else {
-                    cell = mutate(cell);
-                }
-            }
-        }
+        uint8_t red;
+        uint8_t green;
+    };
+
+    static const Tint tints[] = {
+        { 255,   0 },
+        { 255,  80 },
+        { 255, 255 },
+        {   0, 255 },
     };
 
-    auto finalize = [&]() -> void
+    auto uniform = [&](const int32_t lower, const int32_t upper) -> int32_t
     {
-        const uint8_t row = 0;
-        const uint8_t col = ::rand() % 31;
-        if(col < COLS) {
-            _matrix.data[row][col] = Cell::kLEVEL5;
-        }
+        return lower + static_cast<int32_t>(_particles->random() % static_cast<uint32_t>((upper - lower) + 1));
     };
 
-    display();
-    prepare();
-    process();
-    finalize();
-}
+    auto tint = [&](const unsigned count) -> const Tint&
+    {
+        return tints[_particles->random() % count];
+    };
 
-void MatrixCmd::wait()
-{
-    if(_stop == false) {
-        sleep(_delay);
+    for(_emission += _rate; _emission >= 65536; _emission -= 65536) {
+        switch(_effect) {
+            case Effect::kMATRIX:
+                _particles->spawn ( ParticleKind::kDROP
+                                  , (uniform(0, (COLS - 1)) * ONE), -ONE
+                                  , 0, uniform((_speed / 2), _speed)
+                                  , 0, 255, 255 );
+                break;
+            case Effect::kSPARKS:
+                {
+                    const Tint& color(tint(3));
+                    _particles->spawn ( ParticleKind::kSPARK
+                                      , uniform((3 * ONE), (4 * ONE)), BOTTOM
+                                      , uniform((-_speed / 4), (_speed / 4)), -uniform((_speed * 3 / 5), _speed)
+                                      , _physics.fade, color.red, color.green );
+                }
+                break;
+            case Effect::kFIREWORKS:
+                {
+                    const Tint& color(tint(4));
+                    _particles->spawn ( ParticleKind::kROCKET
+                                      , uniform((1 * ONE), (6 * ONE)), BOTTOM
+                                      , uniform((-_speed / 10), (_speed / 10)), -uniform(_speed, (_speed * 5 / 4))
+                                      , 0, color.red, color.green );
+                }
+                break;
+            default:
+                break;
+        }
     }
 }
 
@@ -837,14 +1508,113 @@ GameOfLifeCmd::GameOfLifeCmd ( Launchpad&     launchpad
                              , const uint64_t delay )
     : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
     , _variant()
-    , _color0(_launchpad.makeColor(0, 0))
-    , _color1(_launchpad.makeColor(64, 0))
-    , _color2(_launchpad.makeColor(255, 0))
-    , _color3(_launchpad.makeColor(255, 255))
-    , _color4(_launchpad.makeColor(0, 255))
-    , _world()
-    , _cache()
+    , _simRate(0)
+    , _fps(0)
+    , _rule()
+    , _world(_rule)
+    , _step(0)
+    , _memory(0)
+    , _threads(0)
+    , _zoom(false)
+    , _hashlife()
+    , _pool()
+    , _tiled()
+    , _patterns()
+    , _pattern(nullptr)
+    , _policy(CyclePolicy::kNONE)
+    , _cycle()
+    , _soups(0)
+    , _search()
+    , _leaders()
+    , _leader(0)
+    , _generation(0)
+    , _history()
+    , _rewind(0)
+    , _live()
+    , _frozen(false)
+    , _viewX(-4)
+    , _viewY(-4)
+    , _renderer(_launchpad)
+    , _random(Random::seed())
+    , _gestures()
 {
+    bool        hashlife = false;
+    bool        rule     = false;
+    bool        gestures = false;
+    bool        coalesce = false;
+    unsigned    history  = 0;
+    unsigned    top      = 0;
+    uint64_t    rewind   = 0;
+    uint32_t    width    = 0;
+    uint32_t    height   = 0;
+    std::string pattern_file;
+    std::string pattern;
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--hashlife")) {
+            hashlife = true;
+        }
+        else if(lp::is_option(option, "--rule")) {
+            _rule = LifeRule(lp::option_value(option));
+            rule  = true;
+        }
+        else if(lp::is_option(option, "--pattern-file")) {
+            pattern_file = lp::option_value(option);
+        }
+        else if(lp::is_option(option, "--pattern")) {
+            pattern = lp::option_value(option);
+        }
+        else if(lp::is_option(option, "--cycle")) {
+            _policy = CycleDetector::policy(lp::option_value(option));
+        }
+        else if(lp::is_option(option, "--history")) {
+            history = lp::parse_uint(option, 1, CycleDetector::MAXIMUM_WINDOW);
+        }
+        else if(lp::is_option(option, "--world")) {
+            TiledWorld::parse(lp::option_value(option), width, height);
+        }
+        else if(lp::is_option(option, "--threads")) {
+            _threads = lp::parse_uint(option, 1, 256);
+        }
+        else if(lp::is_option(option, "--zoom")) {
+            _zoom = true;
+        }
+        else if(lp::is_option(option, "--step")) {
+            _step = lp::parse_uint(option, 0, HashLife::MAXIMUM_STEP);
+        }
+        else if(lp::is_option(option, "--memory")) {
+            _memory = lp::parse_uint(option, 1, 65536);
+        }
+        else if(lp::is_option(option, "--search")) {
+            _soups = (lp::option_value(option).empty() ? DEFAULT_SOUPS : lp::parse_uint(option, 1, (1ULL << 40)));
+        }
+        else if(lp::is_option(option, "--top")) {
+            top = lp::parse_uint(option, 1, SoupSearch::MAX_TOP);
+        }
+        else if(lp::is_option(option, "--sim-rate")) {
+            _simRate = lp::parse_rate(option);
+        }
+        else if(lp::is_option(option, "--fps")) {
+            _fps = lp::parse_rate(option);
+        }
+        else if(lp::is_option(option, "--rewind")) {
+            rewind = lp::parse_uint(option, LifeHistory::KEYFRAME, MAXIMUM_REWIND);
+        }
+        else if(lp::is_option(option, "--no-echo")) {
+            _renderer.setImmediate(false);
+        }
+        else if(lp::is_option(option, "--latency")) {
+            _renderer.setMeasured(true);
+        }
+        else if(lp::is_option(option, "--gestures")) {
+            gestures = true;
+        }
+        else if(lp::is_option(option, "--coalesce")) {
+            coalesce = true;
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
     if(_arglist.count() == 0) {
         /* default */
     }
@@ -854,6 +1624,85 @@ GameOfLifeCmd::GameOfLifeCmd ( Launchpad&     launchpad
     else {
         throw std::runtime_error("invalid argument count");
     }
+    if(pattern_file.empty() == false) {
+        if(_variant.empty() == false) {
+            throw std::runtime_error("--pattern-file and {pattern} are mutually exclusive");
+        }
+        _patterns.reset(new PatternFile(pattern_file));
+        _pattern = (pattern.empty() ? &_patterns->at(0) : &_patterns->find(pattern));
+        if((rule == false) && (_pattern->rule.empty() == false)) {
+            _rule = LifeRule(_pattern->rule);
+        }
+    }
+    else if(pattern.empty() == false) {
+        throw std::runtime_error("--pattern requires --pattern-file");
+    }
+    if((hashlife != false) && (width != 0)) {
+        throw std::runtime_error("--hashlife and --world are mutually exclusive");
+    }
+    if(hashlife != false) {
+        const size_t nodes = (_memory != 0 ? HashLife::capacity(_memory << 20) : HashLife::DEFAULT_MAX_NODES);
+        _hashlife.reset(new HashLife(_rule, nodes));
+    }
+    else if(_memory != 0) {
+        throw std::runtime_error("--memory requires --hashlife");
+    }
+    if((_soups != 0) && ((width != 0) || _hashlife || (_pattern != nullptr) || (_variant.empty() == false) || (_policy != CyclePolicy::kNONE))) {
+        throw std::runtime_error("--search only runs on a random 8x8 torus");
+    }
+    if(width != 0) {
+        if(_step > TiledWorld::MAX_STEP) {
+            throw std::runtime_error("--step is too large for --world");
+        }
+        _pool.reset(new ThreadPool(_threads));
+        _tiled.reset(new TiledWorld(_rule, width, height, *_pool));
+        _viewX = (width  / 2) - (COLS / 2);
+        _viewY = (height / 2) - (ROWS / 2);
+    }
+    else if(_soups != 0) {
+        _pool.reset(new ThreadPool(_threads));
+        _search.reset(new SoupSearch(_rule, *_pool, Random::seed(), (top != 0 ? top : DEFAULT_TOP)));
+    }
+    else if(_threads != 0) {
+        throw std::runtime_error("--threads requires --world or --search");
+    }
+    if((_zoom != false) && !_tiled) {
+        throw std::runtime_error("--zoom requires --world");
+    }
+    if((top != 0) && !_search) {
+        throw std::runtime_error("--top requires --search");
+    }
+    if((_pattern != nullptr) && !_hashlife && !_tiled) {
+        int64_t x, y, cols, rows;
+        _patterns->bounds(*_pattern, x, y, cols, rows);
+        if((cols > COLS) || (rows > ROWS)) {
+            const std::string name(_pattern->name.empty() == false ? _pattern->name : (pattern.empty() == false ? pattern : std::string("1")));
+            throw std::runtime_error(std::string("pattern") + ' ' + '<' + name + '>' + ' ' + "is" + ' ' + std::to_string(cols) + 'x' + std::to_string(rows) + ',' + ' ' + "larger than the 8x8 torus, use --world or --hashlife");
+        }
+    }
+    if((_step != 0) && !_hashlife && !_tiled) {
+        throw std::runtime_error("--step requires --hashlife or --world");
+    }
+    if(_policy != CyclePolicy::kNONE) {
+        _cycle.reset(new CycleDetector(history != 0 ? history : CycleDetector::DEFAULT_WINDOW));
+    }
+    else if(history != 0) {
+        throw std::runtime_error("--history requires --cycle");
+    }
+    /* the history is only kept for the plain 8x8 torus */
+    if(_hashlife || _tiled || _search) {
+        if(rewind != 0) {
+            throw std::runtime_error("--rewind cannot be used with --hashlife, --world or --search");
+        }
+    }
+    else {
+        _history.reset(new LifeHistory(rewind != 0 ? rewind : DEFAULT_REWIND));
+    }
+    if(gestures != false) {
+        _gestures.reset(new GestureRecognizer(*this));
+    }
+    queueInput(coalesce);
+    _paced = true;
 }
 
 GameOfLifeCmd::~GameOfLifeCmd()
@@ -863,12 +1712,34 @@ GameOfLifeCmd::~GameOfLifeCmd()
 
 void GameOfLifeCmd::execute()
 {
+    if(_search) {
+        search();
+    }
     if(_stop == false) {
+        Pacer pacer(lp::rate_period(_simRate, _delay), lp::rate_period(_fps, _delay), *_clock);
         init();
+        loop(0);
         do {
-            loop();
-            wait();
+            const unsigned due = pacer.wait();
+            /* the holds and taps whose deadline has passed are posted before the drain */
+            if(_gestures && (_player == nullptr)) {
+                _gestures->update(GestureRecognizer::now());
+            }
+            /* the input is drained on every frame, even without any step */
+            const unsigned steps = drainInput(due);
+            if((steps != 0) || hasEvents()) {
+                loop(steps);
+            }
         } while(_stop == false);
+        if((_simRate != 0) || (_fps != 0)) {
+            println(lp::pacing(pacer));
+        }
+        if(_renderer.measured()) {
+            println(lp::latency(_renderer));
+        }
+        if(_coalesce || (_input->overflows() != 0)) {
+            println(lp::input(*_input));
+        }
     }
 }
 
@@ -877,36 +1748,108 @@ void GameOfLifeCmd::onLaunchpadGridKey(const uint8_t key, const uint8_t velocity
     const uint8_t row = key / 16;
     const uint8_t col = key % 16;
 
+    /* only a press sets a cell and resumes a frozen world */
+    if(velocity == 0) {
+        return;
+    }
     if((row < ROWS) && (col < COLS)) {
-        _world.data[row % ROWS][col % COLS] = Cell::kALIVE;
+        if(_rewind != 0) {
+            branch();
+        }
+        _frozen = false;
+        _world.set(row, col, Cell::kALIVE);
+        if(_hashlife) {
+            _hashlife->set(_viewX + col, _viewY + row, true);
+        }
+        if(_tiled && _zoom) {
+            const int64_t x = ((2 * col + 1) * static_cast<int64_t>(_tiled->width())) / (2 * COLS);
+            const int64_t y = ((2 * row + 1) * static_cast<int64_t>(_tiled->height())) / (2 * ROWS);
+            _tiled->set(x, y, 1);
+        }
+        else if(_tiled) {
+            _tiled->set(_viewX + col, _viewY + row, 1);
+        }
     }
 }
 
 void GameOfLifeCmd::onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity)
 {
-    static_cast<void>(key);
-    static_cast<void>(velocity);
+    if(velocity == 0) {
+        return;
+    }
+    switch(key) {
+        case 0x68: /* up    */
+            pan(0, -1);
+            break;
+        case 0x69: /* down  */
+            pan(0, +1);
+            break;
+        case 0x6a: /* left  */
+            pan(-1, 0);
+            break;
+        case 0x6b: /* right */
+            pan(+1, 0);
+            break;
+        case 0x6c: /* rewind one generation        */
+            rewind(+1);
+            break;
+        case 0x6d: /* fast-forward one generation  */
+            rewind(-1);
+            break;
+        case 0x6e: /* rewind a few generations     */
+            rewind(+REWIND_SKIP);
+            break;
+        case 0x6f: /* fast-forward a few generations */
+            rewind(-REWIND_SKIP);
+            break;
+        default:
+            break;
+    }
 }
 
-void GameOfLifeCmd::init()
+void GameOfLifeCmd::onGesture(const Gesture& gesture)
 {
-    auto set = [&](const uint8_t row, const uint8_t col, const Cell state) -> void
-    {
-        _world.data[row % ROWS][col % COLS] = state;
-    };
+    InputEvent event = {};
+    event.type    = InputType::kGESTURE;
+    event.time    = gesture.detected;
+    event.gesture = gesture;
+    postInput(event);
+}
 
-    auto init_random = [&]() -> void
-    {
-        std::random_device entropy;
-        std::mt19937 generator(entropy());
-        std::uniform_int_distribution<uint8_t> distribute(0, 1);
+void GameOfLifeCmd::onInputQueued(const InputEvent& event)
+{
+    const uint8_t row = event.key / 16;
+    const uint8_t col = event.key % 16;
 
-        for(uint8_t row = 0; row < ROWS; ++row) {
-            for(uint8_t col = 0; col < COLS; ++col) {
-                const uint8_t value = distribute(generator);
-                set(row, col, (value != 0 ? Cell::kALIVE : Cell::kEMPTY));
-            }
+    if((event.type == InputType::kGRID_KEY) && (row < ROWS) && (col < COLS)) {
+        /* the cell lights up at once, even while a generation is computed */
+        if(event.velocity != 0) {
+            _renderer.echo(row, col, Palettes::LIFE[static_cast<uint8_t>(Cell::kALIVE)]);
         }
+    }
+}
+
+void GameOfLifeCmd::onInputEvent(const InputEvent& event)
+{
+    const uint8_t row = event.key / 16;
+    const uint8_t col = event.key % 16;
+
+    if(event.type == InputType::kGESTURE) {
+        perform(event.gesture);
+        return;
+    }
+    Command::onInputEvent(event);
+    /* the gestures are recognized from the timestamps, a replay has them recorded */
+    if(_gestures && (_player == nullptr) && (event.type == InputType::kGRID_KEY) && (row < ROWS) && (col < COLS)) {
+        _gestures->input(row, col, event.velocity, event.time);
+    }
+}
+
+void GameOfLifeCmd::init()
+{
+    auto set = [&](const uint8_t row, const uint8_t col, const Cell state) -> void
+    {
+        place((_viewX + col), (_viewY + row), (state == Cell::kALIVE ? 1 : 0));
     };
 
     auto init_glider = [&](const uint8_t row, const uint8_t col) -> void
@@ -922,11 +1865,32 @@ void GameOfLifeCmd::init()
         set((row + 1), (col + 1), Cell::kALIVE);
     };
 
-    if(_variant.empty()) {
-        init_random();
+    auto init_pattern = [&]() -> void
+    {
+        int64_t x, y, width, height;
+        _patterns->bounds(*_pattern, x, y, width, height);
+        /* the pattern is centered on the viewport */
+        const int64_t origin_x = (_viewX + (COLS / 2)) - (width  / 2) - x;
+        const int64_t origin_y = (_viewY + (ROWS / 2)) - (height / 2) - y;
+        _patterns->decode(*_pattern, [&](const int64_t cx, const int64_t cy, const uint64_t length, const unsigned state) -> void
+        {
+            for(uint64_t index = 0; index < length; ++index) {
+                place((origin_x + cx + static_cast<int64_t>(index)), (origin_y + cy), (state < _rule.states() ? state : 1));
+            }
+        });
+    };
+
+    if(_pattern != nullptr) {
+        init_pattern();
+    }
+    else if(_leaders.empty() == false) {
+        replay();
+    }
+    else if(_variant.empty()) {
+        reseed();
     }
     else if(_variant == "random") {
-        init_random();
+        reseed();
     }
     else if(_variant == "glider") {
         init_glider(1, 1);
@@ -934,124 +1898,1002 @@ void GameOfLifeCmd::init()
     else {
         throw std::runtime_error(std::string("invalid pattern") + ' ' + '<' + _variant + '>');
     }
+    sync();
+    if(_history) {
+        _history->record(_world);
+    }
 }
 
-void GameOfLifeCmd::loop()
+void GameOfLifeCmd::loop(const unsigned steps)
 {
-    auto stateOrDeath = [&](const Cell cell, const uint8_t neighbors) -> Cell
+    auto process = [&]() -> void
     {
-        if((neighbors <= 1) || (neighbors >= 4)) {
-            return Cell::kDYING;
+        uint64_t states[LifeRule::MAX_PLANES] = {};
+        if(_hashlife) {
+            _hashlife->step(_step);
+            view(states);
+            _world.advance(states);
         }
-        return cell;
-    };
-
-    auto stateOrBirth = [&](const Cell cell, const uint8_t neighbors) -> Cell
-    {
-        if(neighbors == 3) {
-            return Cell::kALIVE;
+        else if(_tiled) {
+            _tiled->step(1ULL << _step);
+            view(states);
+            _world.advance(states);
         }
-        return cell;
-    };
-
-    auto mutate = [&](const Cell cell, const uint8_t neighbors) -> Cell
-    {
-        switch(cell) {
-            case Cell::kALIVE:
-                return stateOrDeath(Cell::kALIVE, neighbors);
-            case Cell::kDYING:
-                return stateOrBirth(Cell::kDEAD, neighbors);
-            case Cell::kDEAD:
-                return stateOrBirth(Cell::kASHES, neighbors);
-            case Cell::kASHES:
-                return stateOrBirth(Cell::kEMPTY, neighbors);
-            case Cell::kEMPTY:
-                return stateOrBirth(Cell::kEMPTY, neighbors);
-            default:
-                break;
+        else {
+            _world.step();
         }
-        return cell;
-    };
-
-    auto neighbors = [&](const uint8_t row, const uint8_t col) -> uint8_t
-    {
-        uint8_t count = 0;
-
-        if(_cache.get((row - 1), (col - 1)) == Cell::kALIVE) ++count;
-        if(_cache.get((row - 1), (col | 0)) == Cell::kALIVE) ++count;
-        if(_cache.get((row - 1), (col + 1)) == Cell::kALIVE) ++count;
-        if(_cache.get((row | 0), (col - 1)) == Cell::kALIVE) ++count;
-        if(_cache.get((row | 0), (col + 1)) == Cell::kALIVE) ++count;
-        if(_cache.get((row + 1), (col - 1)) == Cell::kALIVE) ++count;
-        if(_cache.get((row + 1), (col | 0)) == Cell::kALIVE) ++count;
-        if(_cache.get((row + 1), (col + 1)) == Cell::kALIVE) ++count;
-
-        return count;
     };
 
-    auto color = [&](const Cell cell) -> uint8_t
-    {
-        switch(cell) {
-            case Cell::kEMPTY:
-                return _color0;
-            case Cell::kASHES:
-                return _color1;
-            case Cell::kDEAD:
-                return _color2;
-            case Cell::kDYING:
-                return _color3;
-            case Cell::kALIVE:
-                return _color4;
-            default:
-                break;
+    if((_frozen != false) || (_rewind != 0)) {
+        return;
+    }
+    for(unsigned step = 0; (step < steps) && (_frozen == false); ++step) {
+        process();
+        detect();
+        if((_leaders.empty() == false) && (--_generation == 0)) {
+            _leader = (_leader + 1) % _leaders.size();
+            replay();
         }
-        return _black;
-    };
-
-    auto display = [&]() -> void
-    {
-        _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER1, lp::NO_FLASH, lp::NO_COPY);
-        for(uint8_t row = 0; row < ROWS; ++row) {
-            for(uint8_t col = 0; col < COLS; ++col) {
-                const Cell& cell(_world.get(row, col));
-                _launchpad.setPad(row, col, color(cell));
-            }
+        if(_history) {
+            _history->record(_world);
         }
-        _launchpad.setBuffer(lp::BUFFER1, lp::BUFFER0, lp::NO_FLASH, lp::DO_COPY);
-        _launchpad.setBuffer(lp::BUFFER0, lp::BUFFER0, lp::NO_FLASH, lp::NO_COPY);
-    };
+    }
+    display();
+}
 
-    auto prepare = [&]() -> void
+void GameOfLifeCmd::display()
+{
+    auto color = [&](const Cell cell) -> uint8_t
     {
-        _cache = _world;
+        return Palettes::LIFE[static_cast<uint8_t>(cell)];
     };
 
-    auto process = [&]() -> void
-    {
-        for(uint8_t row = 0; row < ROWS; ++row) {
-            for(uint8_t col = 0; col < COLS; ++col) {
-                const Cell& prev(_cache.get(row, col));
-                Cell&       cell(_world.get(row, col));
-                cell = mutate(prev, neighbors(row, col));
-            }
+    Frame frame;
+    for(uint8_t row = 0; row < ROWS; ++row) {
+        for(uint8_t col = 0; col < COLS; ++col) {
+            frame.data[row][col] = color(_world.get(row, col));
         }
-    };
-
-    auto finalize = [&]() -> void
-    {
-    };
-
-    display();
-    prepare();
-    process();
-    finalize();
+    }
+    _renderer.render(frame);
 }
 
-void GameOfLifeCmd::wait()
+void GameOfLifeCmd::perform(const Gesture& gesture)
 {
-    if(_stop == false) {
-        sleep(_delay);
-    }
+    switch(gesture.type) {
+        case GestureType::kDOUBLE_TAP: /* clear the cell set by the presses */
+            if((_tiled && _zoom) == false) {
+                place((_viewX + gesture.col), (_viewY + gesture.row), 0);
+                sync();
+            }
+            break;
+        case GestureType::kHOLD: /* pause until the next press */
+            _frozen = true;
+            break;
+        case GestureType::kCHORD: /* restart from a random world */
+            if(_rewind != 0) {
+                resume();
+            }
+            reseed();
+            sync();
+            if(_cycle) {
+                _cycle->reset();
+            }
+            _frozen = false;
+            break;
+        case GestureType::kSWIPE: /* move the viewport along */
+            pan((gesture.dx * gesture.length), (gesture.dy * gesture.length));
+            break;
+        default:
+            break;
+    }
+}
+
+void GameOfLifeCmd::pan(const int64_t dx, const int64_t dy)
+{
+    if(_hashlife || (_tiled && !_zoom)) {
+        _viewX += dx;
+        _viewY += dy;
+        _frozen = false;
+        sync();
+    }
+}
+
+void GameOfLifeCmd::view(uint64_t* states) const
+{
+    if(_hashlife) {
+        states[0] = _hashlife->viewport(_viewX, _viewY);
+    }
+    else if(_tiled && _zoom) {
+        _tiled->downsample(states);
+    }
+    else if(_tiled) {
+        _tiled->viewport(_viewX, _viewY, states);
+    }
+}
+
+void GameOfLifeCmd::place(const int64_t x, const int64_t y, const unsigned state)
+{
+    if(_hashlife) {
+        _hashlife->set(x, y, (state == 1));
+    }
+    else if(_tiled) {
+        _tiled->set(x, y, state);
+    }
+    else if((x >= _viewX) && (x < (_viewX + COLS)) && (y >= _viewY) && (y < (_viewY + ROWS))) {
+        _world.set((y - _viewY), (x - _viewX), state);
+    }
+    else {
+        throw std::runtime_error("cell outside of the 8x8 torus");
+    }
+}
+
+void GameOfLifeCmd::sync()
+{
+    if(_hashlife || _tiled) {
+        uint64_t states[LifeRule::MAX_PLANES] = {};
+        view(states);
+        _world.assign(states);
+    }
+}
+
+void GameOfLifeCmd::reseed()
+{
+    _world.clear();
+    if(_tiled) {
+        _tiled->randomize(_random.next());
+    }
+    else {
+        if(_hashlife) {
+            _hashlife->clear();
+        }
+        for(uint8_t row = 0; row < ROWS; ++row) {
+            for(uint8_t col = 0; col < COLS; ++col) {
+                place((_viewX + col), (_viewY + row), static_cast<unsigned>(_random.next() >> 63));
+            }
+        }
+    }
+}
+
+void GameOfLifeCmd::perturb()
+{
+    if(_tiled && _zoom) {
+        /* a few cells per pad of the downsampled world */
+        const uint64_t width  = _tiled->width();
+        const uint64_t height = _tiled->height();
+        const uint64_t cells  = (width * height) / 1024;
+        const uint64_t count  = (cells > PERTURBATION ? cells : PERTURBATION);
+        for(uint64_t index = 0; index < count; ++index) {
+            place(_random.below(width), _random.below(height), 1);
+        }
+    }
+    else {
+        for(uint64_t index = 0; index < PERTURBATION; ++index) {
+            place((_viewX + static_cast<int64_t>(_random.below(COLS))), (_viewY + static_cast<int64_t>(_random.below(ROWS))), 1);
+        }
+    }
+}
+
+void GameOfLifeCmd::detect()
+{
+    if(_policy == CyclePolicy::kNONE) {
+        return;
+    }
+    uint64_t hash = _world.hash();
+    if(_tiled) {
+        hash = CycleDetector::mix(hash ^ _tiled->hash());
+    }
+    if(_cycle->update(hash) == 0) {
+        return;
+    }
+    switch(_policy) {
+        case CyclePolicy::kRESEED:
+            reseed();
+            sync();
+            break;
+        case CyclePolicy::kPERTURB:
+            perturb();
+            if(_hashlife || _tiled) {
+                uint64_t states[LifeRule::MAX_PLANES] = {};
+                view(states);
+                _world.advance(states);
+            }
+            break;
+        case CyclePolicy::kFREEZE:
+            _frozen = true;
+            break;
+        default:
+            break;
+    }
+    _cycle->reset();
+}
+
+void GameOfLifeCmd::search()
+{
+    using clock = std::chrono::steady_clock;
+    char buffer[256];
+
+    auto check = [&](const int rc) -> void
+    {
+        if((rc < 0) || (rc >= static_cast<int>(sizeof(buffer)))) {
+            throw std::runtime_error("snprintf() has failed");
+        }
+    };
+
+    const auto start = clock::now();
+    while((_stop == false) && (_search->evaluated() < _soups)) {
+        const uint64_t remaining = _soups - _search->evaluated();
+        _search->run(remaining < SEARCH_ROUND ? remaining : SEARCH_ROUND);
+    }
+    const auto     elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+    const double   seconds = static_cast<double>(elapsed > 0 ? elapsed : 1) / 1000000.0;
+    const uint64_t soups   = _search->evaluated();
+
+    check(::snprintf(buffer, sizeof(buffer), "%llu soups in %.3f s (%.0f soups/s, %u threads)", static_cast<unsigned long long>(soups), seconds, (soups / seconds), static_cast<unsigned>(_pool->threads())));
+    println(buffer);
+    println();
+    _leaders = _search->leaders();
+    for(size_t index = 0; index < _leaders.size(); ++index) {
+        const Soup& soup(_leaders[index]);
+        check(::snprintf(buffer, sizeof(buffer), "#%-2u seed=%016llx lifespan=%-5u period=%-3u population=%u", static_cast<unsigned>(index + 1), static_cast<unsigned long long>(soup.seed), soup.lifespan, soup.period, soup.population));
+        println(buffer);
+    }
+    println();
+}
+
+void GameOfLifeCmd::replay()
+{
+    const Soup&    soup(_leaders[_leader]);
+    const uint64_t board = SoupSearch::board(soup.seed);
+
+    /* the soup is shown from its start until it has cycled twice */
+    _world.clear();
+    _world.assign(&board);
+    _generation = soup.lifespan + 2 * soup.period + 1;
+}
+
+void GameOfLifeCmd::rewind(const int64_t generations)
+{
+    if(!_history || _history->empty() || ((_rewind == 0) && (generations < 0))) {
+        return;
+    }
+    const int64_t depth  = _history->last() - _history->first();
+    const int64_t offset = static_cast<int64_t>(_rewind) + generations;
+
+    if(_rewind == 0) {
+        _world.save(_live);
+    }
+    _rewind = (offset < 0 ? 0 : (offset > depth ? depth : offset));
+    if(_rewind != 0) {
+        _history->restore((_history->last() - _rewind), _world);
+    }
+    else {
+        _world.load(_live);
+    }
+    display();
+}
+
+void GameOfLifeCmd::resume()
+{
+    _world.load(_live);
+    _rewind = 0;
+}
+
+void GameOfLifeCmd::branch()
+{
+    /* the 8x8 torus restarts from the displayed generation */
+    _history->truncate(_history->last() - _rewind);
+    if(_cycle) {
+        _cycle->reset();
+    }
+    _rewind = 0;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::PlayCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+PlayCmd::PlayCmd ( Launchpad&     launchpad
+                 , const ArgList& arglist
+                 , const Console& console
+                 , const uint64_t delay )
+    : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
+    , _path()
+    , _start(0)
+    , _loop(false)
+    , _frame()
+{
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--start")) {
+            _start = lp::parse_uint(option, 0, UINT32_MAX);
+        }
+        else if(lp::is_option(option, "--loop")) {
+            _loop = true;
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
+    if(_arglist.count() != 1) {
+        throw std::runtime_error("invalid argument count");
+    }
+    else {
+        _path = _arglist.at(0);
+    }
+    _frame.fill(Palettes::TABLE(Colors::BLACK));
+}
+
+PlayCmd::~PlayCmd()
+{
+    lp::clear(_launchpad);
+}
+
+void PlayCmd::execute()
+{
+    using clock = std::chrono::steady_clock;
+
+    SequenceReader reader(_launchpad, _path);
+    Renderer       renderer(_launchpad);
+
+    auto duration = [&]() -> std::chrono::microseconds
+    {
+        const uint64_t milliseconds = reader.duration();
+        if(milliseconds != 0) {
+            return std::chrono::milliseconds(milliseconds);
+        }
+        return std::chrono::microseconds(_delay);
+    };
+
+    if(reader.frames() == 0) {
+        return;
+    }
+    if(_start >= reader.frames()) {
+        throw std::runtime_error("invalid start frame");
+    }
+    reader.seek(_start, _frame);
+
+    auto deadline = clock::now();
+    while(_stop == false) {
+        renderer.render(_frame);
+        deadline += duration();
+        std::this_thread::sleep_until(deadline);
+        if(reader.next(_frame) == false) {
+            if(_loop == false) {
+                break;
+            }
+            reader.seek(0, _frame);
+        }
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::ImageCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+ImageCmd::ImageCmd ( Launchpad&     launchpad
+                   , const ArgList& arglist
+                   , const Console& console
+                   , const uint64_t delay )
+    : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
+    , _files(_arglist.begin(), _arglist.end())
+    , _dither(Dither::kFLOYD_STEINBERG)
+    , _loop(false)
+    , _save()
+    , _frame()
+{
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--dither")) {
+            _dither = lp::parse_dither(option);
+        }
+        else if(lp::is_option(option, "--loop")) {
+            _loop = true;
+        }
+        else if(lp::is_option(option, "--save")) {
+            _save = lp::option_value(option);
+            if(_save.empty()) {
+                lp::invalid_option(option);
+            }
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
+    if(_files.empty()) {
+        throw std::runtime_error("invalid argument count");
+    }
+    if(_loop && (_save.empty() == false)) {
+        throw std::runtime_error("--loop cannot be used with --save");
+    }
+}
+
+ImageCmd::~ImageCmd()
+{
+    lp::clear(_launchpad);
+}
+
+void ImageCmd::execute()
+{
+    using clock = std::chrono::steady_clock;
+
+    if(_save.empty() == false) {
+        save();
+        return;
+    }
+    const size_t   count = _files.size();
+    ImageQuantizer quantizer(_launchpad);
+    ImageLoader    loader(quantizer, _dither);
+    Renderer       renderer(_launchpad);
+
+    loader.prefetch(_files[0]);
+
+    auto deadline = clock::now();
+    for(size_t index = 0; _stop == false;) {
+        loader.fetch(_frame);
+        if(++index >= count) {
+            index = 0;
+        }
+        if((index != 0) || (_loop != false)) {
+            loader.prefetch(_files[index]);
+        }
+        renderer.render(_frame);
+        deadline += std::chrono::microseconds(_delay);
+        std::this_thread::sleep_until(deadline);
+        if((index == 0) && (_loop == false)) {
+            break;
+        }
+    }
+}
+
+void ImageCmd::save()
+{
+    constexpr int  levels   = ImageQuantizer::LEVELS;
+    constexpr int  step     = 255 / (levels - 1);
+    const uint64_t millis   = _delay / 1000UL;
+    const uint16_t duration = static_cast<uint16_t>(millis < UINT16_MAX ? millis : UINT16_MAX);
+    ImageQuantizer quantizer(_launchpad);
+    SequenceWriter writer;
+    Frame          indices;
+    uint8_t        palette[256] = {};
+
+    /* the quantized device colors are mapped back to their red/green levels */
+    for(int red = 0; red < levels; ++red) {
+        for(int green = 0; green < levels; ++green) {
+            palette[_launchpad.makeColor(red * step, green * step)] = writer.color(red * step, green * step);
+        }
+    }
+    for(auto& file : _files) {
+        const Frame frame(ImageLoader::load(quantizer, _dither, file));
+        for(uint8_t row = 0; row < Frame::ROWS; ++row) {
+            for(uint8_t col = 0; col < Frame::COLS; ++col) {
+                indices.data[row][col] = palette[frame.data[row][col]];
+            }
+        }
+        writer.add(indices, duration);
+    }
+    writer.save(_save);
+    println(std::string("sequence saved") + ' ' + _save + ',' + ' ' + std::to_string(_files.size()) + ' ' + "frames");
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::FxCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+FxCmd::FxCmd ( Launchpad&     launchpad
+             , const ArgList& arglist
+             , const Console& console
+             , const uint64_t delay )
+    : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
+    , _fps(0)
+    , _subframes(0)
+    , _shader()
+    , _frame()
+{
+    bool coalesce = false;
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--subframes")) {
+            _subframes = lp::parse_subframes(option);
+        }
+        else if(lp::is_option(option, "--fps")) {
+            _fps = lp::parse_rate(option);
+        }
+        else if(lp::is_option(option, "--coalesce")) {
+            coalesce = true;
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
+    if(_arglist.count() != 1) {
+        throw std::runtime_error("invalid argument count");
+    }
+    _shader.reset(new Shader(_arglist.at(0), Random::seed()));
+    queueInput(coalesce);
+    _paced = true;
+}
+
+FxCmd::~FxCmd()
+{
+    lp::clear(_launchpad);
+}
+
+void FxCmd::execute()
+{
+    if(_stop == false) {
+        animate(_frame, _fps, _subframes);
+    }
+}
+
+void FxCmd::onLaunchpadGridKey(const uint8_t key, const uint8_t velocity)
+{
+    const uint8_t row = key / 16;
+    const uint8_t col = key % 16;
+
+    if((row < ROWS) && (col < COLS) && (velocity != 0)) {
+        _shader->focus(row, col);
+    }
+}
+
+void FxCmd::onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity)
+{
+    static_cast<void>(key);
+    static_cast<void>(velocity);
+}
+
+void FxCmd::onAnimate(DeepFrame& frame, const uint64_t time)
+{
+    _shader->render(frame, time);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::RunCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+RunCmd::RunCmd ( Launchpad&     launchpad
+               , const ArgList& arglist
+               , const Console& console
+               , const uint64_t delay )
+    : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
+    , _fps(0)
+    , _subframes(0)
+    , _script()
+    , _frame()
+{
+    bool coalesce = false;
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--subframes")) {
+            _subframes = lp::parse_subframes(option);
+        }
+        else if(lp::is_option(option, "--fps")) {
+            _fps = lp::parse_rate(option);
+        }
+        else if(lp::is_option(option, "--coalesce")) {
+            coalesce = true;
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
+    if(_arglist.count() != 1) {
+        throw std::runtime_error("invalid argument count");
+    }
+    const std::string& path(_arglist.at(0));
+    _script.reset(new Script(path, Script::read(path), Random::seed()));
+    queueInput(coalesce);
+    _paced = true;
+}
+
+RunCmd::~RunCmd()
+{
+    lp::clear(_launchpad);
+}
+
+void RunCmd::execute()
+{
+    if(_stop == false) {
+        animate(_frame, _fps, _subframes);
+    }
+}
+
+void RunCmd::onLaunchpadGridKey(const uint8_t key, const uint8_t velocity)
+{
+    const uint8_t row = key / 16;
+    const uint8_t col = key % 16;
+
+    if((row < ROWS) && (col < COLS)) {
+        _script->press(row, col, (velocity != 0));
+    }
+}
+
+void RunCmd::onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity)
+{
+    static_cast<void>(key);
+    static_cast<void>(velocity);
+}
+
+void RunCmd::onAnimate(DeepFrame& frame, const uint64_t time)
+{
+    _script->evaluate(frame, static_cast<double>(time) / 1000000.0);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::SpectrumCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+SpectrumCmd::SpectrumCmd ( Launchpad&     launchpad
+                         , const ArgList& arglist
+                         , const Console& console
+                         , const uint64_t delay )
+    : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
+    , _path("-")
+    , _format(PcmFormat::kS16)
+    , _rate(SpectrumStream::DEFAULT_RATE)
+    , _channels(2)
+    , _size(SpectrumAnalyzer::DEFAULT_SIZE)
+    , _fps(0)
+{
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--format")) {
+            const std::string format(lp::option_value(option));
+            if(format == "s16") {
+                _format = PcmFormat::kS16;
+            }
+            else if(format == "f32") {
+                _format = PcmFormat::kF32;
+            }
+            else {
+                lp::invalid_option(option);
+            }
+        }
+        else if(lp::is_option(option, "--rate")) {
+            _rate = lp::parse_uint(option, SpectrumStream::MINIMUM_RATE, SpectrumStream::MAXIMUM_RATE);
+        }
+        else if(lp::is_option(option, "--channels")) {
+            _channels = lp::parse_uint(option, 1, SpectrumStream::MAXIMUM_CHANNELS);
+        }
+        else if(lp::is_option(option, "--fft")) {
+            _size = lp::parse_uint(option, SpectrumAnalyzer::MINIMUM_SIZE, SpectrumAnalyzer::MAXIMUM_SIZE);
+            if((_size & (_size - 1)) != 0) {
+                throw std::runtime_error(std::string("invalid option") + ' ' + '<' + option + '>' + ':' + ' ' + "value must be a power of two");
+            }
+        }
+        else if(lp::is_option(option, "--fps")) {
+            _fps = lp::parse_rate(option);
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
+    if(_arglist.count() > 1) {
+        throw std::runtime_error("invalid argument count");
+    }
+    if(_arglist.count() == 1) {
+        _path = _arglist.at(0);
+    }
+}
+
+SpectrumCmd::~SpectrumCmd()
+{
+    lp::clear(_launchpad);
+}
+
+void SpectrumCmd::execute()
+{
+    using clock = std::chrono::steady_clock;
+
+    if(_stop == false) {
+        const uint64_t frame = lp::rate_period(_fps, _delay);
+        Pacer          pacer(frame, frame);
+        Renderer       renderer(_launchpad);
+        SpectrumStream stream(_path, _format, _rate, _channels, _size);
+        SpectrumBars   bars;
+        Frame          current;
+        Frame          previous;
+        uint64_t       fetched = 0;
+        uint64_t       pushed  = 0;
+        uint64_t       total   = 0;
+        uint64_t       worst   = 0;
+
+        /* only the latest analysis is displayed, and only when the pads change */
+        do {
+            if(pacer.wait() == 0) {
+                continue;
+            }
+            if(stream.fetch(bars) == false) {
+                if(stream.finished()) {
+                    break;
+                }
+                continue;
+            }
+            draw(bars, current);
+            if((pushed == 0) || (::memcmp(current.data, previous.data, sizeof(current.data)) != 0)) {
+                renderer.render(current);
+                previous = current;
+                ++pushed;
+            }
+            const uint64_t now     = std::chrono::duration_cast<std::chrono::microseconds>(clock::now().time_since_epoch()).count();
+            const uint64_t latency = (now > bars.time ? now - bars.time : 0);
+            total += latency;
+            worst  = (latency > worst ? latency : worst);
+            ++fetched;
+        } while(_stop == false);
+
+        char buffer[256];
+        const int rc = ::snprintf(buffer, sizeof(buffer), "%llu analyses, %llu displayed, %llu frames pushed, latency %llu us average, %llu us max", static_cast<unsigned long long>(bars.sequence), static_cast<unsigned long long>(fetched), static_cast<unsigned long long>(pushed), static_cast<unsigned long long>(fetched != 0 ? total / fetched : 0), static_cast<unsigned long long>(worst));
+        if((rc < 0) || (rc >= static_cast<int>(sizeof(buffer)))) {
+            throw std::runtime_error("snprintf() has failed");
+        }
+        println(buffer);
+    }
+}
+
+void SpectrumCmd::onLaunchpadGridKey(const uint8_t key, const uint8_t velocity)
+{
+    static_cast<void>(key);
+    static_cast<void>(velocity);
+}
+
+void SpectrumCmd::onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity)
+{
+    static_cast<void>(key);
+    static_cast<void>(velocity);
+}
+
+void SpectrumCmd::draw(const SpectrumBars& bars, Frame& frame)
+{
+    /* green at the bottom, amber in the middle, red at the top */
+    static const uint8_t red[ROWS]   = {   0,   0,   0,   0, 255, 255, 255, 255 };
+    static const uint8_t green[ROWS] = { 255, 255, 255, 255, 255, 255,   0,   0 };
+
+    for(uint8_t col = 0; col < COLS; ++col) {
+        const float height = bars.level[col] * ROWS;
+        const float top    = bars.peak[col] * ROWS;
+        for(uint8_t level = 0; level < ROWS; ++level) {
+            const float fill = height - level;
+            const float lit  = (fill < 0.0f ? 0.0f : (fill > 1.0f ? 1.0f : fill));
+            uint8_t     r    = static_cast<uint8_t>(red[level] * lit);
+            uint8_t     g    = static_cast<uint8_t>(green[level] * lit);
+            if((top > (level + 0.5f)) && (top <= (level + 1.5f)) && (lit < 1.0f)) {
+                r = 255;
+                g = 0;
+            }
+            frame.data[ROWS - 1 - level][col] = Palettes::TABLE(Color(r, g));
+        }
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::SequencerCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+SequencerCmd::SequencerCmd ( Launchpad&     launchpad
+                           , const ArgList& arglist
+                           , const Console& console
+                           , const uint64_t delay )
+    : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
+    , _fps(0)
+    , _sequencer()
+{
+    unsigned    tempo   = StepSequencer::DEFAULT_TEMPO;
+    unsigned    gate    = StepSequencer::DEFAULT_GATE;
+    uint8_t     channel = StepSequencer::CHANNEL;
+    std::string output;
+
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--bpm")) {
+            tempo = lp::parse_uint(option, StepSequencer::MINIMUM_TEMPO, StepSequencer::MAXIMUM_TEMPO);
+        }
+        else if(lp::is_option(option, "--gate")) {
+            gate = lp::parse_uint(option, 1, 100);
+        }
+        else if(lp::is_option(option, "--channel")) {
+            channel = lp::parse_uint(option, 1, 16) - 1;
+        }
+        else if(lp::is_option(option, "--output")) {
+            output = lp::option_value(option);
+            if(output.empty()) {
+                lp::invalid_option(option);
+            }
+        }
+        else if(lp::is_option(option, "--fps")) {
+            _fps = lp::parse_rate(option);
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
+    if(_arglist.count() != 0) {
+        throw std::runtime_error("invalid argument count");
+    }
+    _sequencer.reset(new StepSequencer(_launchpad.name(), output, tempo, gate, channel));
+}
+
+SequencerCmd::~SequencerCmd()
+{
+    _sequencer->stop();
+    lp::clear(_launchpad);
+    for(uint8_t row = 0; row < ROWS; ++row) {
+        _launchpad.clearPad(row, COLS);
+    }
+}
+
+void SequencerCmd::execute()
+{
+    if(_stop == false) {
+        const uint64_t frame  = lp::rate_period(_fps, _delay);
+        const uint8_t  off    = _launchpad.makeColor(0x00, 0x00);
+        const uint8_t  step   = _launchpad.makeColor(0x00, 0xff);
+        const uint8_t  played = _launchpad.makeColor(0xff, 0xff);
+        const uint8_t  head   = _launchpad.makeColor(0xff, 0x00);
+        Pacer          pacer(frame, frame);
+        uint8_t        shown[ROWS][COLS + 1];
+        bool           first = true;
+
+        /* the display only polls the sequencer, and sends the pads that changed */
+        auto display = [&]() -> void
+        {
+            const uint64_t pattern  = _sequencer->pattern();
+            const int      playhead = _sequencer->playhead();
+            for(uint8_t row = 0; row < ROWS; ++row) {
+                for(uint8_t col = 0; col <= COLS; ++col) {
+                    uint8_t color = off;
+                    if(col == COLS) {
+                        color = (row == playhead ? head : off);
+                    }
+                    else if(((pattern >> ((row * COLS) + col)) & 1) != 0) {
+                        color = (row == playhead ? played : step);
+                    }
+                    if(first || (shown[row][col] != color)) {
+                        _launchpad.setPad(row, col, color);
+                        shown[row][col] = color;
+                    }
+                }
+            }
+            first = false;
+        };
+
+        _sequencer->start();
+        display();
+        do {
+            if(pacer.wait() != 0) {
+                display();
+            }
+        } while(_stop == false);
+        _sequencer->stop();
+
+        const JitterMeter& jitter(_sequencer->jitter());
+        char buffer[256];
+        const int rc = ::snprintf(buffer, sizeof(buffer), "%llu notes sent, lateness %llu us average, %llu us p99, %llu us max", static_cast<unsigned long long>(jitter.count()), static_cast<unsigned long long>(jitter.average()), static_cast<unsigned long long>(jitter.percentile(99)), static_cast<unsigned long long>(jitter.maximum()));
+        if((rc < 0) || (rc >= static_cast<int>(sizeof(buffer)))) {
+            throw std::runtime_error("snprintf() has failed");
+        }
+        println(buffer);
+        if(_fps != 0) {
+            println(lp::pacing(pacer));
+        }
+    }
+}
+
+void SequencerCmd::onLaunchpadGridKey(const uint8_t key, const uint8_t velocity)
+{
+    const uint8_t row = key / 16;
+    const uint8_t col = key % 16;
+
+    if((row < ROWS) && (col < COLS) && (velocity != 0)) {
+        _sequencer->toggle(row, col);
+    }
+}
+
+void SequencerCmd::onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity)
+{
+    static_cast<void>(key);
+    static_cast<void>(velocity);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::MonitorCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+MonitorCmd::MonitorCmd ( Launchpad&     launchpad
+                       , const ArgList& arglist
+                       , const Console& console
+                       , const uint64_t delay )
+    : Command(launchpad, arglist, console, lp::check_delay(delay, DEFAULT_DELAY))
+    , _binary(false)
+    , _interval(MonitorWriter::DEFAULT_INTERVAL)
+    , _queue()
+{
+    for(auto& option : _options) {
+        if(lp::is_option(option, "--flush")) {
+            _interval = lp::parse_uint(option, 1, 10000) * 1000UL;
+        }
+        else if(lp::is_option(option, "--binary")) {
+            _binary = true;
+        }
+        else {
+            lp::invalid_option(option);
+        }
+    }
+    if(_arglist.count() != 0) {
+        throw std::runtime_error("invalid argument count");
+    }
+}
+
+MonitorCmd::~MonitorCmd()
+{
+}
+
+void MonitorCmd::execute()
+{
+    if(_stop == false) {
+        MonitorWriter writer(_console.printStream, _binary, _interval);
+        MonitorEvent  event;
+        uint64_t      backlog = 0;
+
+        /* the input thread only queues, the formatting and the writes are done here */
+        auto drain = [&]() -> void
+        {
+            uint64_t count = 0;
+            while(_queue.pop(event)) {
+                writer.write(event);
+                ++count;
+            }
+            if(count > backlog) {
+                backlog = count;
+            }
+        };
+
+        do {
+            sleep(_delay);
+            drain();
+            static_cast<void>(writer.flush(InputQueue::now()));
+        } while(_stop == false);
+        drain();
+        writer.flush();
+
+        char buffer[256];
+        const int rc = ::snprintf(buffer, sizeof(buffer), "%llu messages, %llu overflows, %llu max backlog, %llu bytes written in %llu flushes", static_cast<unsigned long long>(writer.events()), static_cast<unsigned long long>(_queue.overflows()), static_cast<unsigned long long>(backlog), static_cast<unsigned long long>(writer.bytes()), static_cast<unsigned long long>(writer.flushes()));
+        if((rc < 0) || (rc >= static_cast<int>(sizeof(buffer)))) {
+            throw std::runtime_error("snprintf() has failed");
+        }
+        if(_binary) {
+            errorln(buffer);
+        }
+        else {
+            println(buffer);
+        }
+    }
+}
+
+void MonitorCmd::onLaunchpadInput(const std::string& message)
+{
+    static_cast<void>(_queue.push(reinterpret_cast<const uint8_t*>(message.data()), message.size(), InputQueue::now()));
 }
 
 }
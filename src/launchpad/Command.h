@@ -19,9 +19,34 @@
 
 #include <base/ArgList.h>
 #include <base/Console.h>
+#include <base/Pacer.h>
+#include <base/Random.h>
 #include <novation/Launchpad.h>
+#include <novation/Frame.h>
+#include <novation/Timeline.h>
+#include <novation/Sequence.h>
+#include <novation/Image.h>
+#include <novation/Temporal.h>
+#include <novation/Particles.h>
+#include <novation/Shader.h>
+#include <novation/Script.h>
+#include <novation/Spectrum.h>
+#include <novation/StepSequencer.h>
+#include <novation/MidiClock.h>
+#include <novation/Gesture.h>
+#include <novation/Input.h>
+#include <novation/Journal.h>
+#include <novation/Monitor.h>
 #include <novation/Font5x7.h>
 #include <novation/Font8x8.h>
+#include <life/Rule.h>
+#include <life/Bitboard.h>
+#include <life/Cycle.h>
+#include <life/HashLife.h>
+#include <life/Pattern.h>
+#include <life/TiledWorld.h>
+#include <life/Search.h>
+#include <life/History.h>
 
 // ---------------------------------------------------------------------------
 // some aliases
@@ -33,8 +58,68 @@ using Launchpad          = novation::Launchpad;
 using LaunchpadDecorator = novation::LaunchpadDecorator;
 using LaunchpadListener  = novation::LaunchpadListener;
 using LaunchpadUniquePtr = std::unique_ptr<Launchpad>;
+using Color              = novation::Color;
+using Colors             = novation::Colors;
+using Palettes           = novation::Palettes<novation::MiniEncoding>;
+using Frame              = novation::Frame;
+using Renderer           = novation::Renderer;
+using EchoRenderer       = novation::EchoRenderer;
+using Gesture            = novation::Gesture;
+using GestureType        = novation::GestureType;
+using GestureListener    = novation::GestureListener;
+using GestureRecognizer  = novation::GestureRecognizer;
+using InputType          = novation::InputType;
+using InputEvent         = novation::InputEvent;
+using InputQueue         = novation::InputQueue;
+using JournalReader      = novation::JournalReader;
+using JournalWriter      = novation::JournalWriter;
+using MonitorEvent       = novation::MonitorEvent;
+using MonitorQueue       = novation::MonitorQueue;
+using MonitorWriter      = novation::MonitorWriter;
+using Tween              = novation::Tween;
+using Timeline           = novation::Timeline;
+using TimelinePlayer     = novation::TimelinePlayer;
+using ColorTrack         = novation::ColorTrack;
+using GlyphTrack         = novation::GlyphTrack;
+using ScrollTrack        = novation::ScrollTrack;
+using SequenceReader     = novation::SequenceReader;
+using SequenceWriter     = novation::SequenceWriter;
+using Dither             = novation::Dither;
+using ImageQuantizer     = novation::ImageQuantizer;
+using ImageLoader        = novation::ImageLoader;
+using DeepFrame          = novation::DeepFrame;
+using TemporalRenderer   = novation::TemporalRenderer;
+using ParticleKind       = novation::ParticleKind;
+using ParticlePhysics    = novation::ParticlePhysics;
+using ParticleSystem     = novation::ParticleSystem;
+using Shader             = novation::Shader;
+using Script             = novation::Script;
+using PcmFormat          = novation::PcmFormat;
+using SpectrumBars       = novation::SpectrumBars;
+using SpectrumAnalyzer   = novation::SpectrumAnalyzer;
+using SpectrumStream     = novation::SpectrumStream;
+using StepSequencer      = novation::StepSequencer;
+using JitterMeter        = novation::JitterMeter;
 using Font5x7            = novation::Font5x7;
 using Font8x8            = novation::Font8x8;
+using LifeRule           = life::Rule;
+using LifeBoard          = life::Board;
+using HashLife           = life::HashLife;
+using TiledWorld         = life::TiledWorld;
+using CyclePolicy        = life::CyclePolicy;
+using CycleDetector      = life::CycleDetector;
+using LifePattern        = life::Pattern;
+using PatternFile        = life::PatternFile;
+using ThreadPool         = base::ThreadPool;
+using Pacer              = base::Pacer;
+using PacerClock         = base::PacerClock;
+using ScaledClock        = base::ScaledClock;
+using Random             = base::Random;
+using MidiClock          = novation::MidiClock;
+using MidiClockStatus    = novation::MidiClockStatus;
+using Soup               = life::Soup;
+using SoupSearch         = life::SoupSearch;
+using LifeHistory        = life::History;
 
 // ---------------------------------------------------------------------------
 // CommandType
@@ -51,6 +136,13 @@ enum class CommandType
     kSCROLL     = 6,
     kMATRIX     = 7,
     kGAMEOFLIFE = 8,
+    kPLAY       = 9,
+    kIMAGE      = 10,
+    kFX         = 11,
+    kRUN        = 12,
+    kSPECTRUM   = 13,
+    kSEQUENCER  = 14,
+    kMONITOR    = 15,
 };
 
 // ---------------------------------------------------------------------------
@@ -79,6 +171,7 @@ protected: // protected interface
 
 protected: // protected data
     const ArgList  _arglist;
+    const ArgList  _options;
     const Console& _console;
 };
 
@@ -104,15 +197,56 @@ public: // public interface
         _stop = true;
     }
 
+    void setClock(PacerClock& clock);
+
+    bool paced() const
+    {
+        return _paced;
+    }
+
+    PacerClock& clock() const
+    {
+        return *_clock;
+    }
+
+    void setJournal(JournalWriter& journal);
+
+    void setJournal(JournalReader& journal);
+
     void sleep(const uint64_t delay);
 
+    virtual void onLaunchpadInput(const std::string& message) override;
+
+protected: // protected interface
+    void queueInput(const bool coalesce);
+
+    void postInput(const InputEvent& event);
+
+    unsigned drainInput(const unsigned steps);
+
+    bool hasEvents() const
+    {
+        return _events.empty() == false;
+    }
+
+    void animate(DeepFrame& frame, const uint64_t fps, const unsigned subframes);
+
+    virtual void onInputQueued(const InputEvent& event);
+
+    virtual void onInputEvent(const InputEvent& event);
+
+    virtual void onAnimate(DeepFrame& frame, const uint64_t time);
+
 protected: // protected data
-    const uint64_t _delay;
-    const uint8_t  _black;
-    const uint8_t  _red;
-    const uint8_t  _green;
-    const uint8_t  _amber;
-    bool           _stop;
+    const uint64_t              _delay;
+    bool                        _stop;
+    bool                        _paced;
+    PacerClock*                 _clock;
+    std::unique_ptr<InputQueue> _input;
+    std::vector<InputEvent>     _events;
+    bool                        _coalesce;
+    JournalWriter*              _recorder;
+    JournalReader*              _player;
 };
 
 // ---------------------------------------------------------------------------
@@ -121,6 +255,30 @@ protected: // protected data
 
 using CommandUniquePtr = std::unique_ptr<Command>;
 
+// ---------------------------------------------------------------------------
+// MidiClockUniquePtr
+// ---------------------------------------------------------------------------
+
+using MidiClockUniquePtr = std::unique_ptr<MidiClock>;
+
+// ---------------------------------------------------------------------------
+// ScaledClockUniquePtr
+// ---------------------------------------------------------------------------
+
+using ScaledClockUniquePtr = std::unique_ptr<ScaledClock>;
+
+// ---------------------------------------------------------------------------
+// JournalReaderUniquePtr
+// ---------------------------------------------------------------------------
+
+using JournalReaderUniquePtr = std::unique_ptr<JournalReader>;
+
+// ---------------------------------------------------------------------------
+// JournalWriterUniquePtr
+// ---------------------------------------------------------------------------
+
+using JournalWriterUniquePtr = std::unique_ptr<JournalWriter>;
+
 // ---------------------------------------------------------------------------
 // launchpad::HelpCmd
 // ---------------------------------------------------------------------------
@@ -157,6 +315,13 @@ private: // private interface
     void scrollUsage(std::ostream&);
     void matrixUsage(std::ostream&);
     void gameoflifeUsage(std::ostream&);
+    void playUsage(std::ostream&);
+    void imageUsage(std::ostream&);
+    void fxUsage(std::ostream&);
+    void runUsage(std::ostream&);
+    void spectrumUsage(std::ostream&);
+    void sequencerUsage(std::ostream&);
+    void monitorUsage(std::ostream&);
 
 private: // private data
     const std::string _program;
@@ -241,6 +406,10 @@ public: // public interface
 
 private: // private static data
     static constexpr uint64_t DEFAULT_DELAY = 500UL * 1000UL;
+
+private: // private data
+    size_t   _lookahead;
+    unsigned _subframes;
 };
 
 }
@@ -269,6 +438,7 @@ private: // private static data
 
 private: // private data
     std::string _text;
+    size_t      _lookahead;
 };
 
 }
@@ -297,6 +467,7 @@ private: // private static data
 
 private: // private data
     std::string _text;
+    size_t      _lookahead;
 };
 
 }
@@ -324,56 +495,39 @@ public: // public interface
 
     virtual void onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity) override;
 
+protected: // protected interface
+    virtual void onInputQueued(const InputEvent& event) override;
+
 private: // private static data
-    static constexpr uint64_t DEFAULT_DELAY = 150UL * 1000UL;
-    static constexpr uint8_t  ROWS          = 8;
-    static constexpr uint8_t  COLS          = 8;
+    static constexpr uint64_t DEFAULT_DELAY    = 40UL * 1000UL;
+    static constexpr uint64_t DEFAULT_SIM_RATE = 100;
+    static constexpr uint8_t  ROWS             = 8;
+    static constexpr uint8_t  COLS             = 8;
 
 private: // private interface
-    enum class Cell : uint8_t
+    enum class Effect : uint8_t
     {
-        kLEVEL0 = 0,
-        kLEVEL1 = 1,
-        kLEVEL2 = 2,
-        kLEVEL3 = 3,
-        kLEVEL4 = 4,
-        kLEVEL5 = 5,
+        kMATRIX    = 0,
+        kSPARKS    = 1,
+        kFIREWORKS = 2,
     };
 
-    struct Matrix
-    {
-        Cell data[ROWS][COLS];
-        Cell cell;
-
-        Cell& get(const uint8_t row, const uint8_t col)
-        {
-            if((row < ROWS) && (col < COLS)) {
-                return data[row][col];
-            }
-            return cell;
-        }
-
-        const Cell& get(const uint8_t row, const uint8_t col) const
-        {
-            if((row < ROWS) && (col < COLS)) {
-                return data[row][col];
-            }
-            return cell;
-        }
-    };
-
-    void init();
-    void loop();
-    void wait();
+    void init(const uint64_t step);
+    void loop(const unsigned steps);
+    void emit();
 
 private: // private data
-    const uint8_t _color0;
-    const uint8_t _color1;
-    const uint8_t _color2;
-    const uint8_t _color3;
-    const uint8_t _color4;
-    const uint8_t _color5;
-    Matrix        _matrix;
+    Effect                          _effect;
+    uint64_t                        _simRate;
+    uint64_t                        _fps;
+    unsigned                        _subframes;
+    std::unique_ptr<ParticleSystem> _particles;
+    ParticlePhysics                 _physics;
+    uint32_t                        _rate;
+    uint32_t                        _emission;
+    int32_t                         _speed;
+    DeepFrame                       _frame;
+    EchoRenderer                    _renderer;
 };
 
 }
@@ -386,6 +540,7 @@ namespace launchpad {
 
 class GameOfLifeCmd final
     : public Command
+    , public GestureListener
 {
 public: // public interface
     GameOfLifeCmd ( Launchpad&     launchpad
@@ -401,49 +556,331 @@ public: // public interface
 
     virtual void onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity) override;
 
+    virtual void onGesture(const Gesture& gesture) override;
+
+protected: // protected interface
+    virtual void onInputQueued(const InputEvent& event) override;
+
+    virtual void onInputEvent(const InputEvent& event) override;
+
+private: // private static data
+    static constexpr uint64_t DEFAULT_DELAY  = 750UL * 1000UL;
+    static constexpr uint8_t  ROWS           = 8;
+    static constexpr uint8_t  COLS           = 8;
+    static constexpr uint64_t PERTURBATION   = 8;
+    static constexpr uint64_t DEFAULT_SOUPS  = 1000000;
+    static constexpr unsigned DEFAULT_TOP    = 8;
+    static constexpr uint64_t SEARCH_ROUND   = 65536;
+    static constexpr uint64_t DEFAULT_REWIND = 1024;
+    static constexpr uint64_t MAXIMUM_REWIND = 1048576;
+    static constexpr int64_t  REWIND_SKIP    = 16;
+
+private: // private interface
+    using Cell = LifeBoard::Cell;
+
+    void init();
+    void loop(const unsigned steps);
+    void display();
+    void perform(const Gesture& gesture);
+    void pan(const int64_t dx, const int64_t dy);
+    void view(uint64_t* states) const;
+    void place(const int64_t x, const int64_t y, const unsigned state);
+    void sync();
+    void reseed();
+    void perturb();
+    void detect();
+    void search();
+    void replay();
+    void rewind(const int64_t generations);
+    void resume();
+    void branch();
+
+private: // private data
+    std::string                        _variant;
+    uint64_t                           _simRate;
+    uint64_t                           _fps;
+    LifeRule                           _rule;
+    LifeBoard                          _world;
+    unsigned                           _step;
+    size_t                             _memory;
+    unsigned                           _threads;
+    bool                               _zoom;
+    std::unique_ptr<HashLife>          _hashlife;
+    std::unique_ptr<ThreadPool>        _pool;
+    std::unique_ptr<TiledWorld>        _tiled;
+    std::unique_ptr<PatternFile>       _patterns;
+    const LifePattern*                 _pattern;
+    CyclePolicy                        _policy;
+    std::unique_ptr<CycleDetector>     _cycle;
+    uint64_t                           _soups;
+    std::unique_ptr<SoupSearch>        _search;
+    std::vector<Soup>                  _leaders;
+    size_t                             _leader;
+    uint32_t                           _generation;
+    std::unique_ptr<LifeHistory>       _history;
+    uint64_t                           _rewind;
+    uint64_t                           _live[LifeBoard::WORDS];
+    bool                               _frozen;
+    int64_t                            _viewX;
+    int64_t                            _viewY;
+    EchoRenderer                       _renderer;
+    Random                             _random;
+    std::unique_ptr<GestureRecognizer> _gestures;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::PlayCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+class PlayCmd final
+    : public Command
+{
+public: // public interface
+    PlayCmd ( Launchpad&     launchpad
+            , const ArgList& arglist
+            , const Console& console
+            , const uint64_t delay );
+
+    virtual ~PlayCmd();
+
+    virtual void execute() override;
+
+private: // private static data
+    static constexpr uint64_t DEFAULT_DELAY = 100UL * 1000UL;
+
+private: // private data
+    std::string _path;
+    uint32_t    _start;
+    bool        _loop;
+    Frame       _frame;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::ImageCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+class ImageCmd final
+    : public Command
+{
+public: // public interface
+    ImageCmd ( Launchpad&     launchpad
+             , const ArgList& arglist
+             , const Console& console
+             , const uint64_t delay );
+
+    virtual ~ImageCmd();
+
+    virtual void execute() override;
+
+private: // private interface
+    void save();
+
+private: // private static data
+    static constexpr uint64_t DEFAULT_DELAY = 1000UL * 1000UL;
+
+private: // private data
+    std::vector<std::string> _files;
+    Dither                   _dither;
+    bool                     _loop;
+    std::string              _save;
+    Frame                    _frame;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::FxCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+class FxCmd final
+    : public Command
+{
+public: // public interface
+    FxCmd ( Launchpad&     launchpad
+          , const ArgList& arglist
+          , const Console& console
+          , const uint64_t delay );
+
+    virtual ~FxCmd();
+
+    virtual void execute() override;
+
+    virtual void onLaunchpadGridKey(const uint8_t key, const uint8_t velocity) override;
+
+    virtual void onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity) override;
+
+protected: // protected interface
+    virtual void onAnimate(DeepFrame& frame, const uint64_t time) override;
+
+private: // private static data
+    static constexpr uint64_t DEFAULT_DELAY = 20UL * 1000UL;
+    static constexpr uint8_t  ROWS          = 8;
+    static constexpr uint8_t  COLS          = 8;
+
+private: // private data
+    uint64_t                _fps;
+    unsigned                _subframes;
+    std::unique_ptr<Shader> _shader;
+    DeepFrame               _frame;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::RunCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+class RunCmd final
+    : public Command
+{
+public: // public interface
+    RunCmd ( Launchpad&     launchpad
+           , const ArgList& arglist
+           , const Console& console
+           , const uint64_t delay );
+
+    virtual ~RunCmd();
+
+    virtual void execute() override;
+
+    virtual void onLaunchpadGridKey(const uint8_t key, const uint8_t velocity) override;
+
+    virtual void onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity) override;
+
+protected: // protected interface
+    virtual void onAnimate(DeepFrame& frame, const uint64_t time) override;
+
 private: // private static data
-    static constexpr uint64_t DEFAULT_DELAY = 750UL * 1000UL;
+    static constexpr uint64_t DEFAULT_DELAY = 20UL * 1000UL;
     static constexpr uint8_t  ROWS          = 8;
     static constexpr uint8_t  COLS          = 8;
 
+private: // private data
+    uint64_t                _fps;
+    unsigned                _subframes;
+    std::unique_ptr<Script> _script;
+    DeepFrame               _frame;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::SpectrumCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+class SpectrumCmd final
+    : public Command
+{
+public: // public interface
+    SpectrumCmd ( Launchpad&     launchpad
+                , const ArgList& arglist
+                , const Console& console
+                , const uint64_t delay );
+
+    virtual ~SpectrumCmd();
+
+    virtual void execute() override;
+
+    virtual void onLaunchpadGridKey(const uint8_t key, const uint8_t velocity) override;
+
+    virtual void onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity) override;
+
 private: // private interface
-    enum class Cell : uint8_t
-    {
-        kEMPTY = 0,
-        kASHES = 1,
-        kDEAD  = 2,
-        kDYING = 3,
-        kALIVE = 4,
-    };
+    void draw(const SpectrumBars& bars, Frame& frame);
 
-    struct State
-    {
-        Cell data[ROWS][COLS];
+private: // private static data
+    static constexpr uint64_t DEFAULT_DELAY = 20UL * 1000UL;
+    static constexpr uint8_t  ROWS          = 8;
+    static constexpr uint8_t  COLS          = 8;
+
+private: // private data
+    std::string _path;
+    PcmFormat   _format;
+    unsigned    _rate;
+    unsigned    _channels;
+    unsigned    _size;
+    uint64_t    _fps;
+};
 
-        Cell& get(const uint8_t row, const uint8_t col)
-        {
-            return data[row % ROWS][col % COLS];
-        }
+}
 
-        const Cell& get(const uint8_t row, const uint8_t col) const
-        {
-            return data[row % ROWS][col % COLS];
-        }
-    };
+// ---------------------------------------------------------------------------
+// launchpad::SequencerCmd
+// ---------------------------------------------------------------------------
 
-    void init();
-    void loop();
-    void wait();
+namespace launchpad {
+
+class SequencerCmd final
+    : public Command
+{
+public: // public interface
+    SequencerCmd ( Launchpad&     launchpad
+                 , const ArgList& arglist
+                 , const Console& console
+                 , const uint64_t delay );
+
+    virtual ~SequencerCmd();
+
+    virtual void execute() override;
+
+    virtual void onLaunchpadGridKey(const uint8_t key, const uint8_t velocity) override;
+
+    virtual void onLaunchpadLiveKey(const uint8_t key, const uint8_t velocity) override;
+
+private: // private static data
+    static constexpr uint64_t DEFAULT_DELAY = 10UL * 1000UL;
+    static constexpr uint8_t  ROWS          = 8;
+    static constexpr uint8_t  COLS          = 8;
+
+private: // private data
+    uint64_t                       _fps;
+    std::unique_ptr<StepSequencer> _sequencer;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// launchpad::MonitorCmd
+// ---------------------------------------------------------------------------
+
+namespace launchpad {
+
+class MonitorCmd final
+    : public Command
+{
+public: // public interface
+    MonitorCmd ( Launchpad&     launchpad
+               , const ArgList& arglist
+               , const Console& console
+               , const uint64_t delay );
+
+    virtual ~MonitorCmd();
+
+    virtual void execute() override;
+
+    virtual void onLaunchpadInput(const std::string& message) override;
+
+private: // private static data
+    static constexpr uint64_t DEFAULT_DELAY = 1UL * 1000UL;
 
 private: // private data
-    std::string   _variant;
-    const uint8_t _color0;
-    const uint8_t _color1;
-    const uint8_t _color2;
-    const uint8_t _color3;
-    const uint8_t _color4;
-    State         _world;
-    State         _cache;
+    bool         _binary;
+    uint64_t     _interval;
+    MonitorQueue _queue;
 };
 
 }